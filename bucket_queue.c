@@ -0,0 +1,332 @@
+#include <stdlib.h>
+#include "bucket_queue.h"
+
+// Forward declarations for helper functions
+static size_t bucket_of_queue_key(const Bucket_Queue *q, int64_t key);
+static size_t next_occupied_bucket(const Bucket_Queue *q, size_t start);
+static void link_bucket_node(Bucket_Queue *q, Bucket_Queue_Node *node);
+static void unlink_bucket_node(Bucket_Queue *q, Bucket_Queue_Node *node);
+
+// Function to create an empty bucket queue
+Bucket_Queue *create_bucket_queue(int64_t min_key, size_t range, bool circular) {
+    if (range == 0 || range > BUCKET_QUEUE_MAX_RANGE) {
+        return NULL;
+    }
+    if (!circular && (uint64_t)(range - 1) > (uint64_t)INT64_MAX - (uint64_t)min_key) {
+        return NULL; // min_key + range - 1 would overflow
+    }
+    Bucket_Queue *q = (Bucket_Queue *)malloc(sizeof(Bucket_Queue));
+    if (q == NULL) {
+        return NULL; // Memory allocation failed
+    }
+    q->buckets = (Bucket_Queue_Node **)calloc(range, sizeof(Bucket_Queue_Node *));
+    q->occupied = (uint64_t *)calloc((range + 63) / 64, sizeof(uint64_t));
+    if (q->buckets == NULL || q->occupied == NULL) {
+        free(q->buckets);
+        free(q->occupied);
+        free(q);
+        return NULL;
+    }
+    q->range = range;
+    q->min_key = min_key;
+    q->circular = circular;
+    q->last = min_key;
+    q->cursor = min_key;
+    q->n = 0;
+    q->free_payload = NULL;
+    init_heap_pool(&q->nodes, sizeof(Bucket_Queue_Node));
+    return q;
+}
+
+// Helper function to map an accepted key to its bucket
+static size_t bucket_of_queue_key(const Bucket_Queue *q, int64_t key) {
+    uint64_t offset = (uint64_t)key - (uint64_t)q->min_key;
+    return q->circular ? (size_t)(offset % q->range) : (size_t)offset;
+}
+
+// Helper function to find the first non-empty bucket at or after 'start', wrapping around
+// once; the queue must not be empty
+static size_t next_occupied_bucket(const Bucket_Queue *q, size_t start) {
+    size_t words = (q->range + 63) / 64;
+    size_t word = start / 64;
+    uint64_t bits = q->occupied[word] & (~(uint64_t)0 << (start % 64));
+    for (size_t i = 0; i <= words; i++) {
+        if (bits != 0) {
+#if defined(__GNUC__) || defined(__clang__)
+            return word * 64 + (size_t)__builtin_ctzll(bits);
+#else
+            size_t bit = 0;
+            while ((bits & 1) == 0) {
+                bits >>= 1;
+                bit++;
+            }
+            return word * 64 + bit;
+#endif
+        }
+        word = word + 1 == words ? 0 : word + 1;
+        bits = q->occupied[word]; // On the last round this is the start word's lower part
+    }
+    return SIZE_MAX;
+}
+
+// Helper function to push a node onto the front of its key's bucket
+static void link_bucket_node(Bucket_Queue *q, Bucket_Queue_Node *node) {
+    size_t bucket = bucket_of_queue_key(q, node->key);
+    node->prev = NULL;
+    node->next = q->buckets[bucket];
+    if (node->next != NULL) {
+        node->next->prev = node;
+    }
+    q->buckets[bucket] = node;
+    q->occupied[bucket / 64] |= (uint64_t)1 << (bucket % 64);
+    if (q->n == 0 || node->key < q->cursor) {
+        q->cursor = node->key;
+    }
+}
+
+// Helper function to take a node out of its bucket list
+static void unlink_bucket_node(Bucket_Queue *q, Bucket_Queue_Node *node) {
+    if (node->prev != NULL) {
+        node->prev->next = node->next;
+    } else {
+        size_t bucket = bucket_of_queue_key(q, node->key);
+        q->buckets[bucket] = node->next;
+        if (node->next == NULL) {
+            q->occupied[bucket / 64] &= ~((uint64_t)1 << (bucket % 64));
+        }
+    }
+    if (node->next != NULL) {
+        node->next->prev = node->prev;
+    }
+}
+
+bool accepts_key_bucket_queue(const Bucket_Queue *q, int64_t key) {
+    if (q == NULL) {
+        return false;
+    }
+    int64_t low = q->circular ? q->last : q->min_key;
+    return key >= low && (uint64_t)key - (uint64_t)low < q->range;
+}
+
+// Function to insert a key into the bucket queue
+Bucket_Queue_Node *insert_bucket_queue(Bucket_Queue *q, int64_t key, void *payload) {
+    if (!accepts_key_bucket_queue(q, key)) {
+        return NULL;
+    }
+    Bucket_Queue_Node *node = (Bucket_Queue_Node *)alloc_heap_pool(&q->nodes);
+    if (node == NULL) {
+        return NULL; // Memory allocation failed
+    }
+    node->key = key;
+    node->payload = payload;
+    link_bucket_node(q, node);
+    q->n++;
+    return node;
+}
+
+// Function to insert many keys at once
+bool insert_many_bucket_queue(Bucket_Queue *q, const int64_t *keys, size_t count) {
+    if (q == NULL || (keys == NULL && count > 0)) {
+        return false;
+    }
+    for (size_t i = 0; i < count; i++) {
+        if (!accepts_key_bucket_queue(q, keys[i])) {
+            return false;
+        }
+    }
+
+    // a. Allocate the whole batch before touching the buckets, so a failure changes nothing
+    Bucket_Queue_Node *batch = NULL;
+    for (size_t i = 0; i < count; i++) {
+        Bucket_Queue_Node *node = (Bucket_Queue_Node *)alloc_heap_pool(&q->nodes);
+        if (node == NULL) {
+            while (batch != NULL) {
+                Bucket_Queue_Node *next = batch->next;
+                free_heap_pool(&q->nodes, batch);
+                batch = next;
+            }
+            return false;
+        }
+        node->key = keys[i];
+        node->payload = NULL;
+        node->next = batch;
+        batch = node;
+    }
+
+    // b. File each node
+    while (batch != NULL) {
+        Bucket_Queue_Node *next = batch->next;
+        link_bucket_node(q, batch);
+        q->n++;
+        batch = next;
+    }
+    return true;
+}
+
+// Function to get the minimum without removing it
+bool get_min_bucket_queue(Bucket_Queue *q, int64_t *key_out, void **payload_out) {
+    if (q == NULL || q->n == 0) {
+        return false;
+    }
+    // Every key is at or above the cursor and inside one window, so the first non-empty
+    // bucket from the cursor's on holds the minimum
+    size_t start = bucket_of_queue_key(q, q->cursor);
+    size_t bucket = next_occupied_bucket(q, start);
+    Bucket_Queue_Node *node = q->buckets[bucket];
+    q->cursor = node->key;
+    if (key_out != NULL) {
+        *key_out = node->key;
+    }
+    if (payload_out != NULL) {
+        *payload_out = node->payload;
+    }
+    return true;
+}
+
+// Function to extract the minimum
+bool extract_min_bucket_queue(Bucket_Queue *q, int64_t *key_out, void **payload_out) {
+    if (!get_min_bucket_queue(q, NULL, NULL)) {
+        return false;
+    }
+    q->last = q->cursor;
+    return delete_node_bucket_queue(q, q->buckets[bucket_of_queue_key(q, q->cursor)], key_out, payload_out);
+}
+
+// Function to extract up to k minimum keys at once
+size_t extract_min_many_bucket_queue(Bucket_Queue *q, int64_t *keys_out, void **payloads_out, size_t k) {
+    if (q == NULL || keys_out == NULL) {
+        return 0;
+    }
+    size_t extracted = 0;
+    while (extracted < k && q->n > 0) {
+        void *payload;
+        extract_min_bucket_queue(q, &keys_out[extracted], &payload);
+        if (payloads_out != NULL) {
+            payloads_out[extracted] = payload;
+        } else if (q->free_payload != NULL && payload != NULL) {
+            q->free_payload(payload);
+        }
+        extracted++;
+    }
+    return extracted;
+}
+
+// Function to decrease the key of a node
+bool decrease_key_bucket_queue(Bucket_Queue *q, Bucket_Queue_Node *node, int64_t new_key) {
+    if (q == NULL || node == NULL || new_key > node->key) {
+        return false;
+    }
+    return change_key_bucket_queue(q, node, new_key);
+}
+
+// Function to change the key of a node in either direction
+bool change_key_bucket_queue(Bucket_Queue *q, Bucket_Queue_Node *node, int64_t new_key) {
+    if (node == NULL || !accepts_key_bucket_queue(q, new_key)) {
+        return false;
+    }
+    unlink_bucket_node(q, node);
+    node->key = new_key;
+    link_bucket_node(q, node); // Lowers the cursor if needed; raising it is left to get_min
+    return true;
+}
+
+// Function to delete a specific node
+bool delete_node_bucket_queue(Bucket_Queue *q, Bucket_Queue_Node *node, int64_t *key_out, void **payload_out) {
+    if (q == NULL || node == NULL) {
+        return false;
+    }
+    if (key_out != NULL) {
+        *key_out = node->key;
+    }
+    if (payload_out != NULL) {
+        *payload_out = node->payload;
+    }
+    unlink_bucket_node(q, node);
+    free_heap_pool(&q->nodes, node);
+    q->n--;
+    return true;
+}
+
+// Function to find a node by its key
+Bucket_Queue_Node *find_node_bucket_queue_key(const Bucket_Queue *q, int64_t key) {
+    if (!accepts_key_bucket_queue(q, key)) {
+        return NULL; // Outside the window, so it cannot be in the queue
+    }
+    Bucket_Queue_Node *node = q->buckets[bucket_of_queue_key(q, key)];
+    return node != NULL && node->key == key ? node : NULL;
+}
+
+bool can_meld_bucket_queue(const Bucket_Queue *dst, const Bucket_Queue *src) {
+    if (dst == NULL || src == NULL || dst == src || dst->range != src->range
+        || dst->min_key != src->min_key || dst->circular != src->circular) {
+        return false;
+    }
+    if (!dst->circular) {
+        return true; // Both windows are the same fixed range
+    }
+    for (size_t bucket = 0; bucket < src->range; bucket++) {
+        if (src->buckets[bucket] != NULL && !accepts_key_bucket_queue(dst, src->buckets[bucket]->key)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Function to meld two bucket queues
+bool meld_bucket_queue(Bucket_Queue *dst, Bucket_Queue *src) {
+    if (!can_meld_bucket_queue(dst, src)) {
+        return false;
+    }
+
+    // a. Both map keys to buckets the same way, so each non-empty list is spliced in whole
+    bool empty = dst->n == 0; // dst->n only grows after the loop
+    for (size_t bucket = 0; bucket < src->range; bucket++) {
+        Bucket_Queue_Node *head = src->buckets[bucket];
+        if (head == NULL) {
+            continue;
+        }
+        if (empty || head->key < dst->cursor) {
+            empty = false;
+            dst->cursor = head->key;
+        }
+        Bucket_Queue_Node *tail = head;
+        while (tail->next != NULL) {
+            tail = tail->next;
+        }
+        tail->next = dst->buckets[bucket];
+        if (tail->next != NULL) {
+            tail->next->prev = tail;
+        }
+        dst->buckets[bucket] = head;
+        dst->occupied[bucket / 64] |= (uint64_t)1 << (bucket % 64);
+        src->buckets[bucket] = NULL;
+    }
+    for (size_t word = 0; word < (src->range + 63) / 64; word++) {
+        src->occupied[word] = 0;
+    }
+    dst->n += src->n;
+    src->n = 0;
+
+    // b. The nodes' memory now belongs to dst
+    splice_heap_pool(&dst->nodes, &src->nodes);
+    return true;
+}
+
+void destroy_bucket_queue(Bucket_Queue *q) {
+    if (q == NULL) {
+        return;
+    }
+    if (q->free_payload != NULL && q->n > 0) {
+        for (size_t bucket = 0; bucket < q->range; bucket++) {
+            for (Bucket_Queue_Node *node = q->buckets[bucket]; node != NULL; node = node->next) {
+                if (node->payload != NULL) {
+                    q->free_payload(node->payload);
+                }
+            }
+        }
+    }
+    destroy_heap_pool(&q->nodes);
+    free(q->buckets);
+    free(q->occupied);
+    free(q);
+}
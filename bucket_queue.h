@@ -0,0 +1,93 @@
+#ifndef BUCKET_QUEUE_H
+#define BUCKET_QUEUE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "heap_pool.h"
+
+// Bucket queue for keys from a small range fixed at construction: one intrusive list per
+// key value, so insert, decrease_key and delete are O(1) and extract_min only has to find
+// the next non-empty bucket. A bitmap of non-empty buckets lets that search skip 64 empty
+// buckets per word instead of probing each list head.
+//
+// The window of accepted keys is [min_key, min_key + range) in fixed mode. In circular
+// mode (Dial's algorithm) it slides up with every extraction to [last, last + range),
+// where 'last' is the last extracted minimum: shortest paths with edge weights below
+// 'range' stay in it. Either way key k lives in bucket (k - min_key) mod range, and every
+// bucket holds a single key value.
+//
+// Nodes come from a pool and never move, so they serve as handles.
+
+#define BUCKET_QUEUE_MAX_RANGE ((size_t)1 << 26)
+
+typedef struct Bucket_Queue_Node {
+    int64_t key;
+    void *payload;                   // Optional opaque data attached by the caller
+    struct Bucket_Queue_Node *prev;  // Neighbours in the bucket list
+    struct Bucket_Queue_Node *next;
+} Bucket_Queue_Node;
+
+typedef struct Bucket_Queue {
+    Bucket_Queue_Node **buckets;
+    uint64_t *occupied;  // Bit i set while buckets[i] is not empty
+    size_t range;        // Number of buckets
+    int64_t min_key;
+    bool circular;
+    int64_t last;        // Last extracted minimum (starts at min_key); moves the circular window
+    int64_t cursor;      // No key in the queue is below it; where the search starts
+    size_t n;
+    Heap_Pool nodes;
+    // Called on payloads the queue drops on its own (extract_min_many_bucket_queue and
+    // destroy_bucket_queue). NULL by default: payloads are left alone.
+    void (*free_payload)(void *payload);
+} Bucket_Queue;
+
+// Creates an empty queue with 'range' buckets (1 .. BUCKET_QUEUE_MAX_RANGE) for keys from
+// min_key, in fixed or circular mode. Returns NULL on an invalid range or allocation failure.
+Bucket_Queue *create_bucket_queue(int64_t min_key, size_t range, bool circular);
+
+// Returns true if 'key' is inside the current window. Every operation that stores a key
+// (insert, insert_many, decrease_key, change_key) fails on other keys.
+bool accepts_key_bucket_queue(const Bucket_Queue *q, int64_t key);
+
+// Inserts 'key' with an optional 'payload'. Returns the new node, or NULL if the key is
+// not accepted or allocation failed.
+Bucket_Queue_Node *insert_bucket_queue(Bucket_Queue *q, int64_t key, void *payload);
+
+// Inserts 'count' keys (with NULL payloads). All or nothing: returns false if any key is
+// not accepted or allocation failed.
+bool insert_many_bucket_queue(Bucket_Queue *q, const int64_t *keys, size_t count);
+
+// Finding the minimum moves the cursor up to it, so repeated calls are O(1).
+bool get_min_bucket_queue(Bucket_Queue *q, int64_t *key_out, void **payload_out);
+
+bool extract_min_bucket_queue(Bucket_Queue *q, int64_t *key_out, void **payload_out);
+
+// Removes up to k minimum elements, writing their keys in ascending order to keys_out[0..].
+// Payloads go to payloads_out if it is not NULL and are otherwise passed to
+// q->free_payload (if set). Returns how many elements were removed.
+size_t extract_min_many_bucket_queue(Bucket_Queue *q, int64_t *keys_out, void **payloads_out, size_t k);
+
+// Returns false if new_key is greater than the node's key or not accepted.
+bool decrease_key_bucket_queue(Bucket_Queue *q, Bucket_Queue_Node *node, int64_t new_key);
+
+// Moves the node to new_key in either direction. Returns false if new_key is not accepted.
+bool change_key_bucket_queue(Bucket_Queue *q, Bucket_Queue_Node *node, int64_t new_key);
+
+bool delete_node_bucket_queue(Bucket_Queue *q, Bucket_Queue_Node *node, int64_t *key_out, void **payload_out);
+
+// Returns a node holding 'key', or NULL. O(1): only key's own bucket is looked at.
+Bucket_Queue_Node *find_node_bucket_queue_key(const Bucket_Queue *q, int64_t key);
+
+// Returns true if meld_bucket_queue(dst, src) would succeed: same min_key, range and mode,
+// dst != src, and every key of src inside dst's window.
+bool can_meld_bucket_queue(const Bucket_Queue *dst, const Bucket_Queue *src);
+
+// Moves every element of 'src' into 'dst' and leaves 'src' empty; nodes stay valid.
+// Returns false (changing nothing) if can_meld_bucket_queue does.
+bool meld_bucket_queue(Bucket_Queue *dst, Bucket_Queue *src);
+
+void destroy_bucket_queue(Bucket_Queue *q);
+
+#endif // BUCKET_QUEUE_H
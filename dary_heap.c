@@ -0,0 +1,334 @@
+#include <stdlib.h>
+#include <string.h>
+#include "dary_heap.h"
+
+#define DARY_HEAP_MIN_CAPACITY 64
+
+// Forward declarations for helper functions
+static bool reserve_dary_heap(Dary_Heap *h, size_t needed);
+static void sift_up_dary_heap(Dary_Heap *h, size_t i);
+static void sift_down_dary_heap(Dary_Heap *h, size_t i);
+static void heapify_dary_heap(Dary_Heap *h);
+static Dary_Heap_Slot *remove_entry_dary_heap(Dary_Heap *h, size_t i);
+
+// Function to create an empty d-ary heap
+Dary_Heap *create_dary_heap(unsigned arity) {
+    if (arity < DARY_HEAP_MIN_ARITY || arity > DARY_HEAP_MAX_ARITY) {
+        return NULL;
+    }
+    Dary_Heap *h = (Dary_Heap *)malloc(sizeof(Dary_Heap));
+    if (h == NULL) {
+        return NULL; // Memory allocation failed
+    }
+    h->entries = (Dary_Heap_Entry *)malloc(DARY_HEAP_MIN_CAPACITY * sizeof(Dary_Heap_Entry));
+    if (h->entries == NULL) {
+        free(h);
+        return NULL;
+    }
+    h->n = 0;
+    h->capacity = DARY_HEAP_MIN_CAPACITY;
+    h->arity = arity;
+    h->free_payload = NULL;
+    init_heap_pool(&h->slots, sizeof(Dary_Heap_Slot));
+    return h;
+}
+
+// Helper function to grow the entry array to at least 'needed' entries
+static bool reserve_dary_heap(Dary_Heap *h, size_t needed) {
+    if (needed <= h->capacity) {
+        return true;
+    }
+    size_t capacity = h->capacity * 2 > needed ? h->capacity * 2 : needed;
+    if (capacity > SIZE_MAX / sizeof(Dary_Heap_Entry)) {
+        return false; // Size overflow
+    }
+    Dary_Heap_Entry *entries = (Dary_Heap_Entry *)realloc(h->entries, capacity * sizeof(Dary_Heap_Entry));
+    if (entries == NULL) {
+        return false; // Memory allocation failed, the old array is untouched
+    }
+    h->entries = entries;
+    h->capacity = capacity;
+    return true;
+}
+
+// Helper function to move entry i up until its parent is not larger
+static void sift_up_dary_heap(Dary_Heap *h, size_t i) {
+    Dary_Heap_Entry *entries = h->entries;
+    Dary_Heap_Entry moving = entries[i];
+    while (i > 0) {
+        size_t parent = (i - 1) / h->arity;
+        if (!(moving.key < entries[parent].key)) {
+            break;
+        }
+        entries[i] = entries[parent];
+        entries[i].slot->pos = i;
+        i = parent;
+    }
+    entries[i] = moving;
+    moving.slot->pos = i;
+}
+
+// Helper function to move entry i down until no child is smaller
+static void sift_down_dary_heap(Dary_Heap *h, size_t i) {
+    Dary_Heap_Entry *entries = h->entries;
+    Dary_Heap_Entry moving = entries[i];
+    size_t n = h->n, d = h->arity;
+    for (;;) {
+        // a. Find the smallest of up to d children, which sit next to each other
+        size_t first = i * d + 1;
+        if (first >= n) {
+            break;
+        }
+        size_t end = n - first > d ? first + d : n;
+        size_t best = first;
+        for (size_t c = first + 1; c < end; c++) {
+            if (entries[c].key < entries[best].key) {
+                best = c;
+            }
+        }
+
+        // b. Stop once the moving entry is no larger than it
+        if (!(entries[best].key < moving.key)) {
+            break;
+        }
+        entries[i] = entries[best];
+        entries[i].slot->pos = i;
+        i = best;
+    }
+    entries[i] = moving;
+    moving.slot->pos = i;
+}
+
+// Helper function to restore the heap order of the whole array bottom-up in O(n)
+static void heapify_dary_heap(Dary_Heap *h) {
+    if (h->n < 2) {
+        return;
+    }
+    size_t i = (h->n - 2) / h->arity + 1; // One past the last entry with a child
+    while (i-- > 0) {
+        sift_down_dary_heap(h, i);
+    }
+}
+
+// Helper function to take entry i out of the array, returning its slot
+static Dary_Heap_Slot *remove_entry_dary_heap(Dary_Heap *h, size_t i) {
+    Dary_Heap_Slot *slot = h->entries[i].slot;
+    h->n--;
+    if (i != h->n) {
+        // Fill the hole with the last entry, which may need to move either way
+        int64_t removed_key = h->entries[i].key;
+        h->entries[i] = h->entries[h->n];
+        h->entries[i].slot->pos = i;
+        if (h->entries[i].key < removed_key) {
+            sift_up_dary_heap(h, i);
+        } else {
+            sift_down_dary_heap(h, i);
+        }
+    }
+    return slot;
+}
+
+// Function to insert a key into the d-ary heap
+Dary_Heap_Slot *insert_dary_heap(Dary_Heap *h, int64_t key, void *payload) {
+    if (h == NULL || !reserve_dary_heap(h, h->n + 1)) {
+        return NULL;
+    }
+    Dary_Heap_Slot *slot = (Dary_Heap_Slot *)alloc_heap_pool(&h->slots);
+    if (slot == NULL) {
+        return NULL; // Memory allocation failed
+    }
+    slot->payload = payload;
+    h->entries[h->n].key = key;
+    h->entries[h->n].slot = slot;
+    h->n++;
+    sift_up_dary_heap(h, h->n - 1);
+    return slot;
+}
+
+// Function to insert many keys at once
+bool insert_many_dary_heap(Dary_Heap *h, const int64_t *keys, size_t count) {
+    if (h == NULL || (keys == NULL && count > 0)) {
+        return false;
+    }
+    if (count > SIZE_MAX - h->n || !reserve_dary_heap(h, h->n + count)) {
+        return false;
+    }
+
+    // a. Append entries with fresh slots, undoing the batch if the pool runs dry
+    size_t old_n = h->n;
+    for (size_t i = 0; i < count; i++) {
+        Dary_Heap_Slot *slot = (Dary_Heap_Slot *)alloc_heap_pool(&h->slots);
+        if (slot == NULL) {
+            while (i-- > 0) {
+                free_heap_pool(&h->slots, h->entries[old_n + i].slot);
+            }
+            return false;
+        }
+        slot->payload = NULL;
+        slot->pos = old_n + i;
+        h->entries[old_n + i].key = keys[i];
+        h->entries[old_n + i].slot = slot;
+    }
+    h->n += count;
+
+    // b. Restore the heap order: sift small batches up one by one, rebuild for large ones
+    if (count >= old_n) {
+        heapify_dary_heap(h);
+    } else {
+        for (size_t i = old_n; i < h->n; i++) {
+            sift_up_dary_heap(h, i);
+        }
+    }
+    return true;
+}
+
+int64_t get_key_dary_heap_slot(const Dary_Heap *h, const Dary_Heap_Slot *slot) {
+    return h->entries[slot->pos].key;
+}
+
+// Function to get the minimum without removing it
+bool get_min_dary_heap(const Dary_Heap *h, int64_t *key_out, void **payload_out) {
+    if (h == NULL || h->n == 0) {
+        return false;
+    }
+    if (key_out != NULL) {
+        *key_out = h->entries[0].key;
+    }
+    if (payload_out != NULL) {
+        *payload_out = h->entries[0].slot->payload;
+    }
+    return true;
+}
+
+// Function to extract the minimum
+bool extract_min_dary_heap(Dary_Heap *h, int64_t *key_out, void **payload_out) {
+    if (h == NULL || h->n == 0) {
+        return false;
+    }
+    if (key_out != NULL) {
+        *key_out = h->entries[0].key;
+    }
+    Dary_Heap_Slot *slot = remove_entry_dary_heap(h, 0);
+    if (payload_out != NULL) {
+        *payload_out = slot->payload;
+    }
+    free_heap_pool(&h->slots, slot);
+    return true;
+}
+
+// Function to extract up to k minimum keys at once
+size_t extract_min_many_dary_heap(Dary_Heap *h, int64_t *keys_out, void **payloads_out, size_t k) {
+    if (h == NULL || keys_out == NULL) {
+        return 0;
+    }
+    size_t extracted = 0;
+    while (extracted < k && h->n > 0) {
+        keys_out[extracted] = h->entries[0].key;
+        Dary_Heap_Slot *slot = remove_entry_dary_heap(h, 0);
+        if (payloads_out != NULL) {
+            payloads_out[extracted] = slot->payload;
+        } else if (h->free_payload != NULL && slot->payload != NULL) {
+            h->free_payload(slot->payload);
+        }
+        free_heap_pool(&h->slots, slot);
+        extracted++;
+    }
+    return extracted;
+}
+
+// Function to decrease the key of an element
+bool decrease_key_dary_heap(Dary_Heap *h, Dary_Heap_Slot *slot, int64_t new_key) {
+    if (h == NULL || slot == NULL || new_key > h->entries[slot->pos].key) {
+        return false;
+    }
+    h->entries[slot->pos].key = new_key;
+    sift_up_dary_heap(h, slot->pos);
+    return true;
+}
+
+// Function to change the key of an element in either direction
+void change_key_dary_heap(Dary_Heap *h, Dary_Heap_Slot *slot, int64_t new_key) {
+    int64_t old_key = h->entries[slot->pos].key;
+    h->entries[slot->pos].key = new_key;
+    if (new_key < old_key) {
+        sift_up_dary_heap(h, slot->pos);
+    } else {
+        sift_down_dary_heap(h, slot->pos);
+    }
+}
+
+// Function to delete a specific element
+bool delete_node_dary_heap(Dary_Heap *h, Dary_Heap_Slot *slot, int64_t *key_out, void **payload_out) {
+    if (h == NULL || slot == NULL) {
+        return false;
+    }
+    if (key_out != NULL) {
+        *key_out = h->entries[slot->pos].key;
+    }
+    if (payload_out != NULL) {
+        *payload_out = slot->payload;
+    }
+    remove_entry_dary_heap(h, slot->pos);
+    free_heap_pool(&h->slots, slot);
+    return true;
+}
+
+// Function to find an element by its key
+Dary_Heap_Slot *find_slot_dary_heap_key(const Dary_Heap *h, int64_t key) {
+    if (h == NULL) {
+        return NULL;
+    }
+    // A plain linear scan: pruning by heap order would trade sequential reads for branches
+    for (size_t i = 0; i < h->n; i++) {
+        if (h->entries[i].key == key) {
+            return h->entries[i].slot;
+        }
+    }
+    return NULL;
+}
+
+// Function to meld two d-ary heaps
+bool meld_dary_heap(Dary_Heap *dst, Dary_Heap *src) {
+    if (dst == NULL || src == NULL || dst == src || src->slots.item_size != dst->slots.item_size) {
+        return false;
+    }
+    if (src->n > SIZE_MAX - dst->n || !reserve_dary_heap(dst, dst->n + src->n)) {
+        return false;
+    }
+
+    // a. Append src's entries, then restore the order as insert_many does
+    size_t old_n = dst->n;
+    memcpy(dst->entries + old_n, src->entries, src->n * sizeof(Dary_Heap_Entry));
+    dst->n += src->n;
+    for (size_t i = old_n; i < dst->n; i++) {
+        dst->entries[i].slot->pos = i;
+    }
+    if (src->n >= old_n) {
+        heapify_dary_heap(dst);
+    } else {
+        for (size_t i = old_n; i < dst->n; i++) {
+            sift_up_dary_heap(dst, i);
+        }
+    }
+
+    // b. The slots' memory now belongs to dst
+    splice_heap_pool(&dst->slots, &src->slots);
+    src->n = 0;
+    return true;
+}
+
+void destroy_dary_heap(Dary_Heap *h) {
+    if (h == NULL) {
+        return;
+    }
+    if (h->free_payload != NULL) {
+        for (size_t i = 0; i < h->n; i++) {
+            if (h->entries[i].slot->payload != NULL) {
+                h->free_payload(h->entries[i].slot->payload);
+            }
+        }
+    }
+    destroy_heap_pool(&h->slots);
+    free(h->entries);
+    free(h);
+}
@@ -0,0 +1,84 @@
+#ifndef DARY_HEAP_H
+#define DARY_HEAP_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "heap_pool.h"
+
+// Implicit d-ary min-heap stored in one contiguous array. It offers the operations of
+// fibonacci_heap.h with O(log_d n) insert, decrease_key and extract_min, but walks
+// memory linearly instead of chasing tree pointers, which usually wins when decrease_key
+// is rare. Children of entry i are entries d*i+1 .. d*i+d.
+//
+// Every element also gets a slot from a pool. Slots never move while their element is in
+// the heap and track where its entry currently is, so they serve as handles for
+// decrease_key and delete.
+
+typedef struct Dary_Heap_Slot {
+    size_t pos;    // Index of the element's entry in Dary_Heap.entries
+    void *payload; // Optional opaque data attached by the caller
+} Dary_Heap_Slot;
+
+typedef struct Dary_Heap_Entry {
+    int64_t key;         // Kept next to the slot pointer so sifting only touches the array
+    Dary_Heap_Slot *slot;
+} Dary_Heap_Entry;
+
+typedef struct Dary_Heap {
+    Dary_Heap_Entry *entries;
+    size_t n;
+    size_t capacity;
+    unsigned arity;
+    Heap_Pool slots;
+    // Called on payloads the heap drops on its own (extract_min_many_dary_heap and
+    // destroy_dary_heap). NULL by default: payloads are left alone.
+    void (*free_payload)(void *payload);
+} Dary_Heap;
+
+#define DARY_HEAP_MIN_ARITY 2
+#define DARY_HEAP_MAX_ARITY 64
+
+// Creates an empty heap in which every entry has up to 'arity' children.
+// Returns NULL if arity is out of range or allocation failed.
+Dary_Heap *create_dary_heap(unsigned arity);
+
+// Inserts 'key' with an optional 'payload'. Returns the element's slot, or NULL if
+// allocation failed.
+Dary_Heap_Slot *insert_dary_heap(Dary_Heap *h, int64_t key, void *payload);
+
+// Inserts 'count' keys (with NULL payloads). Large batches are appended and the array is
+// rebuilt bottom-up in O(n). All or nothing: returns false if allocation failed.
+bool insert_many_dary_heap(Dary_Heap *h, const int64_t *keys, size_t count);
+
+// Returns the key of the element behind 'slot'. Only meaningful while it is in the heap.
+int64_t get_key_dary_heap_slot(const Dary_Heap *h, const Dary_Heap_Slot *slot);
+
+bool get_min_dary_heap(const Dary_Heap *h, int64_t *key_out, void **payload_out);
+
+bool extract_min_dary_heap(Dary_Heap *h, int64_t *key_out, void **payload_out);
+
+// Removes up to k minimum elements, writing their keys in ascending order to keys_out[0..].
+// Payloads go to payloads_out if it is not NULL and are otherwise passed to
+// h->free_payload (if set). Returns how many elements were removed.
+size_t extract_min_many_dary_heap(Dary_Heap *h, int64_t *keys_out, void **payloads_out, size_t k);
+
+// Returns false if new_key is greater than the current key.
+bool decrease_key_dary_heap(Dary_Heap *h, Dary_Heap_Slot *slot, int64_t new_key);
+
+// Moves the element to new_key in either direction.
+void change_key_dary_heap(Dary_Heap *h, Dary_Heap_Slot *slot, int64_t new_key);
+
+bool delete_node_dary_heap(Dary_Heap *h, Dary_Heap_Slot *slot, int64_t *key_out, void **payload_out);
+
+// Returns the slot of an element holding 'key', or NULL. Scans the entry array.
+Dary_Heap_Slot *find_slot_dary_heap_key(const Dary_Heap *h, int64_t key);
+
+// Moves every element of 'src' into 'dst' and leaves 'src' empty. Slots move along, so
+// they stay valid; the entries are copied and the heap order restored, O(dst->n + src->n)
+// at worst. Returns false (changing nothing) on dst == src or allocation failure.
+bool meld_dary_heap(Dary_Heap *dst, Dary_Heap *src);
+
+void destroy_dary_heap(Dary_Heap *h);
+
+#endif // DARY_HEAP_H
@@ -1,393 +1,2892 @@
 #define PY_SSIZE_T_CLEAN
 #include <Python.h>
-#include <stdlib.h> // For malloc, free
 #include "fibonacci_heap.h" // Assumes this is in the same directory
+#include "dary_heap.h"
+#include "pairing_heap.h"
+#include "radix_heap.h"
+#include "bucket_queue.h"
+#include "multi_queue.h"
+#include "fibonacci_parallel.h"
+#include "fibonacci_graph.h"
+#include "heap_select.h"
 
-// --- Helper function to compare integers stored as void* ---
-// This will be used by the Fibonacci heap internally if it needs to compare keys.
-// We might need to pass this to create_fib_heap if it supports custom comparators.
-// For now, this is a placeholder; the C heap might do direct int casting and comparison.
-// int compare_int_keys(void* a, void* b) {
-//     int int_a = *(int*)a;
-//     int int_b = *(int*)b;
-//     if (int_a < int_b) return -1;
-//     if (int_a > int_b) return 1;
-//     return 0;
-// }
-
-// --- Definition of the Python object ---
+// Python ints are stored as int64 keys, which every engine orders natively; no comparator
+// from create_fib_heap_ex is needed.
+
+struct HeapObject;
+
+// --- Heap engines ---
+// Each Python heap class drives its C heap through one of these tables, so the methods
+// below are shared by all of them. An element is whatever the engine hands out per insert
+// (a Fibonacci_Node, a Dary_Heap_Slot, ...); handles hold on to it. Payloads the engine
+// drops on its own go through its free_payload hook, which is set to release_handle.
+// What a rejected key or meld is reported with; which fields are used depends on the status
+typedef struct Heap_Check {
+    int64_t key;   // The key rejected
+    int64_t low;   // Window, bound or last extracted minimum it was checked against
+    int64_t high;
+} Heap_Check;
+
+typedef struct Heap_Engine {
+    const char *name;  // Python class name, for repr and type errors
+    const char *label; // Used in error messages, e.g. "Fibonacci Heap"
+    void (*destroy)(void *heap);
+    size_t (*size)(const void *heap);
+    void *(*insert)(void *heap, int64_t key, void *payload);
+    bool (*insert_many)(void *heap, const int64_t *keys, size_t count);
+    bool (*get_min)(void *heap, int64_t *key_out);
+    bool (*extract_min)(void *heap, int64_t *key_out, void **payload_out);
+    size_t (*extract_min_many)(void *heap, int64_t *keys_out, void **payloads_out, size_t k);
+    bool (*decrease_key)(void *heap, void *element, int64_t new_key);
+    bool (*delete_element)(void *heap, void *element, void **payload_out);
+    bool (*delete_key)(void *heap, int64_t key, void **payload_out);
+    bool (*change_key)(void *heap, int64_t old_key, int64_t new_key);
+    bool (*contains)(void *heap, int64_t key);
+    int64_t (*get_key)(const void *heap, const void *element);
+    bool (*meld)(void *dst, void *src);
+    // Optional, for engines that restrict keys: return a nonzero status if 'key' may not be
+    // stored now, or if 'src' may not be melded into 'dst', filling in what the message
+    // needs. They run with the heap locked and raise nothing: raising allocates, which may
+    // run a finalizer that uses the heap, so raise_check is called once it is unlocked.
+    int (*check_key)(void *heap, int64_t key, Heap_Check *check_out);
+    int (*check_meld)(void *dst, void *src, Heap_Check *check_out);
+    void (*raise_check)(int status, const Heap_Check *check);
+    // Optional: true if lookups by value (delete_key, change_key, contains) are O(1) right
+    // now. NULL means they scan the heap.
+    bool (*fast_lookup)(const void *heap);
+} Heap_Engine;
+
+// --- Heap owner tokens ---
+// Handles do not point at their heap directly but at a refcounted owner token. Melding
+// forwards the source heap's token to the destination's, which moves every handle of the
+// source over in O(1); a handle follows the chain once and then points at the live token.
+typedef struct Heap_Owner {
+    Py_ssize_t refcount;
+    struct Heap_Owner *forward; // Token this one was melded into, or NULL
+    struct HeapObject *heap;    // Owning heap while forward == NULL; NULL once it is gone
+} Heap_Owner;
+
+// --- Definition of the Python object shared by every heap class ---
+// Every access to 'heap' happens with 'lock' held, so long operations can drop the GIL
+// (see GIL_RELEASE_THRESHOLD) while other threads keep using other heaps. 'handles' only
+// changes with the GIL held.
+typedef struct HeapObject {
+    PyObject_HEAD
+    const Heap_Engine *engine;
+    void *heap;
+    Heap_Owner *owner;
+    PyThread_type_lock lock;
+    Py_ssize_t handles; // Live handles of elements in this heap
+} HeapObject;
+
+// --- Definition of the handle object returned by insert ---
+// While the element is in the heap, its payload holds a strong reference to the handle,
+// and the handle points back at the element and at the owner token of its heap.
+// Both are cleared when the element leaves the heap or the heap goes away.
+typedef struct {
+    PyObject_HEAD
+    Heap_Owner *owner;
+    void *node;
+} HandleObject;
+
+// --- Module state ---
+// The types are heap types created once per module object, so every interpreter that
+// imports fibheap (including subinterpreters with a GIL of their own) has its own copies.
+#define HEAP_TYPE_COUNT 5
+
+typedef struct {
+    PyTypeObject *heap_types[HEAP_TYPE_COUNT];  // FibHeap, DaryHeap, PairingHeap, RadixHeap, BucketQueue
+    PyTypeObject *handle_type;
+    PyTypeObject *multi_queue_type;
+    PyTypeObject *top_k_type;
+} Module_State;
+
+static PyModuleDef fibheapmodule;
+
+// Returns the state of the fibheap module that defined `type` or one of its bases, or NULL
+// (without an exception) if `type` does not come from fibheap.
+static Module_State *
+find_module_state(PyTypeObject *type) {
+    PyObject *module = PyType_GetModuleByDef(type, &fibheapmodule); // Borrowed
+    if (module == NULL) {
+        PyErr_Clear();
+        return NULL;
+    }
+    return (Module_State *)PyModule_GetState(module);
+}
+
+// --- Owner token lock ---
+// Owner tokens and the owner/node fields of handles are shared between heaps: a meld links
+// the tokens of two heaps, and a handle can be read from any thread. With the GIL they are
+// only touched while it is held. A free-threaded build (Py_GIL_DISABLED) guards them with
+// one module-wide mutex instead. It is taken after a heap's lock, never before, and held
+// for a few pointer updates at a time; it is a no-op with the GIL.
+#ifdef Py_GIL_DISABLED
+static PyMutex owners_mutex;
+#define LOCK_OWNERS() PyMutex_Lock(&owners_mutex)
+#define UNLOCK_OWNERS() PyMutex_Unlock(&owners_mutex)
+#else
+#define LOCK_OWNERS() ((void)0)
+#define UNLOCK_OWNERS() ((void)0)
+#endif
+
+// --- Owner token helpers ---
+
+static Heap_Owner *
+new_heap_owner(HeapObject *heap) {
+    Heap_Owner *owner = (Heap_Owner *)PyMem_Malloc(sizeof(Heap_Owner));
+    if (owner == NULL) {
+        PyErr_NoMemory();
+        return NULL;
+    }
+    owner->refcount = 1;
+    owner->forward = NULL;
+    owner->heap = heap;
+    return owner;
+}
+
+static void
+decref_heap_owner(Heap_Owner *owner) {
+    while (owner != NULL && --owner->refcount == 0) {
+        Heap_Owner *forward = owner->forward;
+        PyMem_Free(owner);
+        owner = forward; // Drop the reference the freed token held on its successor
+    }
+}
+
+// Returns the live token at the end of owner's forwarding chain.
+static Heap_Owner *
+resolve_heap_owner(Heap_Owner *owner) {
+    while (owner->forward != NULL) {
+        owner = owner->forward;
+    }
+    return owner;
+}
+
+// --- Locking helpers ---
+
+// Operations on at least this many elements (or scans of a heap this large) run without the
+// GIL. Below it, handing the GIL over would cost more than the work itself.
+#define GIL_RELEASE_THRESHOLD 4096
+
+// Takes the heap's lock. If another thread holds it, that thread may be running without the
+// GIL and need it back to finish, so the wait happens with the GIL released.
+static void
+acquire_lock(PyThread_type_lock lock) {
+    if (!PyThread_acquire_lock(lock, NOWAIT_LOCK)) {
+        Py_BEGIN_ALLOW_THREADS
+        PyThread_acquire_lock(lock, WAIT_LOCK);
+        Py_END_ALLOW_THREADS
+    }
+}
+
+static void
+lock_heap(HeapObject *self) {
+    acquire_lock(self->lock);
+}
+
+static void
+unlock_heap(HeapObject *self) {
+    PyThread_release_lock(self->lock);
+}
+
+// Drops the GIL if `release` is true; pass the result to restore_gil. The code in between
+// must not touch Python objects, handles included.
+static PyThreadState *
+release_gil_if(bool release) {
+    return release ? PyEval_SaveThread() : NULL;
+}
+
+static void
+restore_gil(PyThreadState *state) {
+    if (state != NULL) {
+        PyEval_RestoreThread(state);
+    }
+}
+
+// Reads a `threads` argument: an int of at least 1, or None for one thread per CPU as
+// os.cpu_count() reports them. Returns 0 with an exception set on failure.
+static Py_ssize_t
+thread_count_arg(PyObject *arg) {
+    Py_ssize_t threads = 1;
+    if (arg == Py_None) {
+        PyObject *cpus = NULL;
+        PyObject *os_module = PyImport_ImportModule("os");
+        if (os_module != NULL) {
+            cpus = PyObject_CallMethod(os_module, "cpu_count", NULL);
+            Py_DECREF(os_module);
+        }
+        if (cpus == NULL) {
+            return 0;
+        }
+        if (cpus != Py_None) {
+            threads = PyLong_AsSsize_t(cpus);
+        }
+        Py_DECREF(cpus);
+    } else {
+        threads = PyLong_AsSsize_t(arg);
+    }
+    if (threads == -1 && PyErr_Occurred()) {
+        return 0;
+    }
+    if (threads < 1) {
+        PyErr_SetString(PyExc_ValueError, "threads must be at least 1.");
+        return 0;
+    }
+    return threads;
+}
+
+// --- Handle helpers ---
+
+// Used as every engine's free_payload and for every payload handed back by a heap:
+// detaches the handle and drops the heap's reference to it.
+static void
+release_handle(void *payload) {
+    HandleObject *handle = (HandleObject *)payload;
+    LOCK_OWNERS();
+    HeapObject *heap = resolve_heap_owner(handle->owner)->heap;
+    if (heap != NULL) {
+        heap->handles--;
+    }
+    decref_heap_owner(handle->owner);
+    handle->owner = NULL;
+    handle->node = NULL;
+    UNLOCK_OWNERS();
+    Py_DECREF(handle); // May free the handle, whose dealloc takes the owner lock itself
+}
+
+// Takes a new reference to a heap found through an owner token. In a free-threaded build
+// the heap may be dropping its last reference on another thread at that moment; from
+// CPython 3.14 on this is detected and the heap treated as gone.
+static bool
+incref_found_heap(HeapObject *heap) {
+#if defined(Py_GIL_DISABLED) && PY_VERSION_HEX >= 0x030E0000
+    return PyUnstable_TryIncRef((PyObject *)heap);
+#else
+    Py_INCREF(heap);
+    return true;
+#endif
+}
+
+// Points a live handle at the live token of its heap and returns that heap, or NULL once the
+// heap is being deallocated. Called with the owner lock held.
+static HeapObject *
+heap_of_handle(HandleObject *handle) {
+    Heap_Owner *owner = resolve_heap_owner(handle->owner);
+    if (owner != handle->owner) {
+        owner->refcount++;
+        decref_heap_owner(handle->owner);
+        handle->owner = owner;
+    }
+    return owner->heap;
+}
+
+// Returns the element behind `arg` if it is a live handle of `self`, otherwise NULL without
+// an exception: it is called with the heap locked (see raise_stale_handle).
+static void *
+node_from_handle(HeapObject *self, PyObject *arg) {
+    HandleObject *handle = (HandleObject *)arg;
+    LOCK_OWNERS();
+    void *node = handle->node != NULL && heap_of_handle(handle) == self ? handle->node : NULL;
+    UNLOCK_OWNERS();
+    return node;
+}
+
+// Sets the ValueError for a handle node_from_handle rejected, once the heap is unlocked
+static void
+raise_stale_handle(void) {
+    PyErr_SetString(PyExc_ValueError, "Handle is not in this heap (it was removed or belongs to another heap).");
+}
+
+// --- Engine adapters ---
+
+// Fibonacci_Heap (fibonacci_heap.h)
+
+static void
+fib_destroy(void *heap) {
+    destroy_fib_heap((Fibonacci_Heap *)heap);
+}
+
+static size_t
+fib_size(const void *heap) {
+    return (size_t)((const Fibonacci_Heap *)heap)->n;
+}
+
+static void *
+fib_insert(void *heap, int64_t key, void *payload) {
+    return insert_fib_heap_key((Fibonacci_Heap *)heap, key, payload);
+}
+
+static bool
+fib_insert_many(void *heap, const int64_t *keys, size_t count) {
+    return insert_many_fib_heap((Fibonacci_Heap *)heap, keys, count);
+}
+
+static bool
+fib_get_min(void *heap, int64_t *key_out) {
+    return get_min_fib_heap_key((Fibonacci_Heap *)heap, key_out, NULL);
+}
+
+static bool
+fib_extract_min(void *heap, int64_t *key_out, void **payload_out) {
+    return extract_min_fib_heap_key((Fibonacci_Heap *)heap, key_out, payload_out);
+}
+
+static size_t
+fib_extract_min_many(void *heap, int64_t *keys_out, void **payloads_out, size_t k) {
+    return extract_min_many_fib_heap((Fibonacci_Heap *)heap, keys_out, payloads_out, k);
+}
+
+static bool
+fib_decrease_key(void *heap, void *element, int64_t new_key) {
+    return decrease_key_fib_heap_key((Fibonacci_Heap *)heap, (Fibonacci_Node *)element, new_key);
+}
+
+static bool
+fib_delete_element(void *heap, void *element, void **payload_out) {
+    return delete_node_fib_heap_key((Fibonacci_Heap *)heap, (Fibonacci_Node *)element, NULL, payload_out);
+}
+
+static bool
+fib_delete_key(void *heap, int64_t key, void **payload_out) {
+    return delete_fib_node_key((Fibonacci_Heap *)heap, key, payload_out);
+}
+
+static bool
+fib_change_key(void *heap, int64_t old_key, int64_t new_key) {
+    return change_fib_node_key((Fibonacci_Heap *)heap, old_key, new_key);
+}
+
+static bool
+fib_contains(void *heap, int64_t key) {
+    return find_node_fib_heap_key((Fibonacci_Heap *)heap, key) != NULL;
+}
+
+static int64_t
+fib_get_key(const void *heap, const void *element) {
+    (void)heap;
+    return ((const Fibonacci_Node *)element)->key;
+}
+
+static bool
+fib_meld(void *dst, void *src) {
+    return meld_fib_heap((Fibonacci_Heap *)dst, (Fibonacci_Heap *)src);
+}
+
+static bool
+fib_fast_lookup(const void *heap) {
+    return ((const Fibonacci_Heap *)heap)->index != NULL;
+}
+
+static const Heap_Engine fib_engine = {
+    "FibHeap", "Fibonacci Heap",
+    fib_destroy, fib_size, fib_insert, fib_insert_many, fib_get_min, fib_extract_min,
+    fib_extract_min_many, fib_decrease_key, fib_delete_element, fib_delete_key,
+    fib_change_key, fib_contains, fib_get_key, fib_meld,
+    NULL, NULL, NULL, fib_fast_lookup,
+};
+
+// Dary_Heap (dary_heap.h)
+
+static void
+dary_destroy(void *heap) {
+    destroy_dary_heap((Dary_Heap *)heap);
+}
+
+static size_t
+dary_size(const void *heap) {
+    return ((const Dary_Heap *)heap)->n;
+}
+
+static void *
+dary_insert(void *heap, int64_t key, void *payload) {
+    return insert_dary_heap((Dary_Heap *)heap, key, payload);
+}
+
+static bool
+dary_insert_many(void *heap, const int64_t *keys, size_t count) {
+    return insert_many_dary_heap((Dary_Heap *)heap, keys, count);
+}
+
+static bool
+dary_get_min(void *heap, int64_t *key_out) {
+    return get_min_dary_heap((Dary_Heap *)heap, key_out, NULL);
+}
+
+static bool
+dary_extract_min(void *heap, int64_t *key_out, void **payload_out) {
+    return extract_min_dary_heap((Dary_Heap *)heap, key_out, payload_out);
+}
+
+static size_t
+dary_extract_min_many(void *heap, int64_t *keys_out, void **payloads_out, size_t k) {
+    return extract_min_many_dary_heap((Dary_Heap *)heap, keys_out, payloads_out, k);
+}
+
+static bool
+dary_decrease_key(void *heap, void *element, int64_t new_key) {
+    return decrease_key_dary_heap((Dary_Heap *)heap, (Dary_Heap_Slot *)element, new_key);
+}
+
+static bool
+dary_delete_element(void *heap, void *element, void **payload_out) {
+    return delete_node_dary_heap((Dary_Heap *)heap, (Dary_Heap_Slot *)element, NULL, payload_out);
+}
+
+static bool
+dary_delete_key(void *heap, int64_t key, void **payload_out) {
+    Dary_Heap_Slot *slot = find_slot_dary_heap_key((Dary_Heap *)heap, key);
+    return slot != NULL && delete_node_dary_heap((Dary_Heap *)heap, slot, NULL, payload_out);
+}
+
+static bool
+dary_change_key(void *heap, int64_t old_key, int64_t new_key) {
+    Dary_Heap_Slot *slot = find_slot_dary_heap_key((Dary_Heap *)heap, old_key);
+    if (slot == NULL) {
+        return false;
+    }
+    change_key_dary_heap((Dary_Heap *)heap, slot, new_key);
+    return true;
+}
+
+static bool
+dary_contains(void *heap, int64_t key) {
+    return find_slot_dary_heap_key((Dary_Heap *)heap, key) != NULL;
+}
+
+static int64_t
+dary_get_key(const void *heap, const void *element) {
+    return get_key_dary_heap_slot((const Dary_Heap *)heap, (const Dary_Heap_Slot *)element);
+}
+
+static bool
+dary_meld(void *dst, void *src) {
+    return meld_dary_heap((Dary_Heap *)dst, (Dary_Heap *)src);
+}
+
+static const Heap_Engine dary_engine = {
+    "DaryHeap", "d-ary heap",
+    dary_destroy, dary_size, dary_insert, dary_insert_many, dary_get_min, dary_extract_min,
+    dary_extract_min_many, dary_decrease_key, dary_delete_element, dary_delete_key,
+    dary_change_key, dary_contains, dary_get_key, dary_meld,
+    NULL, NULL, NULL, NULL,
+};
+
+// Pairing_Heap (pairing_heap.h)
+
+static void
+pairing_destroy(void *heap) {
+    destroy_pairing_heap((Pairing_Heap *)heap);
+}
+
+static size_t
+pairing_size(const void *heap) {
+    return ((const Pairing_Heap *)heap)->n;
+}
+
+static void *
+pairing_insert(void *heap, int64_t key, void *payload) {
+    return insert_pairing_heap((Pairing_Heap *)heap, key, payload);
+}
+
+static bool
+pairing_insert_many(void *heap, const int64_t *keys, size_t count) {
+    return insert_many_pairing_heap((Pairing_Heap *)heap, keys, count);
+}
+
+static bool
+pairing_get_min(void *heap, int64_t *key_out) {
+    return get_min_pairing_heap((Pairing_Heap *)heap, key_out, NULL);
+}
+
+static bool
+pairing_extract_min(void *heap, int64_t *key_out, void **payload_out) {
+    return extract_min_pairing_heap((Pairing_Heap *)heap, key_out, payload_out);
+}
+
+static size_t
+pairing_extract_min_many(void *heap, int64_t *keys_out, void **payloads_out, size_t k) {
+    return extract_min_many_pairing_heap((Pairing_Heap *)heap, keys_out, payloads_out, k);
+}
+
+static bool
+pairing_decrease_key(void *heap, void *element, int64_t new_key) {
+    return decrease_key_pairing_heap((Pairing_Heap *)heap, (Pairing_Node *)element, new_key);
+}
+
+static bool
+pairing_delete_element(void *heap, void *element, void **payload_out) {
+    return delete_node_pairing_heap((Pairing_Heap *)heap, (Pairing_Node *)element, NULL, payload_out);
+}
+
+static bool
+pairing_delete_key(void *heap, int64_t key, void **payload_out) {
+    Pairing_Node *node = find_node_pairing_heap_key((Pairing_Heap *)heap, key);
+    return node != NULL && delete_node_pairing_heap((Pairing_Heap *)heap, node, NULL, payload_out);
+}
+
+static bool
+pairing_change_key(void *heap, int64_t old_key, int64_t new_key) {
+    Pairing_Node *node = find_node_pairing_heap_key((Pairing_Heap *)heap, old_key);
+    if (node == NULL) {
+        return false;
+    }
+    change_key_pairing_heap((Pairing_Heap *)heap, node, new_key);
+    return true;
+}
+
+static bool
+pairing_contains(void *heap, int64_t key) {
+    return find_node_pairing_heap_key((Pairing_Heap *)heap, key) != NULL;
+}
+
+static int64_t
+pairing_get_key(const void *heap, const void *element) {
+    (void)heap;
+    return ((const Pairing_Node *)element)->key;
+}
+
+static bool
+pairing_meld(void *dst, void *src) {
+    return meld_pairing_heap((Pairing_Heap *)dst, (Pairing_Heap *)src);
+}
+
+static const Heap_Engine pairing_engine = {
+    "PairingHeap", "pairing heap",
+    pairing_destroy, pairing_size, pairing_insert, pairing_insert_many, pairing_get_min,
+    pairing_extract_min, pairing_extract_min_many, pairing_decrease_key, pairing_delete_element,
+    pairing_delete_key, pairing_change_key, pairing_contains, pairing_get_key, pairing_meld,
+    NULL, NULL, NULL, NULL,
+};
+
+// Radix_Heap (radix_heap.h). Python keys are int64, so only 0 .. 2**63-1 reach it; the
+// casts between int64_t and uint64_t arrays are safe for those.
+
+static void
+radix_destroy(void *heap) {
+    destroy_radix_heap((Radix_Heap *)heap);
+}
+
+static size_t
+radix_size(const void *heap) {
+    return ((const Radix_Heap *)heap)->n;
+}
+
+static void *
+radix_insert(void *heap, int64_t key, void *payload) {
+    return insert_radix_heap((Radix_Heap *)heap, (uint64_t)key, payload);
+}
+
+static bool
+radix_insert_many(void *heap, const int64_t *keys, size_t count) {
+    return insert_many_radix_heap((Radix_Heap *)heap, (const uint64_t *)keys, count);
+}
+
+static bool
+radix_get_min(void *heap, int64_t *key_out) {
+    return get_min_radix_heap((Radix_Heap *)heap, (uint64_t *)key_out, NULL);
+}
+
+static bool
+radix_extract_min(void *heap, int64_t *key_out, void **payload_out) {
+    return extract_min_radix_heap((Radix_Heap *)heap, (uint64_t *)key_out, payload_out);
+}
+
+static size_t
+radix_extract_min_many(void *heap, int64_t *keys_out, void **payloads_out, size_t k) {
+    return extract_min_many_radix_heap((Radix_Heap *)heap, (uint64_t *)keys_out, payloads_out, k);
+}
+
+static bool
+radix_decrease_key(void *heap, void *element, int64_t new_key) {
+    return decrease_key_radix_heap((Radix_Heap *)heap, (Radix_Heap_Node *)element, (uint64_t)new_key);
+}
+
+static bool
+radix_delete_element(void *heap, void *element, void **payload_out) {
+    return delete_node_radix_heap((Radix_Heap *)heap, (Radix_Heap_Node *)element, NULL, payload_out);
+}
+
+static bool
+radix_delete_key(void *heap, int64_t key, void **payload_out) {
+    Radix_Heap_Node *node = key < 0 ? NULL : find_node_radix_heap_key((Radix_Heap *)heap, (uint64_t)key);
+    return node != NULL && delete_node_radix_heap((Radix_Heap *)heap, node, NULL, payload_out);
+}
+
+static bool
+radix_change_key(void *heap, int64_t old_key, int64_t new_key) {
+    Radix_Heap_Node *node = old_key < 0 ? NULL : find_node_radix_heap_key((Radix_Heap *)heap, (uint64_t)old_key);
+    return node != NULL && change_key_radix_heap((Radix_Heap *)heap, node, (uint64_t)new_key);
+}
+
+static bool
+radix_contains(void *heap, int64_t key) {
+    return key >= 0 && find_node_radix_heap_key((Radix_Heap *)heap, (uint64_t)key) != NULL;
+}
+
+static int64_t
+radix_get_key(const void *heap, const void *element) {
+    (void)heap;
+    return (int64_t)((const Radix_Heap_Node *)element)->key;
+}
+
+static bool
+radix_meld(void *dst, void *src) {
+    return meld_radix_heap((Radix_Heap *)dst, (Radix_Heap *)src);
+}
+
+enum { RADIX_KEY_RANGE = 1, RADIX_KEY_MONOTONE, RADIX_MELD_BITS, RADIX_MELD_MONOTONE };
+
+static int
+radix_check_key(void *heap, int64_t key, Heap_Check *check_out) {
+    Radix_Heap *h = (Radix_Heap *)heap;
+    check_out->key = key;
+    if (key < 0 || (uint64_t)key > h->max_key) {
+        check_out->high = h->max_key > INT64_MAX ? INT64_MAX : (int64_t)h->max_key;
+        return RADIX_KEY_RANGE;
+    }
+    if (!accepts_key_radix_heap(h, (uint64_t)key)) {
+        check_out->low = (int64_t)h->last; // At most key, so it fits
+        return RADIX_KEY_MONOTONE;
+    }
+    return 0;
+}
+
+static int
+radix_check_meld(void *dst, void *src, Heap_Check *check_out) {
+    Radix_Heap *d = (Radix_Heap *)dst, *s = (Radix_Heap *)src;
+    if (d->key_bits != s->key_bits) {
+        return RADIX_MELD_BITS;
+    }
+    if (!can_meld_radix_heap(d, s)) {
+        check_out->low = (int64_t)d->last;
+        return RADIX_MELD_MONOTONE;
+    }
+    return 0;
+}
+
+static void
+radix_raise_check(int status, const Heap_Check *check) {
+    switch (status) {
+    case RADIX_KEY_RANGE:
+        PyErr_Format(PyExc_ValueError, "RadixHeap key %lld is outside 0 .. %lld.",
+                     (long long)check->key, (long long)check->high);
+        break;
+    case RADIX_KEY_MONOTONE:
+        PyErr_Format(PyExc_ValueError, "RadixHeap key %lld is below the last extracted minimum %lld; keys must be monotone.",
+                     (long long)check->key, (long long)check->low);
+        break;
+    case RADIX_MELD_BITS:
+        PyErr_SetString(PyExc_ValueError, "Cannot meld RadixHeaps with different key_bits.");
+        break;
+    default:
+        PyErr_Format(PyExc_ValueError, "Cannot meld: the other RadixHeap holds keys below the last extracted minimum %lld.",
+                     (long long)check->low);
+    }
+}
+
+static const Heap_Engine radix_engine = {
+    "RadixHeap", "radix heap",
+    radix_destroy, radix_size, radix_insert, radix_insert_many, radix_get_min,
+    radix_extract_min, radix_extract_min_many, radix_decrease_key, radix_delete_element,
+    radix_delete_key, radix_change_key, radix_contains, radix_get_key, radix_meld,
+    radix_check_key, radix_check_meld, radix_raise_check, NULL,
+};
+
+// Bucket_Queue (bucket_queue.h)
+
+static void
+bucket_destroy(void *heap) {
+    destroy_bucket_queue((Bucket_Queue *)heap);
+}
+
+static size_t
+bucket_size(const void *heap) {
+    return ((const Bucket_Queue *)heap)->n;
+}
+
+static void *
+bucket_insert(void *heap, int64_t key, void *payload) {
+    return insert_bucket_queue((Bucket_Queue *)heap, key, payload);
+}
+
+static bool
+bucket_insert_many(void *heap, const int64_t *keys, size_t count) {
+    return insert_many_bucket_queue((Bucket_Queue *)heap, keys, count);
+}
+
+static bool
+bucket_get_min(void *heap, int64_t *key_out) {
+    return get_min_bucket_queue((Bucket_Queue *)heap, key_out, NULL);
+}
+
+static bool
+bucket_extract_min(void *heap, int64_t *key_out, void **payload_out) {
+    return extract_min_bucket_queue((Bucket_Queue *)heap, key_out, payload_out);
+}
+
+static size_t
+bucket_extract_min_many(void *heap, int64_t *keys_out, void **payloads_out, size_t k) {
+    return extract_min_many_bucket_queue((Bucket_Queue *)heap, keys_out, payloads_out, k);
+}
+
+static bool
+bucket_decrease_key(void *heap, void *element, int64_t new_key) {
+    return decrease_key_bucket_queue((Bucket_Queue *)heap, (Bucket_Queue_Node *)element, new_key);
+}
+
+static bool
+bucket_delete_element(void *heap, void *element, void **payload_out) {
+    return delete_node_bucket_queue((Bucket_Queue *)heap, (Bucket_Queue_Node *)element, NULL, payload_out);
+}
+
+static bool
+bucket_delete_key(void *heap, int64_t key, void **payload_out) {
+    Bucket_Queue_Node *node = find_node_bucket_queue_key((Bucket_Queue *)heap, key);
+    return node != NULL && delete_node_bucket_queue((Bucket_Queue *)heap, node, NULL, payload_out);
+}
+
+static bool
+bucket_change_key(void *heap, int64_t old_key, int64_t new_key) {
+    Bucket_Queue_Node *node = find_node_bucket_queue_key((Bucket_Queue *)heap, old_key);
+    return node != NULL && change_key_bucket_queue((Bucket_Queue *)heap, node, new_key);
+}
+
+static bool
+bucket_contains(void *heap, int64_t key) {
+    return find_node_bucket_queue_key((Bucket_Queue *)heap, key) != NULL;
+}
+
+static int64_t
+bucket_get_key(const void *heap, const void *element) {
+    (void)heap;
+    return ((const Bucket_Queue_Node *)element)->key;
+}
+
+static bool
+bucket_meld(void *dst, void *src) {
+    return meld_bucket_queue((Bucket_Queue *)dst, (Bucket_Queue *)src);
+}
+
+enum { BUCKET_KEY_WINDOW = 1, BUCKET_MELD_GEOMETRY };
+
+static int
+bucket_check_key(void *heap, int64_t key, Heap_Check *check_out) {
+    Bucket_Queue *q = (Bucket_Queue *)heap;
+    if (!accepts_key_bucket_queue(q, key)) {
+        check_out->key = key;
+        check_out->low = q->circular ? q->last : q->min_key;
+        check_out->high = check_out->low + (int64_t)(q->range - 1);
+        return BUCKET_KEY_WINDOW;
+    }
+    return 0;
+}
+
+static int
+bucket_check_meld(void *dst, void *src, Heap_Check *check_out) {
+    (void)check_out;
+    return can_meld_bucket_queue((Bucket_Queue *)dst, (Bucket_Queue *)src) ? 0 : BUCKET_MELD_GEOMETRY;
+}
+
+static void
+bucket_raise_check(int status, const Heap_Check *check) {
+    if (status == BUCKET_KEY_WINDOW) {
+        PyErr_Format(PyExc_ValueError, "BucketQueue key %lld is outside the current window %lld .. %lld.",
+                     (long long)check->key, (long long)check->low, (long long)check->high);
+    } else {
+        PyErr_SetString(PyExc_ValueError, "Cannot meld BucketQueues with different ranges or modes, or whose keys do not fit the window.");
+    }
+}
+
+static bool
+bucket_fast_lookup(const void *heap) {
+    (void)heap;
+    return true; // A key has exactly one bucket
+}
+
+static const Heap_Engine bucket_engine = {
+    "BucketQueue", "bucket queue",
+    bucket_destroy, bucket_size, bucket_insert, bucket_insert_many, bucket_get_min,
+    bucket_extract_min, bucket_extract_min_many, bucket_decrease_key, bucket_delete_element,
+    bucket_delete_key, bucket_change_key, bucket_contains, bucket_get_key, bucket_meld,
+    bucket_check_key, bucket_check_meld, bucket_raise_check, bucket_fast_lookup,
+};
+
+// --- Methods for the HandleObject ---
+
+static void
+Handle_dealloc(HandleObject *self) {
+    // A handle still in a heap is kept alive by that heap, so there is nothing to detach here.
+    LOCK_OWNERS();
+    decref_heap_owner(self->owner);
+    UNLOCK_OWNERS();
+    PyTypeObject *type = Py_TYPE(self);
+    type->tp_free((PyObject *)self);
+    Py_DECREF(type); // Instances of heap types hold a reference to their type
+}
+
+// Reads the current key of a handle into *key_out. Returns false if its element was removed.
+static bool
+handle_key(HandleObject *self, int64_t *key_out) {
+    for (;;) {
+        // The heap is kept alive while its lock is awaited, and the handle checked again once
+        // it is held: a meld or removal may have happened in between.
+        LOCK_OWNERS();
+        HeapObject *heap = self->node != NULL ? heap_of_handle(self) : NULL;
+        if (heap != NULL && !incref_found_heap(heap)) {
+            heap = NULL;
+        }
+        UNLOCK_OWNERS();
+        if (heap == NULL) {
+            return false;
+        }
+        lock_heap(heap);
+        LOCK_OWNERS();
+        void *node = self->node != NULL && heap_of_handle(self) == heap ? self->node : NULL;
+        UNLOCK_OWNERS();
+        if (node != NULL) {
+            *key_out = heap->engine->get_key(heap->heap, node); // Removing it needs the heap's lock
+        }
+        unlock_heap(heap);
+        Py_DECREF(heap);
+        if (node != NULL) {
+            return true;
+        }
+    }
+}
+
+static PyObject *
+Handle_repr(HandleObject *self) {
+    int64_t key;
+    if (!handle_key(self, &key)) {
+        return PyUnicode_FromString("<fibheap.Handle (removed)>");
+    }
+    return PyUnicode_FromFormat("<fibheap.Handle key=%lld>", (long long)key);
+}
+
+static PyObject *
+Handle_get_key(HandleObject *self, void *Py_UNUSED(closure)) {
+    int64_t key;
+    if (!handle_key(self, &key)) {
+        Py_RETURN_NONE;
+    }
+    return PyLong_FromLongLong(key);
+}
+
+static PyObject *
+Handle_get_valid(HandleObject *self, void *Py_UNUSED(closure)) {
+    LOCK_OWNERS();
+    bool valid = self->node != NULL;
+    UNLOCK_OWNERS();
+    return PyBool_FromLong(valid);
+}
+
+static PyGetSetDef Handle_getset[] = {
+    {"key", (getter)Handle_get_key, NULL, "Current key of the element, or None once it was removed.", NULL},
+    {"valid", (getter)Handle_get_valid, NULL, "True while the element is still in its heap.", NULL},
+    {NULL}  /* Sentinel */
+};
+
+static PyType_Slot Handle_slots[] = {
+    {Py_tp_doc, "Reference to an element inserted into a heap, valid until it is removed."},
+    {Py_tp_dealloc, Handle_dealloc},
+    {Py_tp_repr, Handle_repr},
+    {Py_tp_getset, Handle_getset},
+    {0, NULL}
+};
+
+static PyType_Spec Handle_spec = {
+    .name = "fibheap.Handle",
+    .basicsize = sizeof(HandleObject),
+    .itemsize = 0,
+    // Handles are only created by insert
+    .flags = Py_TPFLAGS_DEFAULT | Py_TPFLAGS_DISALLOW_INSTANTIATION,
+    .slots = Handle_slots,
+};
+
+// --- Methods shared by every heap class ---
+
+// Allocates a heap object for `engine` with its owner token; the caller creates the C heap.
+static HeapObject *
+new_heap_object(PyTypeObject *type, const Heap_Engine *engine) {
+    HeapObject *self = (HeapObject *)type->tp_alloc(type, 0);
+    if (self == NULL) {
+        return NULL;
+    }
+    self->engine = engine;
+    self->heap = NULL;
+    self->handles = 0;
+    self->lock = PyThread_allocate_lock();
+    if (self->lock == NULL) {
+        Py_DECREF(self);
+        PyErr_NoMemory();
+        return NULL;
+    }
+    self->owner = new_heap_owner(self);
+    if (self->owner == NULL) {
+        Py_DECREF(self);
+        return NULL;
+    }
+#if defined(Py_GIL_DISABLED) && PY_VERSION_HEX >= 0x030E0000
+    PyUnstable_EnableTryIncRef((PyObject *)self); // For incref_found_heap
+#endif
+    return self;
+}
+
+// Returns true if `obj` is a heap of one of the classes in `state`. Heaps of another copy of
+// the module (another interpreter's, say) do not count: their handles are of another type.
+static bool
+is_heap_object(Module_State *state, PyObject *obj) {
+    if (state == NULL) {
+        return false;
+    }
+    for (size_t i = 0; i < HEAP_TYPE_COUNT; i++) {
+        if (PyObject_TypeCheck(obj, state->heap_types[i])) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// FibHeap.__new__(index=True)
+static PyObject *
+FibHeap_new(PyTypeObject *type, PyObject *args, PyObject *kwds) {
+    static char *kwlist[] = {"index", "consolidate_budget", NULL};
+    int use_index = 1;
+    int budget = 0;
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "|pi", kwlist, &use_index, &budget)) {
+        return NULL;
+    }
+    if (budget < 0) {
+        PyErr_SetString(PyExc_ValueError, "consolidate_budget must not be negative.");
+        return NULL;
+    }
+
+    HeapObject *self = new_heap_object(type, &fib_engine);
+    if (self == NULL) {
+        return NULL;
+    }
+    Fibonacci_Heap *fh = create_fib_heap();
+    if (fh == NULL) {
+        Py_DECREF(self);
+        PyErr_SetString(PyExc_MemoryError, "Failed to create Fibonacci Heap.");
+        return NULL;
+    }
+    // Node payloads are handles; destroy_fib_heap detaches whatever is left.
+    fh->free_payload = release_handle;
+    self->heap = fh;
+    // The key index makes delete(value), update_key and `in` O(1) instead of a full scan.
+    if (use_index && !enable_index_fib_heap(fh)) {
+        Py_DECREF(self);
+        PyErr_SetString(PyExc_MemoryError, "Failed to create the Fibonacci Heap key index.");
+        return NULL;
+    }
+    // A budget spreads consolidation over every operation, bounding the latency of each pop.
+    set_consolidate_budget_fib_heap(fh, budget);
+    return (PyObject *)self;
+}
+
+// DaryHeap.__new__(arity=4)
+static PyObject *
+DaryHeap_new(PyTypeObject *type, PyObject *args, PyObject *kwds) {
+    static char *kwlist[] = {"arity", NULL};
+    int arity = 4;
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "|i", kwlist, &arity)) {
+        return NULL;
+    }
+    if (arity < DARY_HEAP_MIN_ARITY || arity > DARY_HEAP_MAX_ARITY) {
+        PyErr_Format(PyExc_ValueError, "arity must be between %d and %d.", DARY_HEAP_MIN_ARITY, DARY_HEAP_MAX_ARITY);
+        return NULL;
+    }
+
+    HeapObject *self = new_heap_object(type, &dary_engine);
+    if (self == NULL) {
+        return NULL;
+    }
+    Dary_Heap *h = create_dary_heap((unsigned)arity);
+    if (h == NULL) {
+        Py_DECREF(self);
+        PyErr_SetString(PyExc_MemoryError, "Failed to create d-ary heap.");
+        return NULL;
+    }
+    h->free_payload = release_handle;
+    self->heap = h;
+    return (PyObject *)self;
+}
+
+// PairingHeap.__new__()
+static PyObject *
+PairingHeap_new(PyTypeObject *type, PyObject *args, PyObject *kwds) {
+    static char *kwlist[] = {NULL};
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "", kwlist)) {
+        return NULL;
+    }
+
+    HeapObject *self = new_heap_object(type, &pairing_engine);
+    if (self == NULL) {
+        return NULL;
+    }
+    Pairing_Heap *h = create_pairing_heap();
+    if (h == NULL) {
+        Py_DECREF(self);
+        PyErr_SetString(PyExc_MemoryError, "Failed to create pairing heap.");
+        return NULL;
+    }
+    h->free_payload = release_handle;
+    self->heap = h;
+    return (PyObject *)self;
+}
+
+// RadixHeap.__new__(key_bits=64)
+static PyObject *
+RadixHeap_new(PyTypeObject *type, PyObject *args, PyObject *kwds) {
+    static char *kwlist[] = {"key_bits", NULL};
+    int key_bits = 64;
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "|i", kwlist, &key_bits)) {
+        return NULL;
+    }
+    if (key_bits != 32 && key_bits != 64) {
+        PyErr_SetString(PyExc_ValueError, "key_bits must be 32 or 64.");
+        return NULL;
+    }
+
+    HeapObject *self = new_heap_object(type, &radix_engine);
+    if (self == NULL) {
+        return NULL;
+    }
+    Radix_Heap *h = create_radix_heap((unsigned)key_bits);
+    if (h == NULL) {
+        Py_DECREF(self);
+        PyErr_SetString(PyExc_MemoryError, "Failed to create radix heap.");
+        return NULL;
+    }
+    h->free_payload = release_handle;
+    self->heap = h;
+    return (PyObject *)self;
+}
+
+// BucketQueue.__new__(range, min_key=0, circular=False)
+static PyObject *
+BucketQueue_new(PyTypeObject *type, PyObject *args, PyObject *kwds) {
+    static char *kwlist[] = {"range", "min_key", "circular", NULL};
+    Py_ssize_t range;
+    long long min_key = 0;
+    int circular = 0;
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "n|Lp", kwlist, &range, &min_key, &circular)) {
+        return NULL;
+    }
+    if (range < 1 || (size_t)range > BUCKET_QUEUE_MAX_RANGE) {
+        PyErr_Format(PyExc_ValueError, "range must be between 1 and %zu.", (size_t)BUCKET_QUEUE_MAX_RANGE);
+        return NULL;
+    }
+
+    HeapObject *self = new_heap_object(type, &bucket_engine);
+    if (self == NULL) {
+        return NULL;
+    }
+    Bucket_Queue *q = create_bucket_queue((int64_t)min_key, (size_t)range, circular != 0);
+    if (q == NULL) {
+        Py_DECREF(self);
+        PyErr_SetString(PyExc_ValueError, "Failed to create bucket queue (min_key + range overflows, or out of memory).");
+        return NULL;
+    }
+    q->free_payload = release_handle;
+    self->heap = q;
+    return (PyObject *)self;
+}
+
+// __dealloc__
+static void
+Heap_dealloc(HeapObject *self) {
+    if (self->owner != NULL) {
+        // Handles stop resolving to this heap before it goes away. Tokens melded into it may
+        // outlive it through handles that were removed.
+        LOCK_OWNERS();
+        self->owner->heap = NULL;
+        UNLOCK_OWNERS();
+    }
+    if (self->heap != NULL) {
+        // Keys live inline in the heap; remaining handles are detached through free_payload,
+        // which needs the GIL. Without handles nothing else can reach the heap any more.
+        PyThreadState *state = release_gil_if(self->handles == 0 && self->engine->size(self->heap) >= GIL_RELEASE_THRESHOLD);
+        self->engine->destroy(self->heap);
+        restore_gil(state);
+        self->heap = NULL;
+    }
+    if (self->lock != NULL) {
+        PyThread_free_lock(self->lock);
+        self->lock = NULL;
+    }
+    if (self->owner != NULL) {
+        LOCK_OWNERS();
+        decref_heap_owner(self->owner);
+        UNLOCK_OWNERS();
+        self->owner = NULL;
+    }
+    PyTypeObject *type = Py_TYPE(self);
+    type->tp_free((PyObject *)self);
+    Py_DECREF(type);
+}
+
+// __repr__
+static PyObject *
+Heap_repr(HeapObject *self) {
+    if (self->heap == NULL) {
+        return PyUnicode_FromFormat("<%s object (uninitialized)>", self->engine->name);
+    }
+    // In a real scenario, you might want to show more info, like size or min element
+    lock_heap(self);
+    size_t size = self->engine->size(self->heap);
+    unlock_heap(self);
+    return PyUnicode_FromFormat("<%s object at %p, size %zu>", self->engine->name, (void *)self, size);
+}
+
+// --- Key buffer helpers ---
+
+// Returns the struct-module code of an integer buffer format ('b', 'q', ...) with any
+// native byte order prefix stripped, or 0 if it is not a single native-order integer of 1,
+// 2, 4 or 8 bytes. The width is `itemsize`, not the C type's: a '<' or '=' prefix means
+// the struct module's standard sizes, so '<l' is 4 bytes wide even where long is 8.
+static char
+native_int_format(const char *format, Py_ssize_t itemsize) {
+    if (itemsize != 1 && itemsize != 2 && itemsize != 4 && itemsize != 8) {
+        return 0;
+    }
+    if (format == NULL) {
+        return itemsize == 1 ? 'B' : 0; // Plain bytes
+    }
+#if PY_LITTLE_ENDIAN
+    if (*format == '@' || *format == '=' || *format == '<') {
+#else
+    if (*format == '@' || *format == '=' || *format == '>' || *format == '!') {
+#endif
+        format++;
+    }
+    if (format[0] == '\0' || format[1] != '\0' || strchr("bBhHiIlLqQnN", format[0]) == NULL) {
+        return 0;
+    }
+    return format[0];
+}
+
+// Reads the integer at `item` of a buffer whose format code `code` (see native_int_format)
+// gives the signedness and whose `itemsize` the width. Returns false if it does not fit in
+// an int64; needs no GIL.
+static bool
+key_from_item(char code, Py_ssize_t itemsize, const char *item, Fibonacci_Key *key_out) {
+    if (code >= 'a') { // Lower case codes are signed
+        switch (itemsize) {
+        case 1: *key_out = *(const int8_t *)item; break;
+        case 2: *key_out = *(const int16_t *)item; break;
+        case 4: *key_out = *(const int32_t *)item; break;
+        default: *key_out = *(const int64_t *)item;
+        }
+        return true;
+    }
+    uint64_t value;
+    switch (itemsize) {
+    case 1: value = *(const uint8_t *)item; break;
+    case 2: value = *(const uint16_t *)item; break;
+    case 4: value = *(const uint32_t *)item; break;
+    default: value = *(const uint64_t *)item;
+    }
+    if (value > (uint64_t)INT64_MAX) {
+        return false; // Unsigned types as wide as the key may not fit
+    }
+    *key_out = (Fibonacci_Key)value;
+    return true;
+}
+
+// Copies the keys of a contiguous integer buffer into an int64 array allocated with
+// PyMem_Malloc, or returns `view->buf` itself when it already holds native int64s.
+// Returns NULL with an exception set on unsupported formats or out-of-range values.
+static Fibonacci_Key *
+keys_from_buffer(Py_buffer *view, Py_ssize_t *count_out) {
+    char code = native_int_format(view->format, view->itemsize);
+    if (code == 0) {
+        PyErr_Format(PyExc_TypeError, "expected a buffer of integers, got format '%s'", view->format);
+        return NULL;
+    }
+    Py_ssize_t count = view->itemsize > 0 ? view->len / view->itemsize : 0;
+    *count_out = count;
+    if (view->itemsize == sizeof(Fibonacci_Key) && strchr("qln", code) != NULL) {
+        return (Fibonacci_Key *)view->buf; // Native int64: no copy needed
+    }
+
+    Fibonacci_Key *keys = PyMem_New(Fibonacci_Key, count > 0 ? count : 1);
+    if (keys == NULL) {
+        PyErr_NoMemory();
+        return NULL;
+    }
+    const char *item = (const char *)view->buf;
+    for (Py_ssize_t i = 0; i < count; i++, item += view->itemsize) {
+        if (!key_from_item(code, view->itemsize, item, &keys[i])) {
+            PyMem_Free(keys);
+            PyErr_SetString(PyExc_OverflowError, "key does not fit in a signed 64-bit integer");
+            return NULL;
+        }
+    }
+    return keys;
+}
+
+// Collects the keys of any iterable of ints into an int64 array allocated with PyMem_Malloc.
+static Fibonacci_Key *
+keys_from_iterable(PyObject *iterable, Py_ssize_t *count_out) {
+    PyObject *iterator = PyObject_GetIter(iterable);
+    if (iterator == NULL) {
+        return NULL;
+    }
+    Py_ssize_t hint = PyObject_LengthHint(iterable, 16);
+    if (hint < 0) {
+        Py_DECREF(iterator);
+        return NULL;
+    }
+    Py_ssize_t capacity = hint > 0 ? hint : 16, count = 0;
+    Fibonacci_Key *keys = PyMem_New(Fibonacci_Key, capacity);
+    if (keys == NULL) {
+        Py_DECREF(iterator);
+        PyErr_NoMemory();
+        return NULL;
+    }
+
+    PyObject *item;
+    while ((item = PyIter_Next(iterator)) != NULL) {
+        long long value = PyLong_AsLongLong(item);
+        Py_DECREF(item);
+        if (value == -1 && PyErr_Occurred()) {
+            break;
+        }
+        if (count == capacity) {
+            capacity *= 2;
+            Fibonacci_Key *grown = PyMem_Resize(keys, Fibonacci_Key, capacity);
+            if (grown == NULL) {
+                PyErr_NoMemory();
+                break;
+            }
+            keys = grown;
+        }
+        keys[count++] = (Fibonacci_Key)value;
+    }
+    Py_DECREF(iterator);
+    if (PyErr_Occurred()) {
+        PyMem_Free(keys);
+        return NULL;
+    }
+    *count_out = count;
+    return keys;
+}
+
+// Keys of an insert_many-style argument. Buffers of integers (array.array, numpy arrays, ...)
+// are read directly; anything else is iterated into a temporary array first.
+typedef struct {
+    Py_buffer view;
+    bool have_view;
+    Fibonacci_Key *keys; // Stays put until release_keys: a copy is ours and a view pins the buffer
+    Py_ssize_t count;
+} Key_Array;
+
+// Fills 'out' from 'arg'. Returns false with an exception set on failure.
+static bool
+get_keys(PyObject *arg, Key_Array *out) {
+    out->have_view = false;
+    out->count = 0;
+    if (PyObject_CheckBuffer(arg)) {
+        if (PyObject_GetBuffer(arg, &out->view, PyBUF_C_CONTIGUOUS | PyBUF_FORMAT) < 0) {
+            return false;
+        }
+        out->have_view = true;
+        out->keys = keys_from_buffer(&out->view, &out->count);
+    } else {
+        out->keys = keys_from_iterable(arg, &out->count);
+    }
+    if (out->keys == NULL && out->have_view) {
+        PyBuffer_Release(&out->view);
+    }
+    return out->keys != NULL;
+}
+
+static void
+release_keys(Key_Array *keys) {
+    if (!keys->have_view || keys->keys != keys->view.buf) {
+        PyMem_Free(keys->keys);
+    }
+    if (keys->have_view) {
+        PyBuffer_Release(&keys->view);
+    }
+}
+
+// Creates an array('q') of 'count' zeros and exports its buffer into 'view' for the caller to
+// fill, with or without the GIL: nobody else holds the array yet. Returns NULL with an
+// exception set on failure.
+static PyObject *
+new_int64_array(Py_ssize_t count, Py_buffer *view) {
+    PyObject *array_module = PyImport_ImportModule("array");
+    if (array_module == NULL) {
+        return NULL;
+    }
+    PyObject *result = NULL;
+    PyObject *zeros = PyBytes_FromStringAndSize(NULL, count * (Py_ssize_t)sizeof(int64_t));
+    if (zeros != NULL) {
+        memset(PyBytes_AS_STRING(zeros), 0, (size_t)count * sizeof(int64_t));
+        result = PyObject_CallMethod(array_module, "array", "sO", "q", zeros);
+        Py_DECREF(zeros);
+    }
+    Py_DECREF(array_module);
+    if (result != NULL && PyObject_GetBuffer(result, view, PyBUF_WRITABLE | PyBUF_C_CONTIGUOUS) < 0) {
+        Py_CLEAR(result);
+    }
+    return result;
+}
+
+// --- Python Methods shared by every heap class ---
+
+// insert(self, value)
+static PyObject *
+Heap_insert(HeapObject *self, PyObject *args) {
+    long long val;
+    if (!PyArg_ParseTuple(args, "L", &val)) {
+        return NULL; // Error already set by PyArg_ParseTuple (including OverflowError beyond 64 bits)
+    }
+
+    if (self->heap == NULL) {
+        PyErr_SetString(PyExc_RuntimeError, "Heap not initialized.");
+        return NULL;
+    }
+
+    Module_State *state = find_module_state(Py_TYPE(self));
+    HandleObject *handle = PyObject_New(HandleObject, state->handle_type);
+    if (handle == NULL) {
+        return NULL;
+    }
+    handle->owner = NULL;
+    handle->node = NULL;
+    lock_heap(self);
+    Heap_Check check;
+    int status = self->engine->check_key != NULL ? self->engine->check_key(self->heap, (int64_t)val, &check) : 0;
+    if (status != 0) {
+        unlock_heap(self);
+        Py_DECREF(handle);
+        self->engine->raise_check(status, &check);
+        return NULL;
+    }
+
+    // The key is stored inline in the heap; the element's payload keeps the handle alive.
+    // The heap's reference is taken before the handle is published: once it is, another
+    // thread may pop the element and drop that reference while this one still returns it.
+    Py_INCREF(handle); // One reference for the heap, one for the caller
+    void *node = self->engine->insert(self->heap, (int64_t)val, handle);
+    if (node == NULL) {
+        unlock_heap(self);
+        Py_DECREF(handle);
+        Py_DECREF(handle);
+        PyErr_Format(PyExc_RuntimeError, "Failed to insert into %s.", self->engine->label);
+        return NULL;
+    }
+    LOCK_OWNERS();
+    handle->owner = self->owner;
+    handle->owner->refcount++;
+    handle->node = node;
+    self->handles++;
+    UNLOCK_OWNERS();
+    unlock_heap(self);
+    return (PyObject *)handle;
+}
+
+// insert_many(self, iterable)
+static PyObject *
+Heap_insert_many(HeapObject *self, PyObject *arg) {
+    if (self->heap == NULL) {
+        PyErr_SetString(PyExc_RuntimeError, "Heap not initialized.");
+        return NULL;
+    }
+
+    // Either way the keys arrive, the heap sees one call
+    Key_Array keys;
+    if (!get_keys(arg, &keys)) {
+        return NULL;
+    }
+
+    bool ok = true;
+    Heap_Check check;
+    int status = 0;
+    lock_heap(self);
+    if (self->engine->check_key != NULL) {
+        // Check the whole batch up front so a rejected key leaves the heap unchanged
+        for (Py_ssize_t i = 0; status == 0 && i < keys.count; i++) {
+            status = self->engine->check_key(self->heap, keys.keys[i], &check);
+        }
+    }
+    if (status == 0) {
+        PyThreadState *state = release_gil_if(keys.count >= GIL_RELEASE_THRESHOLD);
+        ok = self->engine->insert_many(self->heap, keys.keys, (size_t)keys.count);
+        restore_gil(state);
+    }
+    unlock_heap(self);
+    release_keys(&keys);
+    if (status != 0) {
+        self->engine->raise_check(status, &check);
+        return NULL;
+    }
+    if (!ok) {
+        PyErr_Format(PyExc_MemoryError, "Failed to insert into %s.", self->engine->label);
+        return NULL;
+    }
+
+    Py_RETURN_NONE;
+}
+
+// get_min(self)
+static PyObject *
+Heap_get_min(HeapObject *self, PyObject *Py_UNUSED(ignored)) {
+    if (self->heap == NULL) {
+        PyErr_SetString(PyExc_RuntimeError, "Heap not initialized.");
+        return NULL;
+    }
+
+    int64_t min_key;
+    lock_heap(self);
+    bool found = self->engine->get_min(self->heap, &min_key);
+    unlock_heap(self);
+    if (!found) {
+        Py_RETURN_NONE; // Standard Python way to indicate "empty" or "not found" for get operations
+    }
+
+    return PyLong_FromLongLong(min_key);
+}
+
+// extract_min(self)
+static PyObject *
+Heap_extract_min(HeapObject *self, PyObject *Py_UNUSED(ignored)) {
+    if (self->heap == NULL) {
+        PyErr_SetString(PyExc_RuntimeError, "Heap not initialized.");
+        return NULL;
+    }
+
+    lock_heap(self);
+    if (self->engine->size(self->heap) == 0) {
+        unlock_heap(self);
+        Py_RETURN_NONE;
+    }
+
+    int64_t extracted_key;
+    void *payload = NULL;
+    if (!self->engine->extract_min(self->heap, &extracted_key, &payload)) {
+        // This case should ideally not happen if the heap is not empty,
+        // but good to handle if extract_min can fail for other reasons.
+        unlock_heap(self);
+        PyErr_Format(PyExc_RuntimeError, "extract_min failed unexpectedly on %s.", self->engine->label);
+        return NULL;
+    }
+    if (payload != NULL) {
+        release_handle(payload);
+    }
+    unlock_heap(self);
+
+    return PyLong_FromLongLong(extracted_key);
+}
+
+// Helper for pop_n: extracts up to k keys into keys_out with the heap locked, returning how
+// many came out. Large batches run without the GIL; their handles are collected on the way
+// and released once it is back. Returns -1 if that buffer is not available; the caller raises
+// MemoryError once the heap is unlocked.
+static Py_ssize_t
+extract_keys_locked(HeapObject *self, int64_t *keys_out, Py_ssize_t k) {
+    size_t size = self->engine->size(self->heap);
+    size_t count = (size_t)k < size ? (size_t)k : size;
+    if (count < GIL_RELEASE_THRESHOLD || self->handles == 0) {
+        // Handles (if any) are released through the engine's free_payload as their elements come out
+        PyThreadState *state = release_gil_if(count >= GIL_RELEASE_THRESHOLD);
+        size_t written = self->engine->extract_min_many(self->heap, keys_out, NULL, count);
+        restore_gil(state);
+        return (Py_ssize_t)written;
+    }
+
+    void **payloads = PyMem_New(void *, count);
+    if (payloads == NULL) {
+        return -1;
+    }
+    Py_BEGIN_ALLOW_THREADS
+    count = self->engine->extract_min_many(self->heap, keys_out, payloads, count);
+    Py_END_ALLOW_THREADS
+    for (size_t i = 0; i < count; i++) {
+        if (payloads[i] != NULL) {
+            release_handle(payloads[i]);
+        }
+    }
+    PyMem_Free(payloads);
+    return (Py_ssize_t)count;
+}
+
+// pop_n(self, k, out=None)
+static PyObject *
+Heap_pop_n(HeapObject *self, PyObject *args, PyObject *kwds) {
+    static char *kwlist[] = {"k", "out", NULL};
+    Py_ssize_t k;
+    PyObject *out = Py_None;
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "n|O", kwlist, &k, &out)) {
+        return NULL;
+    }
+    if (self->heap == NULL) {
+        PyErr_SetString(PyExc_RuntimeError, "Heap not initialized.");
+        return NULL;
+    }
+    if (k < 0) {
+        PyErr_SetString(PyExc_ValueError, "k must not be negative.");
+        return NULL;
+    }
+
+    // a. Keys go straight into the caller's buffer, which must hold k native int64s
+    if (out != Py_None) {
+        Py_buffer view;
+        if (PyObject_GetBuffer(out, &view, PyBUF_WRITABLE | PyBUF_C_CONTIGUOUS | PyBUF_FORMAT) < 0) {
+            return NULL;
+        }
+        char code = native_int_format(view.format, view.itemsize);
+        if (view.itemsize != sizeof(int64_t) || code == 0 || strchr("qln", code) == NULL) {
+            PyErr_Format(PyExc_TypeError, "out must be a buffer of signed 64-bit integers, got format '%s'", view.format);
+            PyBuffer_Release(&view);
+            return NULL;
+        }
+        if (view.len / view.itemsize < k) {
+            PyErr_SetString(PyExc_ValueError, "out is smaller than k.");
+            PyBuffer_Release(&view);
+            return NULL;
+        }
+        lock_heap(self);
+        Py_ssize_t written = extract_keys_locked(self, (int64_t *)view.buf, k);
+        unlock_heap(self);
+        PyBuffer_Release(&view);
+        return written < 0 ? PyErr_NoMemory() : PyLong_FromSsize_t(written);
+    }
+
+    // b. Otherwise return a new array('q') holding exactly the keys popped. It is allocated
+    // without the lock, which is not reentrant, since an allocation may run a finalizer that
+    // uses this heap; it is trimmed afterwards if another thread popped keys meanwhile.
+    lock_heap(self);
+    size_t size = self->engine->size(self->heap);
+    unlock_heap(self);
+    Py_ssize_t count = (size_t)k < size ? k : (Py_ssize_t)size;
+    Py_buffer view;
+    PyObject *result = new_int64_array(count, &view);
+    if (result == NULL) {
+        return NULL;
+    }
+    lock_heap(self);
+    Py_ssize_t written = extract_keys_locked(self, (int64_t *)view.buf, count);
+    unlock_heap(self);
+    PyBuffer_Release(&view);
+    if (written < 0) {
+        Py_DECREF(result);
+        return PyErr_NoMemory();
+    }
+    if (written < count && PySequence_DelSlice(result, written, count) < 0) {
+        Py_CLEAR(result);
+    }
+    return result;
+}
+
+// Helper for the lookups by value: true if one should run without the GIL
+static bool
+is_slow_lookup(HeapObject *self) {
+    return (self->engine->fast_lookup == NULL || !self->engine->fast_lookup(self->heap))
+           && self->engine->size(self->heap) >= GIL_RELEASE_THRESHOLD;
+}
+
+// delete(self, value_or_handle)
+static PyObject *
+Heap_delete(HeapObject *self, PyObject *arg) {
+    if (self->heap == NULL) {
+        PyErr_SetString(PyExc_RuntimeError, "Heap not initialized.");
+        return NULL;
+    }
+
+    void *payload = NULL;
+    if (Py_IS_TYPE(arg, find_module_state(Py_TYPE(self))->handle_type)) {
+        // A handle goes straight to its element. It is checked with the lock held, since
+        // another thread may be removing elements without the GIL.
+        lock_heap(self);
+        void *node = node_from_handle(self, arg);
+        if (node == NULL) {
+            unlock_heap(self);
+            raise_stale_handle();
+            return NULL;
+        }
+        if (!self->engine->delete_element(self->heap, node, &payload)) {
+            unlock_heap(self);
+            PyErr_Format(PyExc_RuntimeError, "Failed to delete from %s.", self->engine->label);
+            return NULL;
+        }
+    } else {
+        long long val = PyLong_AsLongLong(arg);
+        if (val == -1 && PyErr_Occurred()) {
+            return NULL;
+        }
+        // delete_key searches for an element holding `val` and removes it.
+        lock_heap(self);
+        PyThreadState *state = release_gil_if(is_slow_lookup(self));
+        bool deleted = self->engine->delete_key(self->heap, (int64_t)val, &payload);
+        restore_gil(state);
+        if (!deleted) {
+            unlock_heap(self);
+            PyErr_Format(PyExc_RuntimeError, "Failed to delete from %s (or value not found).", self->engine->label);
+            return NULL;
+        }
+    }
+    if (payload != NULL) {
+        release_handle(payload);
+    }
+    unlock_heap(self);
+
+    Py_RETURN_NONE;
+}
+
+// decrease_key(self, handle, new_value)
+static PyObject *
+Heap_decrease_key(HeapObject *self, PyObject *args) {
+    PyObject *handle;
+    long long new_val;
+    if (!PyArg_ParseTuple(args, "O!L", find_module_state(Py_TYPE(self))->handle_type, &handle, &new_val)) {
+        return NULL;
+    }
+
+    if (self->heap == NULL) {
+        PyErr_SetString(PyExc_RuntimeError, "Heap not initialized.");
+        return NULL;
+    }
+
+    lock_heap(self);
+    void *node = node_from_handle(self, handle);
+    if (node == NULL) {
+        unlock_heap(self);
+        raise_stale_handle();
+        return NULL;
+    }
+    Heap_Check check;
+    int status = self->engine->check_key != NULL ? self->engine->check_key(self->heap, (int64_t)new_val, &check) : 0;
+    if (status != 0) {
+        unlock_heap(self);
+        self->engine->raise_check(status, &check);
+        return NULL;
+    }
+    bool decreased = self->engine->decrease_key(self->heap, node, (int64_t)new_val);
+    unlock_heap(self);
+    if (!decreased) {
+        PyErr_SetString(PyExc_ValueError, "New key is greater than the current key.");
+        return NULL;
+    }
+
+    Py_RETURN_NONE;
+}
+
+
+// update_key(self, old_value, new_value)
+static PyObject *
+Heap_update_key(HeapObject *self, PyObject *args) {
+    long long old_val, new_val;
+    if (!PyArg_ParseTuple(args, "LL", &old_val, &new_val)) {
+        return NULL;
+    }
+
+    if (self->heap == NULL) {
+        PyErr_SetString(PyExc_RuntimeError, "Heap not initialized.");
+        return NULL;
+    }
+
+    lock_heap(self);
+    Heap_Check check;
+    int status = self->engine->check_key != NULL ? self->engine->check_key(self->heap, (int64_t)new_val, &check) : 0;
+    if (status != 0) {
+        unlock_heap(self);
+        self->engine->raise_check(status, &check);
+        return NULL;
+    }
+    // change_key finds the element holding `old_val` and moves it to `new_val` in place;
+    // the element (and its handle) stays the same.
+    PyThreadState *state = release_gil_if(is_slow_lookup(self));
+    bool changed = self->engine->change_key(self->heap, (int64_t)old_val, (int64_t)new_val);
+    restore_gil(state);
+    unlock_heap(self);
+    if (!changed) {
+        PyErr_Format(PyExc_RuntimeError, "Failed to update key in %s (or old value not found).", self->engine->label);
+        return NULL;
+    }
+
+    Py_RETURN_NONE;
+}
+
+// meld(self, other)
+static PyObject *
+Heap_meld(HeapObject *self, PyObject *arg) {
+    if (!is_heap_object(find_module_state(Py_TYPE(self)), arg) || ((HeapObject *)arg)->engine != self->engine) {
+        PyErr_Format(PyExc_TypeError, "meld() argument must be a %s, not %.200s", self->engine->name, Py_TYPE(arg)->tp_name);
+        return NULL;
+    }
+    HeapObject *other = (HeapObject *)arg;
+    if (self->heap == NULL || other->heap == NULL) {
+        PyErr_SetString(PyExc_RuntimeError, "Heap not initialized.");
+        return NULL;
+    }
+    if (other == self) {
+        PyErr_Format(PyExc_ValueError, "Cannot meld a %s with itself.", self->engine->name);
+        return NULL;
+    }
+
+    // a. Get a fresh token for `other` first so nothing can fail after the elements moved
+    Heap_Owner *fresh_owner = new_heap_owner(other);
+    if (fresh_owner == NULL) {
+        return NULL;
+    }
+
+    // b. Lock both heaps, always in address order so two opposite melds cannot deadlock
+    HeapObject *first = (uintptr_t)self < (uintptr_t)other ? self : other;
+    HeapObject *second = first == self ? other : self;
+    lock_heap(first);
+    lock_heap(second);
+    Heap_Check check;
+    int status = self->engine->check_meld != NULL ? self->engine->check_meld(self->heap, other->heap, &check) : 0;
+    bool ok = status == 0 && self->engine->meld(self->heap, other->heap);
+    if (!ok) {
+        unlock_heap(second);
+        unlock_heap(first);
+        PyMem_Free(fresh_owner);
+        if (status != 0) {
+            self->engine->raise_check(status, &check);
+        } else {
+            PyErr_Format(PyExc_MemoryError, "Failed to meld %s objects.", self->engine->label);
+        }
+        return NULL;
+    }
+
+    // c. Forward other's token to ours: its handles now resolve to this heap
+    LOCK_OWNERS();
+    Heap_Owner *old_owner = other->owner;
+    old_owner->heap = NULL;
+    old_owner->forward = self->owner;
+    self->owner->refcount++;
+    decref_heap_owner(old_owner);
+    other->owner = fresh_owner;
+    self->handles += other->handles;
+    other->handles = 0;
+    UNLOCK_OWNERS();
+    unlock_heap(second);
+    unlock_heap(first);
+
+    Py_RETURN_NONE;
+}
+
+// __ior__
+static PyObject *
+Heap_inplace_or(PyObject *self, PyObject *other) {
+    Module_State *state = find_module_state(Py_TYPE(self));
+    if (!is_heap_object(state, self) || !is_heap_object(state, other)
+        || ((HeapObject *)self)->engine != ((HeapObject *)other)->engine) {
+        Py_RETURN_NOTIMPLEMENTED;
+    }
+    PyObject *result = Heap_meld((HeapObject *)self, other);
+    if (result == NULL) {
+        return NULL;
+    }
+    Py_DECREF(result);
+    Py_INCREF(self);
+    return self;
+}
+
+// __len__
+static Py_ssize_t
+Heap_len(HeapObject *self) {
+    if (self->heap == NULL) {
+        PyErr_SetString(PyExc_RuntimeError, "Heap not initialized.");
+        return -1; // Error indicator for sequence protocol
+    }
+    lock_heap(self);
+    size_t size = self->engine->size(self->heap);
+    unlock_heap(self);
+    return (Py_ssize_t)size;
+}
+
+// __contains__
+static int
+Heap_contains(HeapObject *self, PyObject *value) {
+    if (self->heap == NULL) {
+        PyErr_SetString(PyExc_RuntimeError, "Heap not initialized.");
+        return -1;
+    }
+    if (!PyLong_Check(value)) {
+        return 0; // Only ints can be keys
+    }
+    int overflow;
+    long long val = PyLong_AsLongLongAndOverflow(value, &overflow);
+    if (overflow != 0) {
+        return 0; // Outside the 64-bit key range, so it cannot be in the heap
+    }
+    if (val == -1 && PyErr_Occurred()) {
+        return -1;
+    }
+    lock_heap(self);
+    PyThreadState *state = release_gil_if(is_slow_lookup(self));
+    bool found = self->engine->contains(self->heap, (int64_t)val);
+    restore_gil(state);
+    unlock_heap(self);
+    return found;
+}
+
+
+// from_array(cls, keys, threads=None, **options)
+static PyObject *
+Heap_from_array(PyTypeObject *type, PyObject *args, PyObject *kwds) {
+    PyObject *arg;
+    if (!PyArg_ParseTuple(args, "O:from_array", &arg)) {
+        return NULL;
+    }
+
+    // a. `threads` is ours; every other keyword goes to the class itself, which makes the empty heap
+    PyObject *options = kwds != NULL ? PyDict_Copy(kwds) : PyDict_New();
+    if (options == NULL) {
+        return NULL;
+    }
+    PyObject *threads_arg = PyDict_GetItemString(options, "threads"); // Borrowed
+    Py_ssize_t threads = thread_count_arg(threads_arg != NULL ? threads_arg : Py_None);
+    if (threads == 0 || (threads_arg != NULL && PyDict_DelItemString(options, "threads") < 0)) {
+        Py_DECREF(options);
+        return NULL;
+    }
+    PyObject *no_args = PyTuple_New(0);
+    HeapObject *self = no_args != NULL ? (HeapObject *)PyObject_Call((PyObject *)type, no_args, options) : NULL;
+    Py_XDECREF(no_args);
+    Py_DECREF(options);
+    if (self == NULL) {
+        return NULL;
+    }
+    if (self->heap == NULL) {
+        Py_DECREF(self);
+        PyErr_SetString(PyExc_RuntimeError, "Heap not initialized.");
+        return NULL;
+    }
+
+    // b. Other engines take the keys in one insert_many; only FibHeap builds in parallel
+    if (self->engine != &fib_engine) {
+        PyObject *result = Heap_insert_many(self, arg);
+        if (result == NULL) {
+            Py_DECREF(self);
+            return NULL;
+        }
+        Py_DECREF(result);
+        return (PyObject *)self;
+    }
+    Key_Array keys;
+    if (!get_keys(arg, &keys)) {
+        Py_DECREF(self);
+        return NULL;
+    }
+
+    // c. Build the keys on 'threads' threads, then meld the result in. Without an index or
+    // a budget on the heap the meld is O(1); otherwise it adds a serial O(n) pass.
+    lock_heap(self);
+    PyThreadState *state = release_gil_if(keys.count >= GIL_RELEASE_THRESHOLD);
+    Fibonacci_Heap *built = build_parallel_fib_heap(keys.keys, (size_t)keys.count, (size_t)threads);
+    bool ok = built != NULL && meld_fib_heap((Fibonacci_Heap *)self->heap, built);
+    destroy_fib_heap(built);
+    restore_gil(state);
+    unlock_heap(self);
+    release_keys(&keys);
+    if (!ok) {
+        Py_DECREF(self);
+        PyErr_SetString(PyExc_MemoryError, "Failed to build the Fibonacci Heap.");
+        return NULL;
+    }
+    return (PyObject *)self;
+}
+
+// --- Method Definitions Table (shared by every heap class) ---
+static PyMethodDef Heap_methods[] = {
+    {"insert", (PyCFunction)Heap_insert, METH_VARARGS, "Insert a value into the heap and return a Handle to it."},
+    {"insert_many", (PyCFunction)Heap_insert_many, METH_O, "Insert every int of an iterable or integer buffer in one pass. No handles are returned."},
+    {"get_min", (PyCFunction)Heap_get_min, METH_NOARGS, "Get the minimum value from the heap."},
+    {"extract_min", (PyCFunction)Heap_extract_min, METH_NOARGS, "Extract the minimum value from the heap."},
+    {"pop_n", (PyCFunction)(void (*)(void))Heap_pop_n, METH_VARARGS | METH_KEYWORDS, "Extract the k smallest keys (fewer if the heap runs empty) into a new array('q'), or into the writable int64 buffer `out`, returning how many were written."},
+    {"extract_min_many", (PyCFunction)(void (*)(void))Heap_pop_n, METH_VARARGS | METH_KEYWORDS, "Alias of pop_n."},
+    {"delete", (PyCFunction)Heap_delete, METH_O, "Delete a value, or the element behind a Handle, from the heap."},
+    {"update_key", (PyCFunction)Heap_update_key, METH_VARARGS, "Update a key from old_value to new_value."},
+    {"decrease_key", (PyCFunction)Heap_decrease_key, METH_VARARGS, "Lower the key of the element behind a Handle."},
+    {"meld", (PyCFunction)Heap_meld, METH_O, "Move every element of another heap of the same class into this one, leaving it empty. Its handles follow the elements."},
+    {"from_array", (PyCFunction)(void (*)(void))Heap_from_array, METH_VARARGS | METH_KEYWORDS | METH_CLASS, "Build a heap from an iterable or integer buffer of keys; other keywords go to the constructor. FibHeap splits the build over `threads` threads (default: one per CPU); the other classes ignore it."},
+    {NULL}  /* Sentinel */
+};
+
+// --- Type Definitions ---
+// Every heap class has the same slots apart from its constructor and docstring. __len__ and
+// __contains__ are the sequence slots; |= melds.
+static PyType_Slot FibHeap_slots[] = {
+    {Py_tp_doc, "Fibonacci Heap object. FibHeap(index=True, consolidate_budget=0): the key index makes lookups "
+                "by value O(1); a consolidate_budget > 0 bounds every pop to O(budget + log n) work."},
+    {Py_tp_new, FibHeap_new},
+    {Py_tp_dealloc, Heap_dealloc},
+    {Py_tp_repr, Heap_repr},
+    {Py_tp_methods, Heap_methods},
+    {Py_sq_length, Heap_len},
+    {Py_sq_contains, Heap_contains},
+    {Py_nb_inplace_or, Heap_inplace_or},
+    {0, NULL}
+};
+
+static PyType_Spec FibHeap_spec = {
+    .name = "fibheap.FibHeap",
+    .basicsize = sizeof(HeapObject),
+    .itemsize = 0,
+    .flags = Py_TPFLAGS_DEFAULT | Py_TPFLAGS_BASETYPE,
+    .slots = FibHeap_slots,
+};
+
+static PyType_Slot DaryHeap_slots[] = {
+    {Py_tp_doc, "Implicit d-ary array heap with FibHeap's interface. DaryHeap(arity=4): "
+                "faster than FibHeap when decrease_key is rare; lookups by value scan the array."},
+    {Py_tp_new, DaryHeap_new},
+    {Py_tp_dealloc, Heap_dealloc},
+    {Py_tp_repr, Heap_repr},
+    {Py_tp_methods, Heap_methods},
+    {Py_sq_length, Heap_len},
+    {Py_sq_contains, Heap_contains},
+    {Py_nb_inplace_or, Heap_inplace_or},
+    {0, NULL}
+};
+
+static PyType_Spec DaryHeap_spec = {
+    .name = "fibheap.DaryHeap",
+    .basicsize = sizeof(HeapObject),
+    .itemsize = 0,
+    .flags = Py_TPFLAGS_DEFAULT | Py_TPFLAGS_BASETYPE,
+    .slots = DaryHeap_slots,
+};
+
+static PyType_Slot PairingHeap_slots[] = {
+    {Py_tp_doc, "Pairing heap with two-pass merging and FibHeap's interface. O(1) insert and meld; "
+                "lookups by value walk the trees."},
+    {Py_tp_new, PairingHeap_new},
+    {Py_tp_dealloc, Heap_dealloc},
+    {Py_tp_repr, Heap_repr},
+    {Py_tp_methods, Heap_methods},
+    {Py_sq_length, Heap_len},
+    {Py_sq_contains, Heap_contains},
+    {Py_nb_inplace_or, Heap_inplace_or},
+    {0, NULL}
+};
+
+static PyType_Spec PairingHeap_spec = {
+    .name = "fibheap.PairingHeap",
+    .basicsize = sizeof(HeapObject),
+    .itemsize = 0,
+    .flags = Py_TPFLAGS_DEFAULT | Py_TPFLAGS_BASETYPE,
+    .slots = PairingHeap_slots,
+};
+
+static PyType_Slot RadixHeap_slots[] = {
+    {Py_tp_doc, "Monotone radix heap with FibHeap's interface. RadixHeap(key_bits=64): keys are "
+                "non-negative (below 2**32 with key_bits=32) and never below the last extracted "
+                "minimum; other keys raise ValueError."},
+    {Py_tp_new, RadixHeap_new},
+    {Py_tp_dealloc, Heap_dealloc},
+    {Py_tp_repr, Heap_repr},
+    {Py_tp_methods, Heap_methods},
+    {Py_sq_length, Heap_len},
+    {Py_sq_contains, Heap_contains},
+    {Py_nb_inplace_or, Heap_inplace_or},
+    {0, NULL}
+};
+
+static PyType_Spec RadixHeap_spec = {
+    .name = "fibheap.RadixHeap",
+    .basicsize = sizeof(HeapObject),
+    .itemsize = 0,
+    .flags = Py_TPFLAGS_DEFAULT | Py_TPFLAGS_BASETYPE,
+    .slots = RadixHeap_slots,
+};
+
+static PyType_Slot BucketQueue_slots[] = {
+    {Py_tp_doc, "Bucket queue for a small key range, with FibHeap's interface. "
+                "BucketQueue(range, min_key=0, circular=False): keys lie in min_key .. min_key+range-1, "
+                "or with circular=True (Dial's algorithm) in last .. last+range-1, where last is the "
+                "last extracted minimum. Other keys raise ValueError."},
+    {Py_tp_new, BucketQueue_new},
+    {Py_tp_dealloc, Heap_dealloc},
+    {Py_tp_repr, Heap_repr},
+    {Py_tp_methods, Heap_methods},
+    {Py_sq_length, Heap_len},
+    {Py_sq_contains, Heap_contains},
+    {Py_nb_inplace_or, Heap_inplace_or},
+    {0, NULL}
+};
+
+static PyType_Spec BucketQueue_spec = {
+    .name = "fibheap.BucketQueue",
+    .basicsize = sizeof(HeapObject),
+    .itemsize = 0,
+    .flags = Py_TPFLAGS_DEFAULT | Py_TPFLAGS_BASETYPE,
+    .slots = BucketQueue_slots,
+};
+
+// In the order of Module_State.heap_types
+static PyType_Spec *const heap_type_specs[HEAP_TYPE_COUNT] = {
+    &FibHeap_spec, &DaryHeap_spec, &PairingHeap_spec, &RadixHeap_spec, &BucketQueue_spec,
+};
+
+// --- MultiQueue ---
+// A relaxed concurrent queue of keys (multi_queue.h). It has no handles and no lock of its
+// own: the C queue is safe to share, so threads only contend on its shards.
 typedef struct {
     PyObject_HEAD
-    Fibonacci_Heap *fh;
-    // We might add a PyObject* to a comparison function here if needed later
-} FibHeapObject;
+    Multi_Queue *mq;
+} MultiQueueObject;
 
-// --- Forward declaration of the type object ---
-static PyTypeObject FibHeapType;
+// MultiQueue.__new__(threads=None, factor=2)
+static PyObject *
+MultiQueue_new(PyTypeObject *type, PyObject *args, PyObject *kwds) {
+    static char *kwlist[] = {"threads", "factor", NULL};
+    PyObject *threads_arg = Py_None;
+    Py_ssize_t factor = 2;
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "|On", kwlist, &threads_arg, &factor)) {
+        return NULL;
+    }
 
-// --- Methods for the FibHeapObject ---
+    Py_ssize_t threads = thread_count_arg(threads_arg);
+    if (threads == 0) {
+        return NULL;
+    }
+    if (factor < 1) {
+        PyErr_SetString(PyExc_ValueError, "factor must be at least 1.");
+        return NULL;
+    }
 
-// __new__ or __init__
-static PyObject *
-FibHeap_new(PyTypeObject *type, PyObject *args, PyObject *kwds) {
-    FibHeapObject *self;
-    self = (FibHeapObject *)type->tp_alloc(type, 0);
-    if (self != NULL) {
-        self->fh = create_fib_heap();
-        if (self->fh == NULL) {
-            Py_DECREF(self);
-            PyErr_SetString(PyExc_MemoryError, "Failed to create Fibonacci Heap.");
-            return NULL;
-        }
-        // If create_fib_heap took a comparator:
-        // self->fh->compare = compare_int_keys; // Or however it's set
+    MultiQueueObject *self = (MultiQueueObject *)type->tp_alloc(type, 0);
+    if (self == NULL) {
+        return NULL;
+    }
+    self->mq = create_multi_queue((size_t)threads, (size_t)factor);
+    if (self->mq == NULL) {
+        Py_DECREF(self);
+        PyErr_SetString(PyExc_MemoryError, "Failed to create MultiQueue.");
+        return NULL;
     }
     return (PyObject *)self;
 }
 
-// __dealloc__
 static void
-FibHeap_dealloc(FibHeapObject *self) {
-    if (self->fh != NULL) {
-        // IMPORTANT: This is a placeholder for proper cleanup.
-        // We need a function in fibonacci_heap.c, e.g., destroy_fib_heap(fh),
-        // that iterates through all nodes, frees their keys (the int* we allocated),
-        // and then frees the heap structure.
-        // For now, we'll just free the heap structure itself, which is a memory leak
-        // for the keys. This will be addressed in step 2 of the main plan.
-        
-        // Conceptual cleanup (actual implementation depends on fibonacci_heap.c):
-        // Fibonacci_Node *current_node = self->fh->min; // Or some way to iterate root list
-        // if (current_node != NULL) {
-        //     // ... iterate and free all node->key contents ...
-        // }
-        // free(self->fh); // This only frees the heap struct, not its contents.
-        
-        // We will need a proper `destroy_fib_heap` function.
-        // destroy_fib_heap(self->fh); // This is the target
-        
-        // TEMPORARY: just free the main struct.
-        // This will be updated once destroy_fib_heap is available.
-        // To avoid compilation errors for now if destroy_fib_heap doesn't exist.
-        // In fibonacci_heap.c, we'd expect something like:
-        // void destroy_fib_heap(Fibonacci_Heap* heap) {
-        //    if (!heap) return;
-        //    while (heap->n > 0) {
-        //        void* key = extract_min_fib_heap(heap); // Assuming extract_min returns key
-        //        if (key) free(key); // Free the int*
-        //    }
-        //    free(heap);
-        // }
-        // For now, if extract_min is not destructive of keys, or if we don't have it,
-        // we can't properly clean. This is a major point for the next step.
-        // Let's assume for now that `fibonacci_heap.c` will be updated with a
-        // function that handles freeing internal keys.
-        // If `extract_min_fib_heap` frees the node but returns the key, we can do:
-        if (self->fh->n > 0) {
-             // This is a temporary, inefficient way to clear if extract_min returns key
-             // AND if the heap doesn't manage key memory internally on delete/extract.
-             // A dedicated destroy function in the C library is better.
-             // This loop is problematic if extract_min_fib_heap itself doesn't free the key's container node
-             // or if it modifies the heap structure in a way that makes repeated calls unsafe without re-linking.
-             // For now, we'll assume such a `destroy_fib_heap` will be made available.
-             // So, this dealloc will be simplified assuming that function will be called.
-        }
-        // Placeholder for calling the actual destroy function from the C library
-        // destroy_fib_heap(self->fh); 
-        // If no such function, then at least free the heap struct itself.
-        free(self->fh); // This is insufficient for keys, but prevents FibHeap struct leak.
-        self->fh = NULL;
-    }
-    Py_TYPE(self)->tp_free((PyObject *)self);
+MultiQueue_dealloc(MultiQueueObject *self) {
+    if (self->mq != NULL) {
+        // Only keys are stored, so nothing in the queue needs the GIL
+        PyThreadState *state = release_gil_if(size_multi_queue(self->mq) >= GIL_RELEASE_THRESHOLD);
+        destroy_multi_queue(self->mq);
+        restore_gil(state);
+        self->mq = NULL;
+    }
+    PyTypeObject *type = Py_TYPE(self);
+    type->tp_free((PyObject *)self);
+    Py_DECREF(type);
 }
 
-// __repr__
 static PyObject *
-FibHeap_repr(FibHeapObject *self) {
-    if (self->fh == NULL) {
-        return PyUnicode_FromString("<FibHeap object (uninitialized)>");
+MultiQueue_repr(MultiQueueObject *self) {
+    return PyUnicode_FromFormat("<MultiQueue object at %p, size %zu, %zu shards>", (void *)self,
+                                size_multi_queue(self->mq), self->mq->count);
+}
+
+// insert(self, key)
+static PyObject *
+MultiQueue_insert(MultiQueueObject *self, PyObject *args) {
+    long long val;
+    if (!PyArg_ParseTuple(args, "L", &val)) {
+        return NULL;
     }
-    // In a real scenario, you might want to show more info, like size or min element
-    return PyUnicode_FromFormat("<FibHeap object at %p, size %d>", (void *)self, self->fh->n);
+    if (!insert_multi_queue(self->mq, (int64_t)val, NULL)) {
+        PyErr_SetString(PyExc_MemoryError, "Failed to insert into MultiQueue.");
+        return NULL;
+    }
+    Py_RETURN_NONE;
 }
 
-// --- Python Methods for FibHeap ---
+// insert_many(self, iterable)
+static PyObject *
+MultiQueue_insert_many(MultiQueueObject *self, PyObject *arg) {
+    Key_Array keys;
+    if (!get_keys(arg, &keys)) {
+        return NULL;
+    }
+
+    PyThreadState *state = release_gil_if(keys.count >= GIL_RELEASE_THRESHOLD);
+    bool ok = insert_many_multi_queue(self->mq, keys.keys, (size_t)keys.count);
+    restore_gil(state);
+    release_keys(&keys);
+    if (!ok) {
+        PyErr_SetString(PyExc_MemoryError, "Failed to insert into MultiQueue.");
+        return NULL;
+    }
+    Py_RETURN_NONE;
+}
 
-// insert(self, value)
+// extract_min(self)
 static PyObject *
-FibHeap_insert(FibHeapObject *self, PyObject *args) {
-    long val;
-    if (!PyArg_ParseTuple(args, "l", &val)) {
-        return NULL; // Error already set by PyArg_ParseTuple
+MultiQueue_extract_min(MultiQueueObject *self, PyObject *Py_UNUSED(ignored)) {
+    int64_t key;
+    if (!extract_min_multi_queue(self->mq, &key, NULL)) {
+        Py_RETURN_NONE;
     }
+    return PyLong_FromLongLong(key);
+}
 
-    if (self->fh == NULL) {
-        PyErr_SetString(PyExc_RuntimeError, "Heap not initialized.");
+// pop_n(self, k)
+static PyObject *
+MultiQueue_pop_n(MultiQueueObject *self, PyObject *args) {
+    Py_ssize_t k;
+    if (!PyArg_ParseTuple(args, "n", &k)) {
+        return NULL;
+    }
+    if (k < 0) {
+        PyErr_SetString(PyExc_ValueError, "k must not be negative.");
         return NULL;
     }
 
-    // Allocate memory for the integer key, as the C heap stores void*
-    int *key_ptr = (int *)malloc(sizeof(int));
-    if (key_ptr == NULL) {
+    // a. Other threads may add or take elements meanwhile, so the buffer is sized for what is
+    // there now and the array built from what actually came out
+    size_t size = size_multi_queue(self->mq);
+    size_t count = (size_t)k < size ? (size_t)k : size;
+    PyObject *array_module = PyImport_ImportModule("array");
+    if (array_module == NULL) {
+        return NULL;
+    }
+    int64_t *keys = PyMem_New(int64_t, count > 0 ? count : 1);
+    if (keys == NULL) {
+        Py_DECREF(array_module);
         return PyErr_NoMemory();
     }
-    *key_ptr = (int)val; // Cast long to int; consider error checking for overflow if Python long > C int max
+    PyThreadState *state = release_gil_if(count >= GIL_RELEASE_THRESHOLD);
+    size_t written = extract_min_many_multi_queue(self->mq, keys, NULL, count);
+    restore_gil(state);
+
+    // b. Wrap the keys in an array('q')
+    PyObject *result = NULL;
+    PyObject *bytes = PyBytes_FromStringAndSize((const char *)keys, (Py_ssize_t)(written * sizeof(int64_t)));
+    PyMem_Free(keys);
+    if (bytes != NULL) {
+        result = PyObject_CallMethod(array_module, "array", "sO", "q", bytes);
+        Py_DECREF(bytes);
+    }
+    Py_DECREF(array_module);
+    return result;
+}
+
+// __len__
+static Py_ssize_t
+MultiQueue_len(MultiQueueObject *self) {
+    return (Py_ssize_t)size_multi_queue(self->mq);
+}
+
+static PyMethodDef MultiQueue_methods[] = {
+    {"insert", (PyCFunction)MultiQueue_insert, METH_VARARGS, "Insert a key into a random shard."},
+    {"insert_many", (PyCFunction)MultiQueue_insert_many, METH_O, "Insert every int of an iterable or integer buffer, in batches spread over the shards."},
+    {"extract_min", (PyCFunction)MultiQueue_extract_min, METH_NOARGS, "Remove and return one of the smallest keys, or None if the queue is empty."},
+    {"pop_n", (PyCFunction)MultiQueue_pop_n, METH_VARARGS, "Remove up to k keys with extract_min into a new array('q')."},
+    {NULL}  /* Sentinel */
+};
+
+static PyType_Slot MultiQueue_slots[] = {
+    {Py_tp_doc, "Relaxed concurrent priority queue of int keys: threads*factor Fibonacci heaps, each "
+                "behind a try-lock. MultiQueue(threads=None, factor=2), threads defaulting to "
+                "os.cpu_count(). extract_min returns one of the smallest keys: the rank error is "
+                "O(threads*factor) in expectation. Safe to share between threads; no handles."},
+    {Py_tp_new, MultiQueue_new},
+    {Py_tp_dealloc, MultiQueue_dealloc},
+    {Py_tp_repr, MultiQueue_repr},
+    {Py_tp_methods, MultiQueue_methods},
+    {Py_sq_length, MultiQueue_len},
+    {0, NULL}
+};
+
+static PyType_Spec MultiQueue_spec = {
+    .name = "fibheap.MultiQueue",
+    .basicsize = sizeof(MultiQueueObject),
+    .itemsize = 0,
+    .flags = Py_TPFLAGS_DEFAULT,
+    .slots = MultiQueue_slots,
+};
+
+// --- TopK ---
+// A bounded selector of the k largest or smallest keys of a stream (heap_select.h). Its
+// memory is O(k): insert_many reads chunks in place, or converts them a block at a time on
+// the stack, so rejecting a candidate never allocates.
+typedef struct {
+    PyObject_HEAD
+    Heap_Select *select;
+    PyThread_type_lock lock;
+} TopKObject;
 
-    if (!insert_fib_heap(self->fh, key_ptr)) {
-        free(key_ptr); // Free if insertion failed
-        PyErr_SetString(PyExc_RuntimeError, "Failed to insert into Fibonacci Heap.");
+// Keys converted at a time by TopK.insert_many when a chunk is not int64 already
+#define TOP_K_BLOCK 256
+
+// TopK.__new__(k, largest=True)
+static PyObject *
+TopK_new(PyTypeObject *type, PyObject *args, PyObject *kwds) {
+    static char *kwlist[] = {"k", "largest", NULL};
+    Py_ssize_t k;
+    int largest = 1;
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "n|p", kwlist, &k, &largest)) {
+        return NULL;
+    }
+    if (k < 1) {
+        PyErr_SetString(PyExc_ValueError, "k must be at least 1.");
         return NULL;
     }
+    TopKObject *self = (TopKObject *)type->tp_alloc(type, 0);
+    if (self == NULL) {
+        return NULL;
+    }
+    self->lock = PyThread_allocate_lock();
+    self->select = self->lock != NULL ? create_heap_select((size_t)k, largest != 0) : NULL;
+    if (self->select == NULL) {
+        Py_DECREF(self);
+        return PyErr_NoMemory();
+    }
+    return (PyObject *)self;
+}
 
-    Py_RETURN_NONE;
+static void
+TopK_dealloc(TopKObject *self) {
+    destroy_heap_select(self->select); // Keys only: nothing to release
+    if (self->lock != NULL) {
+        PyThread_free_lock(self->lock);
+    }
+    PyTypeObject *type = Py_TYPE(self);
+    type->tp_free((PyObject *)self);
+    Py_DECREF(type);
 }
 
-// get_min(self)
 static PyObject *
-FibHeap_get_min(FibHeapObject *self, PyObject *Py_UNUSED(ignored)) {
-    if (self->fh == NULL) {
-        PyErr_SetString(PyExc_RuntimeError, "Heap not initialized.");
+TopK_repr(TopKObject *self) {
+    acquire_lock(self->lock);
+    size_t n = self->select->n;
+    PyThread_release_lock(self->lock);
+    return PyUnicode_FromFormat("<TopK object at %p, %s %zu, size %zu>", (void *)self,
+                                self->select->largest ? "largest" : "smallest", self->select->k, n);
+}
+
+// insert(self, key)
+static PyObject *
+TopK_insert(TopKObject *self, PyObject *args) {
+    long long key;
+    if (!PyArg_ParseTuple(args, "L", &key)) {
         return NULL;
     }
+    acquire_lock(self->lock);
+    bool kept = insert_heap_select(self->select, (int64_t)key, NULL);
+    PyThread_release_lock(self->lock);
+    return PyBool_FromLong(kept);
+}
 
-    if (self->fh->n == 0) { // Or check self->fh->min == NULL
-        Py_RETURN_NONE; // Standard Python way to indicate "empty" or "not found" for get operations
+// Helper for insert_many on a buffer: offers every key, converting blocks on the stack unless
+// they are native int64 already. Returns -1 with an exception set on bad formats or keys.
+static Py_ssize_t
+insert_buffer_top_k(TopKObject *self, PyObject *arg) {
+    Py_buffer view;
+    if (PyObject_GetBuffer(arg, &view, PyBUF_C_CONTIGUOUS | PyBUF_FORMAT) < 0) {
+        return -1;
+    }
+    char code = native_int_format(view.format, view.itemsize);
+    if (code == 0) {
+        PyErr_Format(PyExc_TypeError, "expected a buffer of integers, got format '%s'", view.format);
+        PyBuffer_Release(&view);
+        return -1;
+    }
+    size_t count = view.itemsize > 0 ? (size_t)(view.len / view.itemsize) : 0;
+    size_t kept = 0;
+    bool ok = true;
+    acquire_lock(self->lock);
+    PyThreadState *state = release_gil_if(count >= GIL_RELEASE_THRESHOLD);
+    if (view.itemsize == sizeof(Fibonacci_Key) && strchr("qln", code) != NULL) {
+        kept = insert_many_heap_select(self->select, (const int64_t *)view.buf, count);
+    } else {
+        int64_t block[TOP_K_BLOCK];
+        const char *item = (const char *)view.buf;
+        for (size_t start = 0; ok && start < count; start += TOP_K_BLOCK) {
+            size_t len = count - start < TOP_K_BLOCK ? count - start : TOP_K_BLOCK;
+            for (size_t i = 0; ok && i < len; i++, item += view.itemsize) {
+                ok = key_from_item(code, view.itemsize, item, &block[i]);
+            }
+            if (ok) {
+                kept += insert_many_heap_select(self->select, block, len);
+            }
+        }
     }
+    restore_gil(state);
+    PyThread_release_lock(self->lock);
+    PyBuffer_Release(&view);
+    if (!ok) {
+        PyErr_SetString(PyExc_OverflowError, "key does not fit in a signed 64-bit integer");
+        return -1;
+    }
+    return (Py_ssize_t)kept;
+}
 
-    void *min_key_ptr = get_min(self->fh);
-    if (min_key_ptr == NULL) { // Should be redundant if n > 0 check is done
-        Py_RETURN_NONE;
+// Helper for insert_many on an iterable: collects a block of keys, then offers it with the
+// lock held. The iterator runs without the lock, so it may use this TopK itself.
+static Py_ssize_t
+insert_iterable_top_k(TopKObject *self, PyObject *arg) {
+    PyObject *iterator = PyObject_GetIter(arg);
+    if (iterator == NULL) {
+        return -1;
     }
+    int64_t block[TOP_K_BLOCK];
+    size_t kept = 0, len = 0;
+    bool done = false;
+    while (!done) {
+        PyObject *item = PyIter_Next(iterator);
+        if (item != NULL) {
+            long long value = PyLong_AsLongLong(item);
+            Py_DECREF(item);
+            if (value == -1 && PyErr_Occurred()) {
+                break;
+            }
+            block[len++] = (int64_t)value;
+        } else {
+            done = true;
+        }
+        if (len == TOP_K_BLOCK || (done && len > 0)) {
+            acquire_lock(self->lock);
+            kept += insert_many_heap_select(self->select, block, len);
+            PyThread_release_lock(self->lock);
+            len = 0;
+        }
+    }
+    Py_DECREF(iterator);
+    return PyErr_Occurred() ? -1 : (Py_ssize_t)kept;
+}
 
-    return PyLong_FromLong(*(int *)min_key_ptr);
+// insert_many(self, keys)
+static PyObject *
+TopK_insert_many(TopKObject *self, PyObject *arg) {
+    Py_ssize_t kept = PyObject_CheckBuffer(arg) ? insert_buffer_top_k(self, arg) : insert_iterable_top_k(self, arg);
+    return kept < 0 ? NULL : PyLong_FromSsize_t(kept);
 }
 
-// extract_min(self)
+// result(self)
 static PyObject *
-FibHeap_extract_min(FibHeapObject *self, PyObject *Py_UNUSED(ignored)) {
-    if (self->fh == NULL) {
-        PyErr_SetString(PyExc_RuntimeError, "Heap not initialized.");
+TopK_result(TopKObject *self, PyObject *Py_UNUSED(ignored)) {
+    // The selector may grow until the lock is taken, so the array is sized for k
+    Py_buffer view;
+    PyObject *result = new_int64_array((Py_ssize_t)self->select->k, &view);
+    if (result == NULL) {
         return NULL;
     }
+    acquire_lock(self->lock);
+    size_t n = sorted_heap_select(self->select, (int64_t *)view.buf, NULL);
+    PyThread_release_lock(self->lock);
+    PyBuffer_Release(&view);
+    if (n < self->select->k) {
+        PyObject *resized = PySequence_GetSlice(result, 0, (Py_ssize_t)n);
+        Py_SETREF(result, resized);
+    }
+    return result;
+}
+
+// clear(self)
+static PyObject *
+TopK_clear(TopKObject *self, PyObject *Py_UNUSED(ignored)) {
+    acquire_lock(self->lock);
+    clear_heap_select(self->select);
+    PyThread_release_lock(self->lock);
+    Py_RETURN_NONE;
+}
 
-    if (self->fh->n == 0) { // Or check self->fh->min == NULL
+static PyObject *
+TopK_get_threshold(TopKObject *self, void *Py_UNUSED(closure)) {
+    int64_t key;
+    acquire_lock(self->lock);
+    bool full = get_threshold_heap_select(self->select, &key);
+    PyThread_release_lock(self->lock);
+    if (!full) {
         Py_RETURN_NONE;
     }
+    return PyLong_FromLongLong(key);
+}
 
-    void *extracted_key_ptr = extract_min_fib_heap(self->fh);
-    if (extracted_key_ptr == NULL) {
-        // This case should ideally not happen if n > 0,
-        // but good to handle if extract_min can return NULL for other reasons.
-        PyErr_SetString(PyExc_RuntimeError, "extract_min_fib_heap returned NULL unexpectedly.");
-        return NULL;
+static PyObject *
+TopK_get_k(TopKObject *self, void *Py_UNUSED(closure)) {
+    return PyLong_FromSize_t(self->select->k);
+}
+
+static PyObject *
+TopK_get_largest(TopKObject *self, void *Py_UNUSED(closure)) {
+    return PyBool_FromLong(self->select->largest);
+}
+
+// __len__
+static Py_ssize_t
+TopK_len(TopKObject *self) {
+    acquire_lock(self->lock);
+    size_t n = self->select->n;
+    PyThread_release_lock(self->lock);
+    return (Py_ssize_t)n;
+}
+
+static PyMethodDef TopK_methods[] = {
+    {"insert", (PyCFunction)TopK_insert, METH_VARARGS, "Offer a key; return True if it is kept (evicting the worst key once k are kept)."},
+    {"insert_many", (PyCFunction)TopK_insert_many, METH_O, "Offer every int of an iterable or integer buffer, read in place or a block at a time; return how many were kept."},
+    {"result", (PyCFunction)TopK_result, METH_NOARGS, "The kept keys, best first, as a new array('q'). The selector is left as it is."},
+    {"clear", (PyCFunction)TopK_clear, METH_NOARGS, "Drop every kept key."},
+    {NULL}  /* Sentinel */
+};
+
+static PyGetSetDef TopK_getset[] = {
+    {"threshold", (getter)TopK_get_threshold, NULL, "The k-th best key, which a candidate has to beat, or None while fewer than k are kept.", NULL},
+    {"k", (getter)TopK_get_k, NULL, "Number of keys kept at most.", NULL},
+    {"largest", (getter)TopK_get_largest, NULL, "True if the largest keys are kept, False for the smallest.", NULL},
+    {NULL}  /* Sentinel */
+};
+
+static PyType_Slot TopK_slots[] = {
+    {Py_tp_doc, "Streaming selector of the k largest (or, with largest=False, smallest) int keys. "
+                "TopK(k, largest=True) holds at most k keys in O(k) memory; a key no better than "
+                "the current k-th best is rejected with one comparison, a better one replaces it "
+                "in O(log k). Ties with the k-th best are rejected. Safe to share between threads."},
+    {Py_tp_new, TopK_new},
+    {Py_tp_dealloc, TopK_dealloc},
+    {Py_tp_repr, TopK_repr},
+    {Py_tp_methods, TopK_methods},
+    {Py_tp_getset, TopK_getset},
+    {Py_sq_length, TopK_len},
+    {0, NULL}
+};
+
+static PyType_Spec TopK_spec = {
+    .name = "fibheap.TopK",
+    .basicsize = sizeof(TopKObject),
+    .itemsize = 0,
+    .flags = Py_TPFLAGS_DEFAULT,
+    .slots = TopK_slots,
+};
+
+// --- Graph algorithms (fibonacci_graph.h) ---
+
+// The three arrays of a CSR graph, each read like the keys of insert_many
+typedef struct {
+    Key_Array offsets;
+    Key_Array targets;
+    Key_Array weights;
+    Fib_Csr_Graph graph;
+} Graph_Arrays;
+
+static void
+release_graph(Graph_Arrays *arrays) {
+    release_keys(&arrays->offsets);
+    release_keys(&arrays->targets);
+    release_keys(&arrays->weights);
+}
+
+// Fills 'out' from the offsets, targets and weights arguments and checks that they form a
+// graph (with non-negative weights unless 'negative_weights'). Returns false with an
+// exception set on failure.
+static bool
+get_graph(PyObject *offsets, PyObject *targets, PyObject *weights, bool negative_weights, Graph_Arrays *out) {
+    if (!get_keys(offsets, &out->offsets)) {
+        return false;
+    }
+    if (!get_keys(targets, &out->targets)) {
+        release_keys(&out->offsets);
+        return false;
+    }
+    if (!get_keys(weights, &out->weights)) {
+        release_keys(&out->offsets);
+        release_keys(&out->targets);
+        return false;
     }
+    const char *error = NULL;
+    if (out->offsets.count == 0) {
+        error = "offsets must have n + 1 entries for a graph of n vertices.";
+    } else if (out->targets.count != out->weights.count) {
+        error = "targets and weights must have the same length.";
+    } else {
+        out->graph.n = (size_t)out->offsets.count - 1;
+        out->graph.m = (size_t)out->targets.count;
+        out->graph.offsets = out->offsets.keys;
+        out->graph.targets = out->targets.keys;
+        out->graph.weights = out->weights.keys;
+        PyThreadState *state = release_gil_if(out->graph.n + out->graph.m >= GIL_RELEASE_THRESHOLD);
+        bool valid = check_csr_graph(&out->graph, negative_weights);
+        restore_gil(state);
+        if (!valid) {
+            error = negative_weights
+                    ? "Invalid graph: offsets must rise from 0 to len(targets) and targets must be vertices."
+                    : "Invalid graph: offsets must rise from 0 to len(targets), targets must be "
+                      "vertices and weights must not be negative.";
+        }
+    }
+    if (error != NULL) {
+        PyErr_SetString(PyExc_ValueError, error);
+        release_graph(out);
+        return false;
+    }
+    return true;
+}
 
-    long val = *(int *)extracted_key_ptr;
-    free(extracted_key_ptr); // CRITICAL: Free the int* that was allocated in insert
+// Reads a vertex argument into *vertex_out. Returns false with an exception set if it is not
+// a vertex of a graph of n vertices; 'what' names the vertices in the message.
+static bool
+vertex_arg(PyObject *arg, size_t n, const char *what, size_t *vertex_out) {
+    Py_ssize_t vertex = PyLong_AsSsize_t(arg);
+    if (vertex == -1 && PyErr_Occurred()) {
+        return false;
+    }
+    if (vertex < 0 || (size_t)vertex >= n) {
+        PyErr_Format(PyExc_ValueError, "%s %zd is not in the graph (0 <= v < %zu).", what, vertex, n);
+        return false;
+    }
+    *vertex_out = (size_t)vertex;
+    return true;
+}
 
-    return PyLong_FromLong(val);
+// Creates the two per-vertex arrays('q') a graph algorithm returns, with their buffers
+// exported into views[0..1]. Returns false with an exception set on failure.
+static bool
+new_vertex_arrays(size_t n, PyObject *arrays[2], Py_buffer views[2]) {
+    arrays[0] = new_int64_array((Py_ssize_t)n, &views[0]);
+    arrays[1] = arrays[0] != NULL ? new_int64_array((Py_ssize_t)n, &views[1]) : NULL;
+    if (arrays[1] == NULL && arrays[0] != NULL) {
+        PyBuffer_Release(&views[0]);
+        Py_CLEAR(arrays[0]);
+    }
+    return arrays[1] != NULL;
 }
 
-// delete(self, value)
+// Releases the views of new_vertex_arrays and returns the arrays as a tuple, or sets
+// MemoryError and drops them if the algorithm failed.
 static PyObject *
-FibHeap_delete(FibHeapObject *self, PyObject *args) {
-    long val;
-    if (!PyArg_ParseTuple(args, "l", &val)) {
-        return NULL;
+finish_vertex_arrays(bool ok, PyObject *arrays[2], Py_buffer views[2]) {
+    PyBuffer_Release(&views[0]);
+    PyBuffer_Release(&views[1]);
+    if (!ok) {
+        Py_DECREF(arrays[0]);
+        Py_DECREF(arrays[1]);
+        return PyErr_NoMemory();
     }
+    return Py_BuildValue("(NN)", arrays[0], arrays[1]);
+}
 
-    if (self->fh == NULL) {
-        PyErr_SetString(PyExc_RuntimeError, "Heap not initialized.");
+// dijkstra(offsets, targets, weights, source, target=None, radius=None)
+static PyObject *
+fibheap_dijkstra(PyObject *Py_UNUSED(module), PyObject *args, PyObject *kwds) {
+    static char *kwlist[] = {"offsets", "targets", "weights", "source", "target", "radius", NULL};
+    PyObject *offsets, *targets, *weights, *source_arg, *target_arg = Py_None, *radius_arg = Py_None;
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "OOOO|OO", kwlist, &offsets, &targets, &weights,
+                                     &source_arg, &target_arg, &radius_arg)) {
         return NULL;
     }
+    long long radius = FIB_GRAPH_NO_RADIUS;
+    if (radius_arg != Py_None) {
+        radius = PyLong_AsLongLong(radius_arg);
+        if (radius == -1 && PyErr_Occurred()) {
+            return NULL;
+        }
+        if (radius < 0) {
+            PyErr_SetString(PyExc_ValueError, "radius must not be negative.");
+            return NULL;
+        }
+    }
 
-    // Note: delete_fib_node expects a void* that matches the stored key's value.
-    // It does NOT take a pointer to a value to search for, but rather, the value itself
-    // cast to void*. However, our heap stores int*s.
-    // This means delete_fib_node must be able to find the int* whose *value* is `val`,
-    // and then free that specific `int*`.
-    // The current `delete_fib_node(fh, data)` signature in fibonacci_heap.h suggests it expects `data`
-    // to be the actual pointer stored. This is a mismatch if we pass `(void*)&val`.
-    // We need `delete_fib_node` to search for a node where `*(int*)node->key == val`.
-    // For now, we will assume `delete_fib_node` in `fibonacci_heap.c` is adapted or
-    // a new function is created that can search by value and free the internal key pointer.
-    // This is a point to address in Step 2 (Modify fibonacci_heap.c).
-    // Let's call it with a temporary int pointer for now, assuming the C func will handle it.
-    // This is a placeholder for what `delete_fib_node` needs to achieve.
-    // A proper implementation would require `delete_fib_node` to:
-    // 1. Find the node N such that *(int*)(N->key) == val.
-    // 2. If found, free N->key.
-    // 3. Proceed with deleting N from the heap.
-    
-    // Create a temporary int with the value to facilitate search by value (conceptual)
-    // This specific pointer `temp_key_for_search_val` is NOT what's stored.
-    // The function `delete_fib_node` must understand this.
-    // A better API for `delete_fib_node` might be `delete_fib_node_by_value(fh, int value_to_delete)`.
-    // Assuming `delete_fib_node` can handle finding the actual `int*` key based on the value.
-    // This is a major assumption for this step.
-    
-    // For the wrapper, we pass the value. The C function `delete_fib_node`
-    // will need to iterate, find the node whose `*(int*)key == value`, then free that key and node.
-    // The `void* data` parameter in `delete_fib_node(fh, data)` must be interpreted carefully.
-    // If it's meant to be the *value* to delete, the C function needs to do the search.
-    // If it's meant to be the *exact pointer* that was stored, then Python side cannot easily get this
-    // without an internal mapping.
-    // The plan mentioned "delete_fib_node (value-based delete)". So we assume the C function will do the search.
-    // We don't pass `&val` because `delete_fib_node` would try to free `&val` which is on stack.
-    // The `delete_fib_node` must handle the freeing of the *actual stored int pointer*.
-    // We are essentially passing the value `(void*)(intptr_t)val` to avoid pointer issues here,
-    // and expecting C side to search for node `n` where `*(int*)(n->key) == (int)val`.
-    // This is still not quite right, as `delete_fib_node` expects a `void*` that is a key.
-    // The most robust way is if `delete_fib_node` accepts an `int` directly if it's specialized,
-    // or if it accepts the `void* key_to_find_and_delete` and it iterates.
-    // Let's assume `delete_fib_node` is like: `bool delete_fib_node(Fibonacci_Heap *fh, void *key_value_to_delete)`
-    // where `key_value_to_delete` is actually a pointer to the value, not the value itself.
-    // This is getting complicated due to `void*`.
-    // The `test_delete_node` in C uses `delete_node_fib_heap(heap, node_to_delete)` which takes a node.
-    // The header also has `bool delete_fib_node(Fibonacci_Heap *fh, void *data);`
-    // Let's assume `data` for `delete_fib_node` is a pointer to the key value to be deleted,
-    // and the function will find the *actual stored int pointer* and free it.
-    
-    // This is the most problematic function to wrap without knowing `delete_fib_node`'s exact behavior
-    // with respect to `void*` and memory management of `int*`.
-    // For now, let's assume `delete_fib_node` will search for a node containing an `int*` that points to `val`.
-    // This is a placeholder call, the actual C implementation of `delete_fib_node` is critical.
-    // We are passing a pointer to 'val' which is on the stack. This is not what we want to delete or free.
-    // The C function needs to search for a node N where *(int*)N->key == val.
-    // A temporary key pointer for the value.
-    int temp_val = (int)val;
-    if (!delete_fib_node(self->fh, &temp_val)) { // This assumes delete_fib_node searches by value comparison
-                                              // AND correctly frees the *stored* int* key.
-        PyErr_SetString(PyExc_RuntimeError, "Failed to delete from Fibonacci Heap (or value not found).");
+    // a. Read and check the graph and the vertices
+    Graph_Arrays graph;
+    if (!get_graph(offsets, targets, weights, false, &graph)) {
+        return NULL;
+    }
+    size_t n = graph.graph.n;
+    size_t source, target = FIB_GRAPH_NO_TARGET;
+    if (!vertex_arg(source_arg, n, "Vertex", &source) || (target_arg != Py_None && !vertex_arg(target_arg, n, "Vertex", &target))) {
+        release_graph(&graph);
         return NULL;
     }
 
-    Py_RETURN_NONE;
+    // b. Search without the GIL, writing straight into the result arrays (dist, pred)
+    PyObject *arrays[2];
+    Py_buffer views[2];
+    if (!new_vertex_arrays(n, arrays, views)) {
+        release_graph(&graph);
+        return NULL;
+    }
+    PyThreadState *state = release_gil_if(n + graph.graph.m >= GIL_RELEASE_THRESHOLD);
+    bool ok = dijkstra_fib_heap(&graph.graph, source, target, (int64_t)radius,
+                                (int64_t *)views[0].buf, (int64_t *)views[1].buf);
+    restore_gil(state);
+    release_graph(&graph);
+    return finish_vertex_arrays(ok, arrays, views);
 }
 
-
-// update_key(self, old_value, new_value)
+// prim(offsets, targets, weights, root=0)
 static PyObject *
-FibHeap_update_key(FibHeapObject *self, PyObject *args) {
-    long old_val_long, new_val_long;
-    if (!PyArg_ParseTuple(args, "ll", &old_val_long, &new_val_long)) {
+fibheap_prim(PyObject *Py_UNUSED(module), PyObject *args, PyObject *kwds) {
+    static char *kwlist[] = {"offsets", "targets", "weights", "root", NULL};
+    PyObject *offsets, *targets, *weights, *root_arg = NULL;
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "OOO|O", kwlist, &offsets, &targets, &weights, &root_arg)) {
         return NULL;
     }
 
-    if (self->fh == NULL) {
-        PyErr_SetString(PyExc_RuntimeError, "Heap not initialized.");
+    // a. Read and check the graph; weights may be negative here
+    Graph_Arrays graph;
+    if (!get_graph(offsets, targets, weights, true, &graph)) {
+        return NULL;
+    }
+    size_t n = graph.graph.n;
+    size_t root = 0;
+    if (n == 0) {
+        PyErr_SetString(PyExc_ValueError, "The graph has no vertices.");
+    }
+    if (n == 0 || (root_arg != NULL && !vertex_arg(root_arg, n, "Vertex", &root))) {
+        release_graph(&graph);
         return NULL;
     }
 
-    // Similar to delete, `change_fib_node_value` needs to handle finding the node
-    // with `old_val`, free its existing `int*` key, and then store a new `int*` for `new_val`.
-    // The parameters `void* old_val, void* new_val` for `change_fib_node_value` in `fibonacci_heap.h`
-    // are also ambiguous. Are they values or pointers to values?
-    // Assuming they are pointers to values for searching and the new value to adopt.
-    
-    int old_key_val = (int)old_val_long;
-    
-    // The new key needs to be dynamically allocated as it will be stored in the heap.
-    int *new_key_ptr = (int *)malloc(sizeof(int));
-    if (new_key_ptr == NULL) {
-        return PyErr_NoMemory();
+    // b. Grow the forest without the GIL, writing straight into the result arrays (parent, weight)
+    PyObject *arrays[2];
+    Py_buffer views[2];
+    if (!new_vertex_arrays(n, arrays, views)) {
+        release_graph(&graph);
+        return NULL;
+    }
+    PyThreadState *state = release_gil_if(n + graph.graph.m >= GIL_RELEASE_THRESHOLD);
+    bool ok = prim_fib_heap(&graph.graph, root, (int64_t *)views[0].buf, (int64_t *)views[1].buf);
+    restore_gil(state);
+    release_graph(&graph);
+    return finish_vertex_arrays(ok, arrays, views);
+}
+
+// astar(grid, start, goal, width=None, diagonal=False, heuristic=None, budget=None)
+static PyObject *
+fibheap_astar(PyObject *Py_UNUSED(module), PyObject *args, PyObject *kwds) {
+    static char *kwlist[] = {"grid", "start", "goal", "width", "diagonal", "heuristic", "budget", NULL};
+    static const char *heuristics[] = {"manhattan", "octile", "euclidean"}; // FIB_GRID_* order
+    PyObject *grid_arg, *start_arg, *goal_arg, *width_arg = Py_None, *budget_arg = Py_None;
+    int diagonal = 0;
+    const char *heuristic_name = NULL;
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "OOO|OpzO", kwlist, &grid_arg, &start_arg, &goal_arg,
+                                     &width_arg, &diagonal, &heuristic_name, &budget_arg)) {
+        return NULL;
+    }
+    int heuristic = diagonal ? FIB_GRID_OCTILE : FIB_GRID_MANHATTAN;
+    if (heuristic_name != NULL) {
+        for (heuristic = 0; heuristic < 3 && strcmp(heuristic_name, heuristics[heuristic]) != 0; heuristic++) {
+        }
+        if (heuristic == 3) {
+            PyErr_Format(PyExc_ValueError, "heuristic must be 'manhattan', 'octile' or 'euclidean', not '%s'.", heuristic_name);
+            return NULL;
+        }
+    }
+    size_t budget = FIB_GRID_NO_BUDGET;
+    if (budget_arg != Py_None) {
+        Py_ssize_t value = PyLong_AsSsize_t(budget_arg);
+        if (value == -1 && PyErr_Occurred()) {
+            return NULL;
+        }
+        if (value < 1) {
+            PyErr_SetString(PyExc_ValueError, "budget must be at least 1.");
+            return NULL;
+        }
+        budget = (size_t)value;
     }
-    *new_key_ptr = (int)new_val_long;
 
-    // This call assumes `change_fib_node_value` will:
-    // 1. Find a node N such that `*(int*)(N->key) == old_key_val`.
-    // 2. If found, `free(N->key)`.
-    // 3. Set `N->key = new_key_ptr`.
-    // 4. Perform heap adjustments (decrease_key logic).
-    // If `change_fib_node_value` fails, it should not have adopted `new_key_ptr`, so we free it.
-    if (!change_fib_node_value(self->fh, &old_key_val, new_key_ptr)) {
-        free(new_key_ptr);
-        PyErr_SetString(PyExc_RuntimeError, "Failed to update key in Fibonacci Heap (or old value not found).");
+    // a. The grid is a buffer of uint8 costs: two-dimensional (height, width), or flat with
+    // the width given
+    Py_buffer view;
+    if (PyObject_GetBuffer(grid_arg, &view, PyBUF_C_CONTIGUOUS | PyBUF_FORMAT) < 0) {
+        return NULL;
+    }
+    Fib_Grid grid = {(const uint8_t *)view.buf, 0, 0, diagonal != 0};
+    Py_ssize_t width = -1;
+    if (width_arg != Py_None) {
+        width = PyLong_AsSsize_t(width_arg);
+        if (width == -1 && PyErr_Occurred()) {
+            PyBuffer_Release(&view);
+            return NULL;
+        }
+    }
+    const char *error = NULL;
+    if (view.itemsize != 1 || native_int_format(view.format, view.itemsize) != 'B') {
+        error = "grid must be a buffer of uint8 costs.";
+    } else if (view.ndim == 2) {
+        if (width != -1 && width != view.shape[1]) {
+            error = "width does not match the grid's second dimension.";
+        }
+        width = view.shape[1];
+    } else if (view.ndim != 1 || width < 1 || view.len % width != 0) {
+        error = "A flat grid needs a width (at least 1) that divides its length.";
+    }
+    if (error == NULL && width < 1) {
+        error = "The grid has no cells.";
+    }
+    size_t start = 0, goal = 0;
+    if (error == NULL) {
+        grid.width = (size_t)width;
+        grid.height = (size_t)(view.len / width);
+        if (grid.height == 0) {
+            error = "The grid has no cells.";
+        } else if (!vertex_arg(start_arg, (size_t)view.len, "Cell", &start) || !vertex_arg(goal_arg, (size_t)view.len, "Cell", &goal)) {
+            PyBuffer_Release(&view);
+            return NULL;
+        }
+    }
+    if (error != NULL) {
+        PyErr_SetString(PyExc_ValueError, error);
+        PyBuffer_Release(&view);
         return NULL;
     }
 
-    // If successful, new_key_ptr is now owned by the heap.
-    Py_RETURN_NONE;
+    // b. Search without the GIL, then copy the path into an array('q')
+    Fib_Grid_Path path;
+    PyThreadState *state = release_gil_if((size_t)view.len >= GIL_RELEASE_THRESHOLD);
+    bool ok = astar_grid_fib_heap(&grid, start, goal, heuristic, budget, &path);
+    restore_gil(state);
+    PyBuffer_Release(&view);
+    if (!ok) {
+        return PyErr_NoMemory(); // The arguments were checked above
+    }
+    if (path.exhausted) {
+        Py_RETURN_NONE;
+    }
+    Py_buffer result_view;
+    PyObject *result = new_int64_array((Py_ssize_t)path.length, &result_view);
+    if (result != NULL) {
+        if (path.length > 0) {
+            memcpy(result_view.buf, path.cells, path.length * sizeof(int64_t));
+        }
+        PyBuffer_Release(&result_view);
+    }
+    free(path.cells);
+    return result;
 }
 
-// __len__
-static Py_ssize_t
-FibHeap_len(FibHeapObject *self) {
-    if (self->fh == NULL) {
-        PyErr_SetString(PyExc_RuntimeError, "Heap not initialized.");
-        return -1; // Error indicator for sequence protocol
+static PyMethodDef fibheap_methods[] = {
+    {"dijkstra", (PyCFunction)(void (*)(void))fibheap_dijkstra, METH_VARARGS | METH_KEYWORDS,
+     "dijkstra(offsets, targets, weights, source, target=None, radius=None) -> (dist, pred)\n\n"
+     "Shortest paths from `source` in a graph given in CSR form: the edges leaving vertex v go to "
+     "targets[offsets[v]:offsets[v+1]], with the non-negative lengths in weights at the same "
+     "positions. Each argument is an iterable or integer buffer. Returns two array('q') of "
+     "len(offsets) - 1 entries: the distance of every vertex and the vertex before it on a "
+     "shortest path, both -1 if it was not reached (and pred[source] == -1). With `target` the "
+     "search stops once target's distance is known and only the vertices settled by then are "
+     "reported; with `radius` paths longer than radius are not followed. Runs in C without the GIL."},
+    {"prim", (PyCFunction)(void (*)(void))fibheap_prim, METH_VARARGS | METH_KEYWORDS,
+     "prim(offsets, targets, weights, root=0) -> (parent, weight)\n\n"
+     "Minimum spanning forest of an undirected graph in CSR form (as for dijkstra, with every "
+     "edge stored in both directions; weights may be negative), by Prim's algorithm. The tree "
+     "of `root` is grown first, then one per remaining component. Returns two array('q') of "
+     "len(offsets) - 1 entries: the parent of every vertex and the weight of the edge to it; "
+     "roots have parent -1 and weight 0. Runs in C without the GIL."},
+    {"astar", (PyCFunction)(void (*)(void))fibheap_astar, METH_VARARGS | METH_KEYWORDS,
+     "astar(grid, start, goal, width=None, diagonal=False, heuristic=None, budget=None) -> path\n\n"
+     "Cheapest path between two cells of a grid by A*. `grid` is a buffer of uint8 costs, 2-D "
+     "(height, width) or flat with `width` given; cell (x, y) has id y * width + x, entering it "
+     "costs its value and 0 blocks it. With diagonal=True the grid is 8-connected (a diagonal "
+     "step costs sqrt(2) times as much and may not cut a blocked corner). `heuristic` is "
+     "'manhattan' (the default for 4-connected grids), 'octile' (the default with diagonal=True) "
+     "or 'euclidean'. Returns the cell ids from start to goal as an array('q'), empty if there is "
+     "no path, or None if more than `budget` cells had to be expanded. Runs in C without the GIL."},
+    {NULL}  /* Sentinel */
+};
+
+// --- Module State Management ---
+
+static int
+fibheap_traverse(PyObject *module, visitproc visit, void *arg) {
+    Module_State *state = (Module_State *)PyModule_GetState(module);
+    for (size_t i = 0; i < HEAP_TYPE_COUNT; i++) {
+        Py_VISIT(state->heap_types[i]);
     }
-    return (Py_ssize_t)self->fh->n;
+    Py_VISIT(state->handle_type);
+    Py_VISIT(state->multi_queue_type);
+    Py_VISIT(state->top_k_type);
+    return 0;
 }
 
+static int
+fibheap_clear(PyObject *module) {
+    Module_State *state = (Module_State *)PyModule_GetState(module);
+    for (size_t i = 0; i < HEAP_TYPE_COUNT; i++) {
+        Py_CLEAR(state->heap_types[i]);
+    }
+    Py_CLEAR(state->handle_type);
+    Py_CLEAR(state->multi_queue_type);
+    Py_CLEAR(state->top_k_type);
+    return 0;
+}
 
-// --- Method Definitions Table ---
-static PyMethodDef FibHeap_methods[] = {
-    {"insert", (PyCFunction)FibHeap_insert, METH_VARARGS, "Insert a value into the heap."},
-    {"get_min", (PyCFunction)FibHeap_get_min, METH_NOARGS, "Get the minimum value from the heap."},
-    {"extract_min", (PyCFunction)FibHeap_extract_min, METH_NOARGS, "Extract the minimum value from the heap."},
-    {"delete", (PyCFunction)FibHeap_delete, METH_VARARGS, "Delete a value from the heap."},
-    {"update_key", (PyCFunction)FibHeap_update_key, METH_VARARGS, "Update a key from old_value to new_value."},
-    // {"decrease_key", ...} // Could be added if a node reference mechanism is implemented
-    {NULL}  /* Sentinel */
-};
+static void
+fibheap_free(void *module) {
+    fibheap_clear((PyObject *)module);
+}
 
-// --- Sequence Methods (for __len__) ---
-static PySequenceMethods FibHeap_as_sequence = {
-    (lenfunc)FibHeap_len, // sq_length
-    0,                    // sq_concat
-    0,                    // sq_repeat
-    0,                    // sq_item
-    0,                    // sq_slice
-    0,                    // sq_ass_item
-    0,                    // sq_ass_slice
-    0,                    // sq_contains
-    0,                    // sq_inplace_concat
-    0,                    // sq_inplace_repeat
-};
+// Helper function to create the type of `spec` for `module`, register it under the last
+// component of its name and return it (a new reference), or NULL with an exception set.
+static PyTypeObject *
+add_module_type(PyObject *module, PyType_Spec *spec) {
+    PyTypeObject *type = (PyTypeObject *)PyType_FromModuleAndSpec(module, spec, NULL);
+    if (type == NULL) {
+        return NULL;
+    }
+    if (PyModule_AddType(module, type) < 0) {
+        Py_DECREF(type);
+        return NULL;
+    }
+    return type;
+}
+
+// --- Module Execution Function (runs once per module object, in every interpreter) ---
+static int
+fibheap_exec(PyObject *module) {
+    Module_State *state = (Module_State *)PyModule_GetState(module);
+    for (size_t i = 0; i < HEAP_TYPE_COUNT; i++) {
+        state->heap_types[i] = add_module_type(module, heap_type_specs[i]);
+        if (state->heap_types[i] == NULL) {
+            return -1;
+        }
+    }
+    state->handle_type = add_module_type(module, &Handle_spec);
+    if (state->handle_type == NULL) {
+        return -1;
+    }
+    state->multi_queue_type = add_module_type(module, &MultiQueue_spec);
+    if (state->multi_queue_type == NULL) {
+        return -1;
+    }
+    state->top_k_type = add_module_type(module, &TopK_spec);
+    if (state->top_k_type == NULL) {
+        return -1;
+    }
+    return 0;
+}
 
-// --- Type Definition ---
-static PyTypeObject FibHeapType = {
-    PyVarObject_HEAD_INIT(NULL, 0)
-    .tp_name = "fibheap.FibHeap",
-    .tp_doc = "Fibonacci Heap object",
-    .tp_basicsize = sizeof(FibHeapObject),
-    .tp_itemsize = 0,
-    .tp_flags = Py_TPFLAGS_DEFAULT | Py_TPFLAGS_BASETYPE,
-    .tp_new = FibHeap_new,
-    .tp_dealloc = (destructor)FibHeap_dealloc,
-    .tp_repr = (reprfunc)FibHeap_repr,
-    .tp_methods = FibHeap_methods,
-    .tp_as_sequence = &FibHeap_as_sequence,
-    // tp_init, etc. can be added if FibHeap_new is split into tp_new and tp_init
+static PyModuleDef_Slot fibheap_slots[] = {
+    {Py_mod_exec, fibheap_exec},
+#ifdef Py_mod_multiple_interpreters
+    // Nothing is shared between module objects except the owner lock of free-threaded
+    // builds, which is a plain mutex; so each interpreter may run under a GIL of its own
+    {Py_mod_multiple_interpreters, Py_MOD_PER_INTERPRETER_GIL_SUPPORTED},
+#endif
+#ifdef Py_mod_gil
+    // Every heap has its own lock and owner tokens have theirs, so importing the module
+    // leaves the GIL off in a free-threaded interpreter
+    {Py_mod_gil, Py_MOD_GIL_NOT_USED},
+#endif
+    {0, NULL}
 };
 
 // --- Module Definition ---
 static PyModuleDef fibheapmodule = {
     PyModuleDef_HEAD_INIT,
     .m_name = "fibheap",
-    .m_doc = "A Python C extension for a Fibonacci Heap.",
-    .m_size = -1,
-    /* .m_methods = NULL, // No module-level functions, only the type */
+    .m_doc = "A Python C extension for a Fibonacci Heap and alternative heap engines.",
+    .m_size = sizeof(Module_State),
+    .m_slots = fibheap_slots,
+    .m_traverse = fibheap_traverse,
+    .m_clear = fibheap_clear,
+    .m_free = fibheap_free,
+    .m_methods = fibheap_methods,
 };
 
 // --- Module Initialization Function ---
 PyMODINIT_FUNC
 PyInit_fibheap(void) {
-    PyObject *m;
-    if (PyType_Ready(&FibHeapType) < 0)
-        return NULL;
-
-    m = PyModule_Create(&fibheapmodule);
-    if (m == NULL)
-        return NULL;
-
-    Py_INCREF(&FibHeapType);
-    if (PyModule_AddObject(m, "FibHeap", (PyObject *)&FibHeapType) < 0) {
-        Py_DECREF(&FibHeapType);
-        Py_DECREF(m);
-        return NULL;
-    }
-
-    return m;
+    return PyModuleDef_Init(&fibheapmodule);
 }
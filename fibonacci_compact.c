@@ -0,0 +1,640 @@
+#include <stdlib.h>
+#include <string.h>
+#include "fibonacci_compact.h"
+
+// Node structure and helpers mirror fibonacci_heap.c with ids in place of pointers.
+
+#define FIB_COMPACT_MAX_CAPACITY (FIB_COMPACT_NONE - 1)
+
+// Forward declarations for helper functions
+static bool grow_fib_compact_heap(Fibonacci_Compact_Heap *fh, uint64_t needed);
+static bool reserve_degree_table_fib_compact_heap(Fibonacci_Compact_Heap *fh, uint64_t n);
+static Fibonacci_Compact_Id alloc_fib_compact_node(Fibonacci_Compact_Heap *fh);
+static void free_fib_compact_node(Fibonacci_Compact_Heap *fh, Fibonacci_Compact_Id x);
+static void add_root_fib_compact_node(Fibonacci_Compact_Heap *fh, Fibonacci_Compact_Id x);
+static void splice_root_list_fib_compact_heap(Fibonacci_Compact_Heap *fh, Fibonacci_Compact_Id list, Fibonacci_Compact_Id list_min);
+static Fibonacci_Compact_Id remove_min_fib_compact_node(Fibonacci_Compact_Heap *fh);
+static void remove_fib_compact_node(Fibonacci_Compact_Heap *fh, Fibonacci_Compact_Id x);
+static void consolidate_fib_compact_heap(Fibonacci_Compact_Heap *fh);
+static void link_fib_compact_nodes(Fibonacci_Compact_Heap *fh, Fibonacci_Compact_Id y, Fibonacci_Compact_Id x);
+static void cut_fib_compact_node(Fibonacci_Compact_Heap *fh, Fibonacci_Compact_Id x, Fibonacci_Compact_Id y);
+static void cascading_cut_fib_compact_node(Fibonacci_Compact_Heap *fh, Fibonacci_Compact_Id y);
+
+static inline uint32_t compact_degree(const Fibonacci_Compact_Node *node) {
+    return node->degree_mark >> 1;
+}
+
+static inline bool compact_marked(const Fibonacci_Compact_Node *node) {
+    return (node->degree_mark & 1u) != 0;
+}
+
+// Helper: true if 'id' names an element currently in the heap
+static inline bool compact_live(const Fibonacci_Compact_Heap *fh, Fibonacci_Compact_Id id) {
+    return id < fh->used && fh->nodes[id].degree_mark != FIB_COMPACT_NONE;
+}
+
+// Function to create an empty compact heap
+Fibonacci_Compact_Heap *create_fib_compact_heap(uint32_t capacity) {
+    if (capacity < FIB_COMPACT_MIN_CAPACITY) {
+        capacity = FIB_COMPACT_MIN_CAPACITY;
+    }
+    if (capacity > FIB_COMPACT_MAX_CAPACITY) {
+        capacity = FIB_COMPACT_MAX_CAPACITY;
+    }
+    Fibonacci_Compact_Heap *heap = (Fibonacci_Compact_Heap *)calloc(1, sizeof(Fibonacci_Compact_Heap));
+    if (heap == NULL) {
+        return NULL; // Memory allocation failed
+    }
+    heap->nodes = (Fibonacci_Compact_Node *)malloc((size_t)capacity * sizeof(Fibonacci_Compact_Node));
+    heap->keys = (Fibonacci_Key *)malloc((size_t)capacity * sizeof(Fibonacci_Key));
+    if (heap->nodes == NULL || heap->keys == NULL) {
+        free(heap->nodes);
+        free(heap->keys);
+        free(heap);
+        return NULL;
+    }
+    heap->payloads = NULL;
+    heap->capacity = capacity;
+    heap->used = 0;
+    heap->n = 0;
+    heap->min = FIB_COMPACT_NONE;
+    heap->free_list = FIB_COMPACT_NONE;
+    heap->degree_table = NULL;
+    heap->degree_table_size = 0;
+    heap->degree_table_max_n = 0;
+    heap->free_payload = NULL;
+    return heap;
+}
+
+// Helper function to grow every array to hold at least 'needed' slots
+static bool grow_fib_compact_heap(Fibonacci_Compact_Heap *fh, uint64_t needed) {
+    if (needed <= fh->capacity) {
+        return true;
+    }
+    if (needed > FIB_COMPACT_MAX_CAPACITY) {
+        return false; // Ids would run out
+    }
+    uint64_t capacity = (uint64_t)fh->capacity * 2;
+    if (capacity < needed) {
+        capacity = needed;
+    }
+    if (capacity > FIB_COMPACT_MAX_CAPACITY) {
+        capacity = FIB_COMPACT_MAX_CAPACITY;
+    }
+
+    // Each array is replaced only once its realloc succeeded, so a failure leaves the
+    // heap consistent (some arrays merely larger than 'capacity' says).
+    Fibonacci_Compact_Node *nodes = (Fibonacci_Compact_Node *)realloc(fh->nodes, (size_t)capacity * sizeof(Fibonacci_Compact_Node));
+    if (nodes == NULL) {
+        return false;
+    }
+    fh->nodes = nodes;
+    Fibonacci_Key *keys = (Fibonacci_Key *)realloc(fh->keys, (size_t)capacity * sizeof(Fibonacci_Key));
+    if (keys == NULL) {
+        return false;
+    }
+    fh->keys = keys;
+    if (fh->payloads != NULL) {
+        void **payloads = (void **)realloc(fh->payloads, (size_t)capacity * sizeof(void *));
+        if (payloads == NULL) {
+            return false;
+        }
+        memset(payloads + fh->capacity, 0, (size_t)(capacity - fh->capacity) * sizeof(void *));
+        fh->payloads = payloads;
+    }
+    fh->capacity = (uint32_t)capacity;
+    return true;
+}
+
+// Helper function to make sure consolidate's degree table fits a heap of n elements.
+// Same bound as in fibonacci_heap.c: a root of degree k holds at least F(k+2) nodes.
+static bool reserve_degree_table_fib_compact_heap(Fibonacci_Compact_Heap *fh, uint64_t n) {
+    if (n <= fh->degree_table_max_n) {
+        return true;
+    }
+
+    // a. Find the largest degree k with F(k+2) <= n
+    uint64_t f_k2 = 1, f_k3 = 2; // F(k+2) and F(k+3), starting at k = 0
+    uint32_t k = 0;
+    while (f_k3 <= n) {
+        uint64_t next = f_k2 + f_k3;
+        f_k2 = f_k3;
+        f_k3 = next;
+        k++;
+    }
+
+    // b. Grow the table, keeping it all FIB_COMPACT_NONE
+    uint32_t size = k + 2;
+    if (size > fh->degree_table_size) {
+        Fibonacci_Compact_Id *table = (Fibonacci_Compact_Id *)realloc(fh->degree_table, (size_t)size * sizeof(Fibonacci_Compact_Id));
+        if (table == NULL) {
+            return false; // Memory allocation failed, the old table is untouched
+        }
+        for (uint32_t d = fh->degree_table_size; d < size; d++) {
+            table[d] = FIB_COMPACT_NONE;
+        }
+        fh->degree_table = table;
+        fh->degree_table_size = size;
+    }
+    fh->degree_table_max_n = f_k3 - 1 > UINT32_MAX ? UINT32_MAX : (uint32_t)(f_k3 - 1);
+    return true;
+}
+
+// Helper function to take a slot, reusing recycled ones first
+static Fibonacci_Compact_Id alloc_fib_compact_node(Fibonacci_Compact_Heap *fh) {
+    if (fh->free_list != FIB_COMPACT_NONE) {
+        Fibonacci_Compact_Id x = fh->free_list;
+        fh->free_list = fh->nodes[x].right;
+        return x;
+    }
+    if (fh->used == fh->capacity && !grow_fib_compact_heap(fh, (uint64_t)fh->used + 1)) {
+        return FIB_COMPACT_NONE;
+    }
+    return fh->used++;
+}
+
+// Helper function to recycle a slot
+static void free_fib_compact_node(Fibonacci_Compact_Heap *fh, Fibonacci_Compact_Id x) {
+    fh->nodes[x].degree_mark = FIB_COMPACT_NONE; // Marks the slot as free
+    fh->nodes[x].right = fh->free_list;
+    if (fh->payloads != NULL) {
+        fh->payloads[x] = NULL;
+    }
+    fh->free_list = x;
+}
+
+// Helper function to make a detached node a root with no children
+static void add_root_fib_compact_node(Fibonacci_Compact_Heap *fh, Fibonacci_Compact_Id x) {
+    Fibonacci_Compact_Node *node = &fh->nodes[x];
+    node->parent = FIB_COMPACT_NONE;
+    node->child = FIB_COMPACT_NONE;
+    node->degree_mark = 0;
+    node->left = x;
+    node->right = x;
+    splice_root_list_fib_compact_heap(fh, x, x);
+    fh->n++;
+}
+
+// Helper function to splice a circular list of roots in next to the minimum.
+// 'list_min' is the smallest node of 'list'; fh->n is left to the caller.
+static void splice_root_list_fib_compact_heap(Fibonacci_Compact_Heap *fh, Fibonacci_Compact_Id list, Fibonacci_Compact_Id list_min) {
+    Fibonacci_Compact_Node *nodes = fh->nodes;
+    if (fh->min == FIB_COMPACT_NONE) {
+        fh->min = list_min;
+        return;
+    }
+    Fibonacci_Compact_Id next = nodes[fh->min].right;
+    Fibonacci_Compact_Id list_last = nodes[list].left;
+    nodes[fh->min].right = list;
+    nodes[list].left = fh->min;
+    nodes[list_last].right = next;
+    nodes[next].left = list_last;
+    if (fh->keys[list_min] < fh->keys[fh->min]) {
+        fh->min = list_min;
+    }
+}
+
+// Function to insert a new key into the compact heap
+Fibonacci_Compact_Id insert_fib_compact_heap(Fibonacci_Compact_Heap *fh, Fibonacci_Key key, void *payload) {
+    if (fh == NULL || !reserve_degree_table_fib_compact_heap(fh, (uint64_t)fh->n + 1)) {
+        return FIB_COMPACT_NONE;
+    }
+    if (payload != NULL && fh->payloads == NULL) {
+        // First payload: give every slot one from now on
+        fh->payloads = (void **)calloc(fh->capacity, sizeof(void *));
+        if (fh->payloads == NULL) {
+            return FIB_COMPACT_NONE;
+        }
+    }
+
+    Fibonacci_Compact_Id x = alloc_fib_compact_node(fh);
+    if (x == FIB_COMPACT_NONE) {
+        return FIB_COMPACT_NONE; // Memory allocation failed
+    }
+    fh->keys[x] = key;
+    if (fh->payloads != NULL) {
+        fh->payloads[x] = payload;
+    }
+    add_root_fib_compact_node(fh, x);
+    return x;
+}
+
+// Function to insert many keys at once
+bool insert_many_fib_compact_heap(Fibonacci_Compact_Heap *fh, const Fibonacci_Key *keys, size_t count) {
+    if (fh == NULL || (keys == NULL && count > 0)) {
+        return false;
+    }
+    if (count == 0) {
+        return true;
+    }
+
+    // a. Everything that can fail happens before the heap is touched. The new elements
+    // take fresh slots at the end, so they sit next to each other in every array.
+    if (count > FIB_COMPACT_MAX_CAPACITY - fh->used) {
+        return false;
+    }
+    if (!reserve_degree_table_fib_compact_heap(fh, (uint64_t)fh->n + count) ||
+        !grow_fib_compact_heap(fh, (uint64_t)fh->used + count)) {
+        return false;
+    }
+
+    // b. Initialize the nodes and chain them into one circular list, tracking its minimum
+    Fibonacci_Compact_Id first = fh->used, last = (Fibonacci_Compact_Id)(fh->used + count - 1);
+    Fibonacci_Compact_Id list_min = first;
+    memcpy(fh->keys + first, keys, count * sizeof(Fibonacci_Key));
+    for (Fibonacci_Compact_Id x = first; x <= last; x++) {
+        Fibonacci_Compact_Node *node = &fh->nodes[x];
+        node->parent = FIB_COMPACT_NONE;
+        node->child = FIB_COMPACT_NONE;
+        node->degree_mark = 0;
+        node->left = x == first ? last : x - 1;
+        node->right = x == last ? first : x + 1;
+        if (fh->keys[x] < fh->keys[list_min]) {
+            list_min = x;
+        }
+    }
+    if (fh->payloads != NULL) {
+        memset(fh->payloads + first, 0, count * sizeof(void *));
+    }
+    fh->used += (uint32_t)count;
+
+    // c. One splice puts all of them into the root list
+    splice_root_list_fib_compact_heap(fh, first, list_min);
+    fh->n += (uint32_t)count;
+    return true;
+}
+
+Fibonacci_Key get_key_fib_compact_node(const Fibonacci_Compact_Heap *fh, Fibonacci_Compact_Id id) {
+    return fh->keys[id];
+}
+
+// Function to get the minimum key without removing it
+bool get_min_fib_compact_heap(const Fibonacci_Compact_Heap *fh, Fibonacci_Key *key_out, void **payload_out) {
+    if (fh == NULL || fh->min == FIB_COMPACT_NONE) {
+        return false;
+    }
+    if (key_out != NULL) {
+        *key_out = fh->keys[fh->min];
+    }
+    if (payload_out != NULL) {
+        *payload_out = fh->payloads != NULL ? fh->payloads[fh->min] : NULL;
+    }
+    return true;
+}
+
+// Helper function to link root y below root x. Both are detached single nodes.
+static void link_fib_compact_nodes(Fibonacci_Compact_Heap *fh, Fibonacci_Compact_Id y, Fibonacci_Compact_Id x) {
+    Fibonacci_Compact_Node *nodes = fh->nodes;
+
+    // a. Make y a child of x
+    nodes[y].parent = x;
+    Fibonacci_Compact_Id child = nodes[x].child;
+    if (child == FIB_COMPACT_NONE) {
+        nodes[x].child = y;
+        nodes[y].left = y;
+        nodes[y].right = y;
+    } else {
+        // Insert y to the right of x's child
+        nodes[y].right = nodes[child].right;
+        nodes[y].left = child;
+        nodes[nodes[child].right].left = y;
+        nodes[child].right = y;
+    }
+
+    // b. Increment x's degree and clear y's mark
+    nodes[x].degree_mark += 2;
+    nodes[y].degree_mark &= ~1u;
+}
+
+// Helper function to consolidate the root list (see consolidate_fib_heap)
+static void consolidate_fib_compact_heap(Fibonacci_Compact_Heap *fh) {
+    Fibonacci_Compact_Node *nodes = fh->nodes;
+    Fibonacci_Compact_Id *A = fh->degree_table;
+    int64_t max_degree = -1;
+
+    // a. Open the circular root list so it can be walked while roots are linked away
+    Fibonacci_Compact_Id w = fh->min;
+    nodes[nodes[w].left].right = FIB_COMPACT_NONE;
+
+    // b. Link roots of equal degree until every degree appears at most once
+    while (w != FIB_COMPACT_NONE) {
+        Fibonacci_Compact_Id x = w;
+        w = nodes[w].right;
+        nodes[x].parent = FIB_COMPACT_NONE; // Children of the extracted node become roots here
+        nodes[x].left = x;
+        nodes[x].right = x;
+
+        uint32_t d = compact_degree(&nodes[x]);
+        while (A[d] != FIB_COMPACT_NONE) {
+            Fibonacci_Compact_Id y = A[d];
+            if (fh->keys[y] < fh->keys[x]) {
+                Fibonacci_Compact_Id temp = x;
+                x = y;
+                y = temp;
+            }
+            link_fib_compact_nodes(fh, y, x);
+            A[d] = FIB_COMPACT_NONE;
+            d++;
+        }
+        A[d] = x;
+        if ((int64_t)d > max_degree) {
+            max_degree = d;
+        }
+    }
+
+    // c. Rebuild the root list from the table, clearing it for the next call
+    fh->min = FIB_COMPACT_NONE;
+    for (int64_t d = 0; d <= max_degree; d++) {
+        Fibonacci_Compact_Id x = A[d];
+        if (x == FIB_COMPACT_NONE) {
+            continue;
+        }
+        A[d] = FIB_COMPACT_NONE;
+        splice_root_list_fib_compact_heap(fh, x, x);
+    }
+}
+
+// Helper function to unlink the minimum node and consolidate. Returns its id, still allocated.
+static Fibonacci_Compact_Id remove_min_fib_compact_node(Fibonacci_Compact_Heap *fh) {
+    Fibonacci_Compact_Node *nodes = fh->nodes;
+    Fibonacci_Compact_Id z = fh->min;
+    if (z == FIB_COMPACT_NONE) {
+        return FIB_COMPACT_NONE;
+    }
+
+    // a. Splice z's children into the root list next to z
+    Fibonacci_Compact_Id first_child = nodes[z].child;
+    if (first_child != FIB_COMPACT_NONE) {
+        Fibonacci_Compact_Id last_child = nodes[first_child].left;
+        nodes[last_child].right = nodes[z].right;
+        nodes[nodes[z].right].left = last_child;
+        nodes[z].right = first_child;
+        nodes[first_child].left = z;
+        nodes[z].child = FIB_COMPACT_NONE;
+    }
+
+    // b. Remove z from the root list
+    if (nodes[z].right == z) {
+        fh->min = FIB_COMPACT_NONE;
+        fh->n = 0;
+        return z;
+    }
+    nodes[nodes[z].left].right = nodes[z].right;
+    nodes[nodes[z].right].left = nodes[z].left;
+    fh->min = nodes[z].right;
+
+    // c. Merge trees of equal degree and find the new minimum
+    consolidate_fib_compact_heap(fh);
+    fh->n--;
+    return z;
+}
+
+// Helper function to unlink any node: cut it up to the root list, then remove it as the minimum
+static void remove_fib_compact_node(Fibonacci_Compact_Heap *fh, Fibonacci_Compact_Id x) {
+    Fibonacci_Compact_Id y = fh->nodes[x].parent;
+    if (y != FIB_COMPACT_NONE) {
+        cut_fib_compact_node(fh, x, y);
+        cascading_cut_fib_compact_node(fh, y);
+    }
+    fh->min = x;
+    remove_min_fib_compact_node(fh);
+}
+
+// Function to extract the minimum element
+bool extract_min_fib_compact_heap(Fibonacci_Compact_Heap *fh, Fibonacci_Key *key_out, void **payload_out) {
+    if (fh == NULL) {
+        return false;
+    }
+    Fibonacci_Compact_Id z = remove_min_fib_compact_node(fh);
+    if (z == FIB_COMPACT_NONE) {
+        return false; // Heap is empty
+    }
+    if (key_out != NULL) {
+        *key_out = fh->keys[z];
+    }
+    if (payload_out != NULL) {
+        *payload_out = fh->payloads != NULL ? fh->payloads[z] : NULL;
+    }
+    free_fib_compact_node(fh, z);
+    return true;
+}
+
+// Function to extract up to k minimum keys at once
+size_t extract_min_many_fib_compact_heap(Fibonacci_Compact_Heap *fh, Fibonacci_Key *keys_out, void **payloads_out, size_t k) {
+    if (fh == NULL || keys_out == NULL) {
+        return 0;
+    }
+
+    size_t extracted = 0;
+    while (extracted < k) {
+        Fibonacci_Compact_Id z = remove_min_fib_compact_node(fh);
+        if (z == FIB_COMPACT_NONE) {
+            break; // Heap is empty
+        }
+        keys_out[extracted] = fh->keys[z];
+        void *payload = fh->payloads != NULL ? fh->payloads[z] : NULL;
+        if (payloads_out != NULL) {
+            payloads_out[extracted] = payload;
+        } else if (fh->free_payload != NULL && payload != NULL) {
+            fh->free_payload(payload);
+        }
+        free_fib_compact_node(fh, z);
+        extracted++;
+    }
+    return extracted;
+}
+
+// Helper function to move x from its parent y's child list to the root list
+static void cut_fib_compact_node(Fibonacci_Compact_Heap *fh, Fibonacci_Compact_Id x, Fibonacci_Compact_Id y) {
+    Fibonacci_Compact_Node *nodes = fh->nodes;
+
+    // a. Remove x from the child list of y
+    if (nodes[x].right == x) {
+        nodes[y].child = FIB_COMPACT_NONE;
+    } else {
+        nodes[nodes[x].left].right = nodes[x].right;
+        nodes[nodes[x].right].left = nodes[x].left;
+        if (nodes[y].child == x) {
+            nodes[y].child = nodes[x].right;
+        }
+    }
+    nodes[y].degree_mark -= 2;
+
+    // b. Add x to the root list as an unmarked root
+    nodes[x].parent = FIB_COMPACT_NONE;
+    nodes[x].degree_mark &= ~1u;
+    nodes[x].left = x;
+    nodes[x].right = x;
+    splice_root_list_fib_compact_heap(fh, x, x);
+}
+
+// Helper function to walk up from y, cutting marked ancestors and marking the first unmarked one
+static void cascading_cut_fib_compact_node(Fibonacci_Compact_Heap *fh, Fibonacci_Compact_Id y) {
+    Fibonacci_Compact_Node *nodes = fh->nodes;
+    Fibonacci_Compact_Id z = nodes[y].parent;
+    while (z != FIB_COMPACT_NONE) {
+        if (!compact_marked(&nodes[y])) {
+            nodes[y].degree_mark |= 1u;
+            return;
+        }
+        cut_fib_compact_node(fh, y, z);
+        y = z;
+        z = nodes[y].parent;
+    }
+}
+
+// Function to decrease the key of an element
+bool decrease_key_fib_compact_heap(Fibonacci_Compact_Heap *fh, Fibonacci_Compact_Id id, Fibonacci_Key new_key) {
+    if (fh == NULL || !compact_live(fh, id) || new_key > fh->keys[id]) {
+        return false;
+    }
+
+    fh->keys[id] = new_key;
+    Fibonacci_Compact_Id y = fh->nodes[id].parent;
+    if (y != FIB_COMPACT_NONE && new_key < fh->keys[y]) {
+        cut_fib_compact_node(fh, id, y);
+        cascading_cut_fib_compact_node(fh, y);
+    }
+    if (new_key < fh->keys[fh->min]) {
+        fh->min = id;
+    }
+    return true;
+}
+
+// Function to delete a specific element
+bool delete_node_fib_compact_heap(Fibonacci_Compact_Heap *fh, Fibonacci_Compact_Id id, Fibonacci_Key *key_out, void **payload_out) {
+    if (fh == NULL || !compact_live(fh, id)) {
+        return false;
+    }
+    remove_fib_compact_node(fh, id);
+    if (key_out != NULL) {
+        *key_out = fh->keys[id];
+    }
+    if (payload_out != NULL) {
+        *payload_out = fh->payloads != NULL ? fh->payloads[id] : NULL;
+    }
+    free_fib_compact_node(fh, id);
+    return true;
+}
+
+// Function to find an element by its key
+Fibonacci_Compact_Id find_node_fib_compact_heap_key(const Fibonacci_Compact_Heap *fh, Fibonacci_Key key) {
+    if (fh == NULL) {
+        return FIB_COMPACT_NONE;
+    }
+    for (Fibonacci_Compact_Id x = 0; x < fh->used; x++) {
+        if (fh->keys[x] == key && fh->nodes[x].degree_mark != FIB_COMPACT_NONE) { // Skip recycled slots
+            return x;
+        }
+    }
+    return FIB_COMPACT_NONE;
+}
+
+// Function to delete an element found by its key
+bool delete_fib_compact_node_key(Fibonacci_Compact_Heap *fh, Fibonacci_Key key, void **payload_out) {
+    Fibonacci_Compact_Id x = find_node_fib_compact_heap_key(fh, key);
+    if (x == FIB_COMPACT_NONE) {
+        return false;
+    }
+    return delete_node_fib_compact_heap(fh, x, NULL, payload_out);
+}
+
+// Function to change the key of an element found by its key
+bool change_fib_compact_node_key(Fibonacci_Compact_Heap *fh, Fibonacci_Key old_key, Fibonacci_Key new_key) {
+    Fibonacci_Compact_Id x = find_node_fib_compact_heap_key(fh, old_key);
+    if (x == FIB_COMPACT_NONE) {
+        return false;
+    }
+    if (new_key <= old_key) {
+        return decrease_key_fib_compact_heap(fh, x, new_key);
+    }
+    // Increase: unlink the node and put it back as a fresh root, keeping id and payload
+    remove_fib_compact_node(fh, x);
+    fh->keys[x] = new_key;
+    add_root_fib_compact_node(fh, x);
+    return true;
+}
+
+// Function to meld two compact heaps
+bool meld_fib_compact_heap(Fibonacci_Compact_Heap *dst, Fibonacci_Compact_Heap *src, uint32_t *id_offset_out) {
+    if (dst == NULL || src == NULL || dst == src) {
+        return false;
+    }
+    uint32_t offset = dst->used;
+    if (src->used > FIB_COMPACT_MAX_CAPACITY - offset) {
+        return false;
+    }
+
+    // a. Everything that can fail happens before either heap is touched
+    if (!reserve_degree_table_fib_compact_heap(dst, (uint64_t)dst->n + src->n) ||
+        !grow_fib_compact_heap(dst, (uint64_t)offset + src->used)) {
+        return false;
+    }
+    if (src->payloads != NULL && dst->payloads == NULL) {
+        dst->payloads = (void **)calloc(dst->capacity, sizeof(void *));
+        if (dst->payloads == NULL) {
+            return false;
+        }
+    }
+
+    // b. Append src's slots, shifting every link by 'offset'
+    for (uint32_t i = 0; i < src->used; i++) {
+        Fibonacci_Compact_Node node = src->nodes[i];
+        node.parent = node.parent == FIB_COMPACT_NONE ? FIB_COMPACT_NONE : node.parent + offset;
+        node.child = node.child == FIB_COMPACT_NONE ? FIB_COMPACT_NONE : node.child + offset;
+        node.left = node.left == FIB_COMPACT_NONE ? FIB_COMPACT_NONE : node.left + offset;
+        node.right = node.right == FIB_COMPACT_NONE ? FIB_COMPACT_NONE : node.right + offset;
+        dst->nodes[offset + i] = node;
+    }
+    memcpy(dst->keys + offset, src->keys, (size_t)src->used * sizeof(Fibonacci_Key));
+    if (dst->payloads != NULL) {
+        if (src->payloads != NULL) {
+            memcpy(dst->payloads + offset, src->payloads, (size_t)src->used * sizeof(void *));
+        } else {
+            memset(dst->payloads + offset, 0, (size_t)src->used * sizeof(void *));
+        }
+    }
+    dst->used = offset + src->used;
+
+    // c. Chain src's recycled slots in front of dst's free list
+    if (src->free_list != FIB_COMPACT_NONE) {
+        Fibonacci_Compact_Id tail = src->free_list + offset;
+        while (dst->nodes[tail].right != FIB_COMPACT_NONE) {
+            tail = dst->nodes[tail].right;
+        }
+        dst->nodes[tail].right = dst->free_list;
+        dst->free_list = src->free_list + offset;
+    }
+
+    // d. Splice the root lists and leave src empty, keeping its arrays for reuse
+    if (src->min != FIB_COMPACT_NONE) {
+        splice_root_list_fib_compact_heap(dst, src->min + offset, src->min + offset);
+    }
+    dst->n += src->n;
+    src->used = 0;
+    src->n = 0;
+    src->min = FIB_COMPACT_NONE;
+    src->free_list = FIB_COMPACT_NONE;
+    if (id_offset_out != NULL) {
+        *id_offset_out = offset;
+    }
+    return true;
+}
+
+void destroy_fib_compact_heap(Fibonacci_Compact_Heap *fh) {
+    if (fh == NULL) {
+        return;
+    }
+    if (fh->free_payload != NULL && fh->payloads != NULL) {
+        for (uint32_t x = 0; x < fh->used; x++) {
+            if (fh->nodes[x].degree_mark != FIB_COMPACT_NONE && fh->payloads[x] != NULL) { // Skip recycled slots
+                fh->free_payload(fh->payloads[x]);
+            }
+        }
+    }
+    free(fh->nodes);
+    free(fh->keys);
+    free(fh->payloads);
+    free(fh->degree_table);
+    free(fh);
+}
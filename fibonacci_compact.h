@@ -0,0 +1,105 @@
+#ifndef FIBONACCI_COMPACT_H
+#define FIBONACCI_COMPACT_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "fibonacci_heap.h"
+
+// Compact Fibonacci heap: the same structure as Fibonacci_Heap, but nodes live in growable
+// arrays and refer to each other by 32-bit index instead of by pointer. A node's links
+// take 20 bytes and its key 8 more in a separate contiguous array; payloads get their own
+// array only once a non-NULL payload is inserted. That is half the size of a
+// Fibonacci_Node, and because nothing holds a pointer, the arrays can be copied or
+// written out as they are.
+//
+// Elements are named by Fibonacci_Compact_Id, which stays valid until the element is
+// extracted or deleted. Ids of removed elements are reused by later inserts.
+
+typedef uint32_t Fibonacci_Compact_Id;
+
+#define FIB_COMPACT_NONE UINT32_MAX        // "No node": empty links and failed inserts
+#define FIB_COMPACT_MIN_CAPACITY 256
+
+// Node links. degree_mark packs the degree (upper 31 bits) and the mark (lowest bit);
+// recycled slots hold FIB_COMPACT_NONE there and chain the free list through 'right'.
+typedef struct Fibonacci_Compact_Node {
+    Fibonacci_Compact_Id parent;
+    Fibonacci_Compact_Id child;
+    Fibonacci_Compact_Id left;
+    Fibonacci_Compact_Id right;
+    uint32_t degree_mark;
+} Fibonacci_Compact_Node;
+
+typedef struct Fibonacci_Compact_Heap {
+    Fibonacci_Compact_Node *nodes;
+    Fibonacci_Key *keys;        // keys[id] belongs to nodes[id]
+    void **payloads;            // NULL until the first non-NULL payload is inserted
+    uint32_t capacity;          // Slots allocated in each array
+    uint32_t used;              // Slots handed out so far (bump allocation)
+    uint32_t n;
+    Fibonacci_Compact_Id min;
+    Fibonacci_Compact_Id free_list;
+    // Consolidation scratch table, as in Fibonacci_Heap, all FIB_COMPACT_NONE between calls
+    Fibonacci_Compact_Id *degree_table;
+    uint32_t degree_table_size;
+    uint32_t degree_table_max_n;
+    // Called on payloads the heap drops on its own (extract_min_many_fib_compact_heap and
+    // destroy_fib_compact_heap). NULL by default: payloads are left alone.
+    void (*free_payload)(void *payload);
+} Fibonacci_Compact_Heap;
+
+// Creates an empty heap with room for 'capacity' elements before the first resize
+// (at least FIB_COMPACT_MIN_CAPACITY). Returns NULL if allocation failed.
+Fibonacci_Compact_Heap *create_fib_compact_heap(uint32_t capacity);
+
+// Inserts 'key' with an optional 'payload' and returns its id, or FIB_COMPACT_NONE if
+// allocation failed.
+Fibonacci_Compact_Id insert_fib_compact_heap(Fibonacci_Compact_Heap *fh, Fibonacci_Key key, void *payload);
+
+// Inserts 'count' keys (with NULL payloads) and splices them into the root list in one pass.
+// All or nothing: returns false, leaving the heap unchanged, if allocation failed.
+bool insert_many_fib_compact_heap(Fibonacci_Compact_Heap *fh, const Fibonacci_Key *keys, size_t count);
+
+// Returns the key stored under 'id'. Only meaningful while the element is in the heap.
+Fibonacci_Key get_key_fib_compact_node(const Fibonacci_Compact_Heap *fh, Fibonacci_Compact_Id id);
+
+// Copies the minimum key (and its payload, if payload_out is not NULL) without removing it.
+// Returns false if the heap is empty.
+bool get_min_fib_compact_heap(const Fibonacci_Compact_Heap *fh, Fibonacci_Key *key_out, void **payload_out);
+
+// Removes the minimum element and hands back its key and payload. Either out pointer may be NULL.
+// Returns false if the heap is empty.
+bool extract_min_fib_compact_heap(Fibonacci_Compact_Heap *fh, Fibonacci_Key *key_out, void **payload_out);
+
+// Removes up to k minimum elements, writing their keys in ascending order to keys_out[0..].
+// Payloads go to payloads_out if it is not NULL and are otherwise passed to
+// fh->free_payload (if set). Returns how many elements were removed.
+size_t extract_min_many_fib_compact_heap(Fibonacci_Compact_Heap *fh, Fibonacci_Key *keys_out, void **payloads_out, size_t k);
+
+// Lowers the key of 'id' to new_key. Returns false if new_key is greater than the current key.
+bool decrease_key_fib_compact_heap(Fibonacci_Compact_Heap *fh, Fibonacci_Compact_Id id, Fibonacci_Key new_key);
+
+// Removes 'id' from the heap and hands back its key and payload. Either out pointer may be NULL.
+bool delete_node_fib_compact_heap(Fibonacci_Compact_Heap *fh, Fibonacci_Compact_Id id, Fibonacci_Key *key_out, void **payload_out);
+
+// Returns the id of an element holding 'key', or FIB_COMPACT_NONE. Scans the key array.
+Fibonacci_Compact_Id find_node_fib_compact_heap_key(const Fibonacci_Compact_Heap *fh, Fibonacci_Key key);
+
+// Searches for an element holding 'key' and removes it, handing back its payload.
+// Returns false if no element holds 'key'.
+bool delete_fib_compact_node_key(Fibonacci_Compact_Heap *fh, Fibonacci_Key key, void **payload_out);
+
+// Searches for an element holding 'old_key' and moves it to 'new_key' in either direction,
+// keeping its id and payload. Returns false if no element holds 'old_key'.
+bool change_fib_compact_node_key(Fibonacci_Compact_Heap *fh, Fibonacci_Key old_key, Fibonacci_Key new_key);
+
+// Moves every element of 'src' into 'dst' and leaves 'src' empty. Unlike meld_fib_heap
+// this copies src's arrays, so it costs O(src->used); the element with id i in 'src'
+// gets id i + *id_offset_out in 'dst'. Returns false (changing nothing) on dst == src
+// or allocation failure.
+bool meld_fib_compact_heap(Fibonacci_Compact_Heap *dst, Fibonacci_Compact_Heap *src, uint32_t *id_offset_out);
+
+void destroy_fib_compact_heap(Fibonacci_Compact_Heap *fh);
+
+#endif // FIBONACCI_COMPACT_H
@@ -0,0 +1,326 @@
+#include <stdlib.h>
+#include "fibonacci_graph.h"
+
+// Forward declarations for helper functions
+static bool grow_prim_tree(const Fib_Csr_Graph *g, Fibonacci_Heap *heap, Fibonacci_Node **nodes,
+                           bool *in_tree, size_t start, int64_t *parent_out, int64_t *weight_out);
+static uint64_t isqrt_u64(uint64_t x);
+static int64_t grid_heuristic(const Fib_Grid *grid, int heuristic, size_t cell, size_t goal);
+static bool trace_grid_path(const int64_t *pred, size_t start, size_t goal, Fib_Grid_Path *path_out);
+
+// Function to check that a CSR graph is well formed
+bool check_csr_graph(const Fib_Csr_Graph *g, bool negative_weights) {
+    if (g == NULL || g->offsets == NULL || (g->m > 0 && (g->targets == NULL || g->weights == NULL))) {
+        return false;
+    }
+    if (g->offsets[0] != 0 || (uint64_t)g->offsets[g->n] != g->m) {
+        return false;
+    }
+    for (size_t v = 0; v < g->n; v++) {
+        if (g->offsets[v + 1] < g->offsets[v]) {
+            return false;
+        }
+    }
+    for (size_t e = 0; e < g->m; e++) {
+        if (g->targets[e] < 0 || (uint64_t)g->targets[e] >= g->n || (g->weights[e] < 0 && !negative_weights)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Function to run Dijkstra's algorithm on a CSR graph
+bool dijkstra_fib_heap(const Fib_Csr_Graph *g, size_t source, size_t target, int64_t radius,
+                       int64_t *dist_out, int64_t *pred_out) {
+    if (g == NULL || source >= g->n || (target != FIB_GRAPH_NO_TARGET && target >= g->n) || radius < 0) {
+        return false;
+    }
+    // nodes[v] is v's node while v is in the heap. A vertex with a distance but no node has
+    // been settled; one without a distance was never reached.
+    Fibonacci_Node **nodes = (Fibonacci_Node **)calloc(g->n, sizeof(Fibonacci_Node *));
+    Fibonacci_Heap *heap = create_fib_heap();
+    if (nodes == NULL || heap == NULL) {
+        free(nodes);
+        destroy_fib_heap(heap);
+        return false; // Memory allocation failed
+    }
+    for (size_t v = 0; v < g->n; v++) {
+        dist_out[v] = FIB_GRAPH_NONE;
+        pred_out[v] = FIB_GRAPH_NONE;
+    }
+
+    // a. Start from the source alone; every other vertex enters the heap when first reached
+    dist_out[source] = 0;
+    nodes[source] = insert_fib_heap_key(heap, 0, (void *)(uintptr_t)source);
+    bool ok = nodes[source] != NULL;
+    Fibonacci_Key d;
+    void *payload;
+    while (ok && extract_min_fib_heap_key(heap, &d, &payload)) {
+        size_t u = (size_t)(uintptr_t)payload;
+        nodes[u] = NULL;
+        if (u == target) {
+            break;
+        }
+
+        // b. Relax the edges of u. d <= radius, so the bound check cannot overflow.
+        for (int64_t e = g->offsets[u]; e < g->offsets[u + 1]; e++) {
+            size_t v = (size_t)g->targets[e];
+            int64_t w = g->weights[e];
+            if (w > radius - d) {
+                continue;
+            }
+            int64_t nd = d + w;
+            if (dist_out[v] == FIB_GRAPH_NONE) {
+                nodes[v] = insert_fib_heap_key(heap, nd, (void *)(uintptr_t)v);
+                if (nodes[v] == NULL) {
+                    ok = false;
+                    break;
+                }
+            } else if (nodes[v] != NULL && nd < dist_out[v]) {
+                decrease_key_fib_heap_key(heap, nodes[v], nd);
+            } else {
+                continue; // Settled, or no shorter than the path already found
+            }
+            dist_out[v] = nd;
+            pred_out[v] = (int64_t)u;
+        }
+    }
+
+    // c. Vertices still in the heap after an early stop only have upper bounds
+    for (size_t v = 0; v < g->n; v++) {
+        if (nodes[v] != NULL) {
+            dist_out[v] = FIB_GRAPH_NONE;
+            pred_out[v] = FIB_GRAPH_NONE;
+        }
+    }
+    destroy_fib_heap(heap);
+    free(nodes);
+    return ok;
+}
+
+// Helper function to grow the minimum spanning tree of the component of 'start'. Returns false
+// if allocation failed.
+static bool grow_prim_tree(const Fib_Csr_Graph *g, Fibonacci_Heap *heap, Fibonacci_Node **nodes,
+                           bool *in_tree, size_t start, int64_t *parent_out, int64_t *weight_out) {
+    parent_out[start] = FIB_GRAPH_NONE;
+    weight_out[start] = 0;
+    size_t u = start;
+    for (;;) {
+        nodes[u] = NULL;
+        in_tree[u] = true;
+
+        // a. Offer every edge from u to a vertex outside the tree
+        for (int64_t e = g->offsets[u]; e < g->offsets[u + 1]; e++) {
+            size_t v = (size_t)g->targets[e];
+            int64_t w = g->weights[e];
+            if (in_tree[v]) {
+                continue;
+            }
+            if (nodes[v] == NULL) {
+                nodes[v] = insert_fib_heap_key(heap, w, (void *)(uintptr_t)v);
+                if (nodes[v] == NULL) {
+                    return false;
+                }
+            } else if (w < weight_out[v]) {
+                decrease_key_fib_heap_key(heap, nodes[v], w);
+            } else {
+                continue;
+            }
+            parent_out[v] = (int64_t)u;
+            weight_out[v] = w;
+        }
+
+        // b. The lightest edge leaving the tree brings in the next vertex
+        void *payload;
+        if (!extract_min_fib_heap_key(heap, NULL, &payload)) {
+            return true;
+        }
+        u = (size_t)(uintptr_t)payload;
+    }
+}
+
+// Function to find a minimum spanning forest with Prim's algorithm
+bool prim_fib_heap(const Fib_Csr_Graph *g, size_t root, int64_t *parent_out, int64_t *weight_out) {
+    if (g == NULL || root >= g->n) {
+        return false;
+    }
+    // nodes[v] is v's node while v is in the heap, keyed by the lightest edge from the tree
+    // to v found so far (in weight_out[v]); 'in_tree' marks the vertices already spanned.
+    Fibonacci_Node **nodes = (Fibonacci_Node **)calloc(g->n, sizeof(Fibonacci_Node *));
+    bool *in_tree = (bool *)calloc(g->n, sizeof(bool));
+    Fibonacci_Heap *heap = create_fib_heap();
+    if (nodes == NULL || in_tree == NULL || heap == NULL) {
+        free(nodes);
+        free(in_tree);
+        destroy_fib_heap(heap);
+        return false; // Memory allocation failed
+    }
+    bool ok = grow_prim_tree(g, heap, nodes, in_tree, root, parent_out, weight_out);
+    for (size_t v = 0; ok && v < g->n; v++) {
+        if (!in_tree[v]) {
+            ok = grow_prim_tree(g, heap, nodes, in_tree, v, parent_out, weight_out);
+        }
+    }
+    destroy_fib_heap(heap);
+    free(in_tree);
+    free(nodes);
+    return ok;
+}
+
+// Helper function to compute floor(sqrt(x)) by Newton's method, for x < 2^63
+static uint64_t isqrt_u64(uint64_t x) {
+    if (x < 2) {
+        return x;
+    }
+    uint64_t r = x;
+    uint64_t y = (r + 1) / 2;
+    while (y < r) {
+        r = y;
+        y = (r + x / r) / 2;
+    }
+    return r;
+}
+
+// Helper function to estimate the cost from 'cell' to 'goal'
+static int64_t grid_heuristic(const Fib_Grid *grid, int heuristic, size_t cell, size_t goal) {
+    size_t x = cell % grid->width, y = cell / grid->width;
+    size_t gx = goal % grid->width, gy = goal / grid->width;
+    uint64_t dx = x > gx ? x - gx : gx - x;
+    uint64_t dy = y > gy ? y - gy : gy - y;
+    uint64_t lo = dx < dy ? dx : dy, hi = dx < dy ? dy : dx;
+    switch (heuristic) {
+        case FIB_GRID_MANHATTAN:
+            return (int64_t)((dx + dy) * FIB_GRID_STRAIGHT);
+        case FIB_GRID_OCTILE:
+            return (int64_t)(hi * FIB_GRID_STRAIGHT + lo * (FIB_GRID_DIAGONAL - FIB_GRID_STRAIGHT));
+        default:
+            // Beyond 2^21 cells the squares would overflow; the longer side is still a lower bound
+            if (hi >= ((uint64_t)1 << 21)) {
+                return (int64_t)(hi * FIB_GRID_STRAIGHT);
+            }
+            return (int64_t)isqrt_u64((dx * dx + dy * dy) * FIB_GRID_STRAIGHT * FIB_GRID_STRAIGHT);
+    }
+}
+
+// Helper function to copy the path ending at 'goal' out of the predecessor array, where
+// pred[v] holds v's predecessor plus one. Returns false if allocation failed.
+static bool trace_grid_path(const int64_t *pred, size_t start, size_t goal, Fib_Grid_Path *path_out) {
+    size_t length = 1;
+    for (size_t v = goal; v != start; v = (size_t)pred[v] - 1) {
+        length++;
+    }
+    path_out->cells = (int64_t *)malloc(length * sizeof(int64_t));
+    if (path_out->cells == NULL) {
+        return false;
+    }
+    path_out->length = length;
+    size_t v = goal;
+    for (size_t i = length; i-- > 0; v = (size_t)pred[v] - 1) {
+        path_out->cells[i] = (int64_t)v;
+    }
+    return true;
+}
+
+// Function to find a cheapest path on a grid with A*
+bool astar_grid_fib_heap(const Fib_Grid *grid, size_t start, size_t goal, int heuristic, size_t budget,
+                         Fib_Grid_Path *path_out) {
+    if (grid == NULL || path_out == NULL || grid->width == 0 || grid->height > SIZE_MAX / grid->width) {
+        return false;
+    }
+    size_t n = grid->width * grid->height;
+    // The most expensive path visits every cell once
+    if (start >= n || goal >= n || heuristic < FIB_GRID_MANHATTAN || heuristic > FIB_GRID_EUCLIDEAN
+        || n > (size_t)(INT64_MAX / (255 * FIB_GRID_DIAGONAL))) {
+        return false;
+    }
+    path_out->cells = NULL;
+    path_out->length = 0;
+    path_out->cost = FIB_GRAPH_NONE;
+    path_out->expanded = 0;
+    path_out->exhausted = false;
+    if (grid->cells[start] == 0 || grid->cells[goal] == 0) {
+        return true; // Blocked
+    }
+
+    // nodes[v] is v's node while v is open. pred[v] is 0 until v is reached and then its
+    // predecessor plus one; g[v] is the cost of the way to v found so far, set once reached.
+    // A reached cell without a node is closed. calloc leaves untouched pages to the OS.
+    Fibonacci_Node **nodes = (Fibonacci_Node **)calloc(n, sizeof(Fibonacci_Node *));
+    int64_t *pred = (int64_t *)calloc(n, sizeof(int64_t));
+    int64_t *g = (int64_t *)malloc(n * sizeof(int64_t));
+    Fibonacci_Heap *heap = create_fib_heap();
+    if (nodes == NULL || pred == NULL || g == NULL || heap == NULL) {
+        free(nodes);
+        free(pred);
+        free(g);
+        destroy_fib_heap(heap);
+        return false; // Memory allocation failed
+    }
+    static const int steps[8][2] = {{1, 0}, {-1, 0}, {0, 1}, {0, -1}, {1, 1}, {1, -1}, {-1, 1}, {-1, -1}};
+    int directions = grid->diagonal ? 8 : 4;
+    size_t w = grid->width;
+
+    // a. Open the start
+    g[start] = 0;
+    pred[start] = (int64_t)start + 1;
+    nodes[start] = insert_fib_heap_key(heap, grid_heuristic(grid, heuristic, start, goal), (void *)(uintptr_t)start);
+    bool ok = nodes[start] != NULL;
+    bool found = false;
+    void *payload;
+    while (ok && extract_min_fib_heap_key(heap, NULL, &payload)) {
+        size_t u = (size_t)(uintptr_t)payload;
+        nodes[u] = NULL;
+        path_out->expanded++;
+        if (u == goal) {
+            found = true;
+            break;
+        }
+        if (path_out->expanded >= budget) {
+            path_out->exhausted = true;
+            break;
+        }
+
+        // b. Open or improve every passable neighbour that is not closed yet
+        size_t ux = u % w, uy = u / w;
+        for (int d = 0; d < directions; d++) {
+            if ((steps[d][0] < 0 && ux == 0) || (steps[d][0] > 0 && ux + 1 == w)
+                || (steps[d][1] < 0 && uy == 0) || (steps[d][1] > 0 && uy + 1 == grid->height)) {
+                continue; // Off the grid
+            }
+            size_t vx = ux + (size_t)(ptrdiff_t)steps[d][0], vy = uy + (size_t)(ptrdiff_t)steps[d][1];
+            size_t v = vy * w + vx;
+            bool diagonal = d >= 4;
+            if (grid->cells[v] == 0 || (diagonal && (grid->cells[uy * w + vx] == 0 || grid->cells[vy * w + ux] == 0))) {
+                continue; // Blocked, or cutting the corner of a blocked cell
+            }
+            if (pred[v] != 0 && nodes[v] == NULL) {
+                continue; // Closed
+            }
+            int64_t ng = g[u] + (int64_t)grid->cells[v] * (diagonal ? FIB_GRID_DIAGONAL : FIB_GRID_STRAIGHT);
+            if (pred[v] == 0) {
+                nodes[v] = insert_fib_heap_key(heap, ng + grid_heuristic(grid, heuristic, v, goal), (void *)(uintptr_t)v);
+                if (nodes[v] == NULL) {
+                    ok = false;
+                    break;
+                }
+            } else if (ng < g[v]) {
+                decrease_key_fib_heap_key(heap, nodes[v], ng + grid_heuristic(grid, heuristic, v, goal));
+            } else {
+                continue;
+            }
+            g[v] = ng;
+            pred[v] = (int64_t)u + 1;
+        }
+    }
+
+    // c. Walk back from the goal
+    if (ok && found) {
+        path_out->cost = g[goal];
+        ok = trace_grid_path(pred, start, goal, path_out);
+    }
+    destroy_fib_heap(heap);
+    free(g);
+    free(pred);
+    free(nodes);
+    return ok;
+}
@@ -0,0 +1,96 @@
+#ifndef FIBONACCI_GRAPH_H
+#define FIBONACCI_GRAPH_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "fibonacci_heap.h"
+
+// Graph algorithms driven by a Fibonacci heap. Every vertex in the heap is reached through
+// the node pointer insert_fib_heap_key returned for it, kept in an array indexed by vertex,
+// so a relaxation is one O(1) amortized decrease_key_fib_heap_key and never a search by
+// value. Vertices are numbered 0 .. n-1 and travel through the heap as their payloads.
+
+// Directed graph in compressed sparse row form: the edges leaving vertex v are
+// targets[offsets[v] .. offsets[v+1]), with lengths weights[...] at the same positions.
+// An undirected graph stores each edge in both directions.
+typedef struct Fib_Csr_Graph {
+    size_t n;                // Vertices
+    size_t m;                // Edges: offsets[n] == m
+    const int64_t *offsets;  // n + 1 entries
+    const int64_t *targets;  // m entries
+    const int64_t *weights;  // m entries
+} Fib_Csr_Graph;
+
+#define FIB_GRAPH_NONE (-1)             // Distance and predecessor of a vertex not reached
+#define FIB_GRAPH_NO_TARGET SIZE_MAX    // Search the whole graph
+#define FIB_GRAPH_NO_RADIUS INT64_MAX   // No bound on the distance
+
+// Returns true if 'g' is well formed: offsets start at 0, never decrease and end at m, every
+// target is a vertex and, unless 'negative_weights' is true, no weight is negative. The
+// algorithms below assume this; only prim_fib_heap allows negative weights.
+bool check_csr_graph(const Fib_Csr_Graph *g, bool negative_weights);
+
+// Dijkstra's algorithm from 'source'. Fills dist_out[v] with the length of a shortest path
+// to v and pred_out[v] with the vertex before v on it (FIB_GRAPH_NONE for the source), for
+// every vertex settled by the search; both are FIB_GRAPH_NONE for the others. The search
+// stops early once 'target' is settled (FIB_GRAPH_NO_TARGET: never), and skips every path
+// longer than 'radius' (FIB_GRAPH_NO_RADIUS: none), which also leaves out distances that
+// would overflow int64. Each vertex is inserted once, when first reached: O(m + n log n).
+// Returns false if source or target is not a vertex, radius is negative or allocation
+// failed.
+bool dijkstra_fib_heap(const Fib_Csr_Graph *g, size_t source, size_t target, int64_t radius,
+                       int64_t *dist_out, int64_t *pred_out);
+
+// Prim's algorithm: a minimum spanning forest of an undirected graph, which 'g' must store
+// with every edge in both directions (this is not checked). The tree of 'root' is grown
+// first, then those of the other components in order of their smallest vertex. Fills
+// parent_out[v] with v's parent and weight_out[v] with the weight of the edge to it; every
+// root has parent FIB_GRAPH_NONE and weight 0. A vertex enters the heap when first reached
+// and each lighter edge to it is one decrease_key: O(m + n log n).
+// Returns false if root is not a vertex or allocation failed.
+bool prim_fib_heap(const Fib_Csr_Graph *g, size_t root, int64_t *parent_out, int64_t *weight_out);
+
+// --- A* on grids ---
+// A grid is an implicit graph: cell (x, y) has id y * width + x and a cost from 1 to 255 for
+// entering it, 0 marking a blocked cell. A straight step into a cell of cost c costs
+// c * FIB_GRID_STRAIGHT, a diagonal step c * FIB_GRID_DIAGONAL; a diagonal step may not cut
+// the corner of a blocked cell. The heuristics assume the cheapest cost of 1:
+//   FIB_GRID_MANHATTAN  (dx + dy) straight steps; exact lower bound for 4-connected grids only,
+//                       on 8-connected grids paths found are not always shortest
+//   FIB_GRID_OCTILE     the cheapest mix of straight and diagonal steps; for 8-connected grids
+//   FIB_GRID_EUCLIDEAN  straight-line distance; admissible for both, but weaker than the others
+// All three are consistent where admissible, so no cell is expanded twice.
+
+#define FIB_GRID_STRAIGHT 1000
+#define FIB_GRID_DIAGONAL 1415  // 1000 * sqrt(2), rounded up so EUCLIDEAN stays admissible
+#define FIB_GRID_MANHATTAN 0
+#define FIB_GRID_OCTILE 1
+#define FIB_GRID_EUCLIDEAN 2
+#define FIB_GRID_NO_BUDGET SIZE_MAX
+
+typedef struct Fib_Grid {
+    const uint8_t *cells;  // width * height costs, row by row
+    size_t width;
+    size_t height;
+    bool diagonal;         // 8-connected instead of 4-connected
+} Fib_Grid;
+
+typedef struct Fib_Grid_Path {
+    int64_t *cells;    // Cell ids from start to goal, allocated with malloc (free() it); NULL if none
+    size_t length;
+    int64_t cost;      // Sum of the step costs, or FIB_GRAPH_NONE without a path
+    size_t expanded;   // Cells taken from the open set
+    bool exhausted;    // The budget ran out before the goal was reached
+} Fib_Grid_Path;
+
+// A* from cell 'start' to cell 'goal'. Every cell reached keeps its heap node in an array
+// indexed by cell id, so a cheaper way to an open cell is one decrease_key. At most 'budget'
+// cells are expanded (FIB_GRID_NO_BUDGET: no limit); if the goal was not among them,
+// path_out->exhausted is set and no path is returned. A blocked start or goal has no path.
+// Returns false if start, goal or the heuristic is invalid, the grid is too large for int64
+// costs, or allocation failed.
+bool astar_grid_fib_heap(const Fib_Grid *grid, size_t start, size_t goal, int heuristic, size_t budget,
+                         Fib_Grid_Path *path_out);
+
+#endif // FIBONACCI_GRAPH_H
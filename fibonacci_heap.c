@@ -1,23 +1,52 @@
 #include <stdbool.h>
 #include <stddef.h>
+#include <limits.h>
 #include <stdlib.h> // Added for malloc
-#include <string.h> // Added for memset
-#include <math.h>   // Added for log2 (though using fixed size array for now)
-#include <limits.h> // Added for INT_MIN
-#include <stdio.h>  // Added for fprintf in delete_fib_node
+#include <string.h> // Added for memset and memcpy
+#include <stdalign.h>
 #include "fibonacci_heap.h"
 
 // Struct definitions are now in fibonacci_heap.h
 
 // Forward declarations for helper functions
+static Fibonacci_Node *alloc_fib_node(Fibonacci_Heap *fh);
+static void free_fib_node(Fibonacci_Heap *fh, Fibonacci_Node *node);
+static Fibonacci_Node *insert_fib_node(Fibonacci_Heap *fh, Fibonacci_Node *new_node);
+static void decrease_fib_node(Fibonacci_Heap *fh, Fibonacci_Node *node);
+static Fibonacci_Node *remove_min_fib_node(Fibonacci_Heap *fh);
+static Fibonacci_Node *remove_min_bounded_fib_node(Fibonacci_Heap *fh);
+static Fibonacci_Node *remove_fib_node(Fibonacci_Heap *fh, Fibonacci_Node *node);
 static void link_fib_nodes(Fibonacci_Heap *fh, Fibonacci_Node *y, Fibonacci_Node *x);
 static void consolidate_fib_heap(Fibonacci_Heap *fh);
 static void cut_fib_node(Fibonacci_Heap *fh, Fibonacci_Node *x, Fibonacci_Node *y);
 static void cascading_cut_fib_node(Fibonacci_Heap *fh, Fibonacci_Node *y);
-static Fibonacci_Node* find_node_by_value_recursive(Fibonacci_Node *start_node, int value_to_find, Fibonacci_Node *head_of_list_to_avoid_revisit_in_circular_search);
+static bool index_fib_node(Fibonacci_Heap *fh, Fibonacci_Node *node);
+static void unindex_fib_node(Fibonacci_Heap *fh, Fibonacci_Node *node);
+static bool merge_index_fib_heap(Fibonacci_Heap *dst, Fibonacci_Heap *src);
+static void reset_fib_node_pool(Fibonacci_Node_Pool *pool);
+static bool reserve_degree_table_fib_heap(Fibonacci_Heap *fh, size_t n);
+static Fibonacci_Node *alloc_fib_node_run(Fibonacci_Heap *fh, size_t count);
+static void splice_root_list_fib_heap(Fibonacci_Heap *fh, Fibonacci_Node *list, Fibonacci_Node *list_min);
+static void add_pending_root_fib_heap(Fibonacci_Heap *fh, Fibonacci_Node *x);
+static void unlink_root_fib_heap(Fibonacci_Heap *fh, Fibonacci_Node *x);
+static bool step_consolidation_fib_heap(Fibonacci_Heap *fh);
+static void advance_consolidation_fib_heap(Fibonacci_Heap *fh);
+static void reset_consolidation_fib_heap(Fibonacci_Heap *fh);
+static void lock_insert_buffer(Fibonacci_Insert_Buffer *buffer);
+static void unlock_insert_buffer(Fibonacci_Insert_Buffer *buffer);
+static bool merge_insert_buffer_fib_heap(Fibonacci_Heap *fh, Fibonacci_Insert_Buffer *buffer);
+static void release_fib_node_chunks(Fibonacci_Heap *fh, Fibonacci_Node_Chunk *chunk);
 
 // Function to create an empty Fibonacci heap
 Fibonacci_Heap *create_fib_heap() {
+    return create_fib_heap_ex(NULL, sizeof(Fibonacci_Key));
+}
+
+// Function to create an empty Fibonacci heap with a custom key type
+Fibonacci_Heap *create_fib_heap_ex(Fibonacci_Compare compare, size_t key_size) {
+    if (key_size == 0 || (compare == NULL && key_size != sizeof(Fibonacci_Key))) {
+        return NULL; // The built-in ordering only understands Fibonacci_Key
+    }
     Fibonacci_Heap *heap = (Fibonacci_Heap *)malloc(sizeof(Fibonacci_Heap));
     if (heap == NULL) {
         return NULL; // Memory allocation failed
@@ -25,31 +54,424 @@ Fibonacci_Heap *create_fib_heap() {
     heap->min = NULL;
     heap->n = 0;
     heap->root_list = NULL;
+    heap->free_payload = NULL;
+    heap->compare = compare;
+    heap->key_size = key_size;
+    heap->index = NULL;
+    heap->degree_table = NULL;
+    heap->degree_table_size = 0;
+    heap->degree_table_max_n = 0;
+    heap->consolidate_budget = 0;
+    heap->pending = NULL;
+    heap->carry = NULL;
+    heap->consolidate_debt = 0;
+    atomic_init(&heap->buffers, NULL);
+    heap->pool.node_size = sizeof(Fibonacci_Node);
+    reset_fib_node_pool(&heap->pool);
+    if (key_size > sizeof(Fibonacci_Key)) {
+        // Wide keys follow the node, padded so the next node stays aligned
+        size_t align = alignof(Fibonacci_Node);
+        heap->pool.node_size += (key_size + align - 1) / align * align;
+    }
     return heap;
 }
 
-// Function to insert a new node into the Fibonacci heap
-bool insert_fib_heap(Fibonacci_Heap *fh, void *data) {
-    // Assumes data is a dynamically allocated int* from the wrapper
-    if (fh == NULL) {
-        return false; // Heap does not exist
+// Helper to reach the bytes of a node's key
+static inline void *fib_node_key_ptr(const Fibonacci_Heap *fh, Fibonacci_Node *node) {
+    if (fh->key_size <= sizeof(Fibonacci_Key)) {
+        return &node->key;
     }
+    return (void *)(node + 1);
+}
 
-    // 1. Allocate memory for a new Fibonacci_Node
-    Fibonacci_Node *new_node = (Fibonacci_Node *)malloc(sizeof(Fibonacci_Node));
-    if (new_node == NULL) {
-        return false; // Memory allocation failed
+const void *get_key_fib_node(const Fibonacci_Heap *fh, const Fibonacci_Node *node) {
+    if (fh == NULL || node == NULL) {
+        return NULL;
+    }
+    return fib_node_key_ptr(fh, (Fibonacci_Node *)node);
+}
+
+// Helper returning true if x's key orders strictly before y's key.
+// Every key comparison in the heap goes through here.
+static inline bool fib_less(const Fibonacci_Heap *fh, Fibonacci_Node *x, Fibonacci_Node *y) {
+    if (fh->compare == NULL) {
+        return x->key < y->key;
+    }
+    return fh->compare(fib_node_key_ptr(fh, x), fib_node_key_ptr(fh, y)) < 0;
+}
+
+// Helper function to make sure consolidate's degree table fits a heap of n nodes.
+// A root of degree k holds at least F(k+2) nodes (F being the Fibonacci numbers), so
+// degrees stay at or below floor(log_phi n) and floor(log_phi n) + 2 slots are plenty.
+static bool reserve_degree_table_fib_heap(Fibonacci_Heap *fh, size_t n) {
+    if (n <= (size_t)fh->degree_table_max_n) {
+        return true;
+    }
+
+    // a. Find the largest degree k with F(k+2) <= n
+    uint64_t f_k2 = 1, f_k3 = 2; // F(k+2) and F(k+3), starting at k = 0
+    int k = 0;
+    while (f_k3 <= n) {
+        uint64_t next = f_k2 + f_k3;
+        f_k2 = f_k3;
+        f_k3 = next;
+        k++;
+    }
+
+    // b. Grow the table, keeping it all NULL
+    int size = k + 2;
+    if (size > fh->degree_table_size) {
+        Fibonacci_Node **table = (Fibonacci_Node **)realloc(fh->degree_table, (size_t)size * sizeof(Fibonacci_Node *));
+        if (table == NULL) {
+            return false; // Memory allocation failed, the old table is untouched
+        }
+        memset(table + fh->degree_table_size, 0, (size_t)(size - fh->degree_table_size) * sizeof(Fibonacci_Node *));
+        fh->degree_table = table;
+        fh->degree_table_size = size;
     }
+    fh->degree_table_max_n = f_k3 - 1 > INT_MAX ? INT_MAX : (int)(f_k3 - 1);
+    return true;
+}
+
+// Helper function to take a node from the heap's pool
+static Fibonacci_Node *alloc_fib_node(Fibonacci_Heap *fh) {
+    Fibonacci_Node_Pool *pool = &fh->pool;
+
+    // a. Reuse a recycled node if there is one
+    if (pool->free_list != NULL) {
+        Fibonacci_Node *node = pool->free_list;
+        pool->free_list = node->right;
+        if (pool->free_list == NULL) {
+            pool->free_tail = NULL;
+        }
+        return node;
+    }
+
+    // b. Otherwise bump-allocate from the newest chunk, adding a chunk when it is full
+    Fibonacci_Node_Chunk *chunk = pool->chunks;
+    if (chunk == NULL || chunk->used == chunk->capacity) {
+        size_t capacity = pool->next_chunk_capacity;
+        chunk = (Fibonacci_Node_Chunk *)malloc(sizeof(Fibonacci_Node_Chunk) + capacity * pool->node_size);
+        if (chunk == NULL) {
+            return NULL; // Memory allocation failed
+        }
+        chunk->capacity = capacity;
+        chunk->used = 0;
+        chunk->next = pool->chunks;
+        if (pool->chunks == NULL) {
+            pool->chunks_tail = chunk;
+        }
+        pool->chunks = chunk;
+        if (capacity < FIB_POOL_MAX_CHUNK) {
+            pool->next_chunk_capacity = capacity * 2;
+        }
+    }
+    return (Fibonacci_Node *)((char *)chunk->nodes + pool->node_size * chunk->used++);
+}
+
+// Helper function to take 'count' adjacent nodes (pool.node_size bytes apart) from the pool.
+// Recycled nodes are not contiguous, so runs always come from fresh chunk space.
+static Fibonacci_Node *alloc_fib_node_run(Fibonacci_Heap *fh, size_t count) {
+    Fibonacci_Node_Pool *pool = &fh->pool;
+
+    // a. Bump-allocate from the newest chunk if the whole run fits
+    Fibonacci_Node_Chunk *chunk = pool->chunks;
+    if (chunk != NULL && chunk->capacity - chunk->used >= count) {
+        Fibonacci_Node *run = (Fibonacci_Node *)((char *)chunk->nodes + pool->node_size * chunk->used);
+        chunk->used += count;
+        return run;
+    }
+
+    // b. Otherwise give the run a chunk of its own
+    size_t capacity = count > pool->next_chunk_capacity ? count : pool->next_chunk_capacity;
+    if (capacity > (SIZE_MAX - sizeof(Fibonacci_Node_Chunk)) / pool->node_size) {
+        return NULL; // Size overflow
+    }
+    chunk = (Fibonacci_Node_Chunk *)malloc(sizeof(Fibonacci_Node_Chunk) + capacity * pool->node_size);
+    if (chunk == NULL) {
+        return NULL; // Memory allocation failed
+    }
+    chunk->capacity = capacity;
+    chunk->used = count;
+    if (pool->chunks == NULL) {
+        chunk->next = NULL;
+        pool->chunks = chunk;
+        pool->chunks_tail = chunk;
+    } else if (capacity == count) {
+        // Full already: append it, so the newest chunk keeps serving single allocations
+        chunk->next = NULL;
+        pool->chunks_tail->next = chunk;
+        pool->chunks_tail = chunk;
+    } else {
+        chunk->next = pool->chunks;
+        pool->chunks = chunk;
+    }
+    if (capacity < FIB_POOL_MAX_CHUNK) {
+        pool->next_chunk_capacity = capacity * 2 < FIB_POOL_MAX_CHUNK ? capacity * 2 : FIB_POOL_MAX_CHUNK;
+    }
+    return (Fibonacci_Node *)chunk->nodes;
+}
+
+// Helper function to return a node to the heap's pool
+static void free_fib_node(Fibonacci_Heap *fh, Fibonacci_Node *node) {
+    node->degree = -1; // Marks the slot as free for destroy_fib_heap
+    node->payload = NULL;
+    node->right = fh->pool.free_list;
+    if (fh->pool.free_list == NULL) {
+        fh->pool.free_tail = node;
+    }
+    fh->pool.free_list = node;
+}
+
+// Helper function to empty a pool without releasing its chunks (they are owned elsewhere)
+static void reset_fib_node_pool(Fibonacci_Node_Pool *pool) {
+    pool->chunks = NULL;
+    pool->chunks_tail = NULL;
+    pool->free_list = NULL;
+    pool->free_tail = NULL;
+    pool->next_chunk_capacity = FIB_POOL_MIN_CHUNK;
+}
+
+// Function to meld two Fibonacci heaps
+bool meld_fib_heap(Fibonacci_Heap *dst, Fibonacci_Heap *src) {
+    // a. Only heaps with the same key layout can share nodes
+    if (dst == NULL || src == NULL || dst == src) {
+        return false;
+    }
+    if (dst->compare != src->compare || dst->key_size != src->key_size) {
+        return false;
+    }
+    if (atomic_load_explicit(&src->buffers, memory_order_acquire) != NULL) {
+        return false; // Producers may still be filling chunks of src's buffers
+    }
+    if (src->n > INT_MAX - dst->n) {
+        return false; // dst->n would overflow
+    }
+
+    // b. Grow dst's degree table and bring its index up to date first, the only steps that can fail
+    if (!reserve_degree_table_fib_heap(dst, (size_t)dst->n + (size_t)src->n)) {
+        return false;
+    }
+    if (dst->index != NULL && !merge_index_fib_heap(dst, src)) {
+        return false;
+    }
+    if (src->index != NULL) {
+        clear_fibonacci_index(src->index);
+    }
+
+    // c. Splice the two circular root lists next to each other. src's filing state goes away:
+    // for dst all of src's roots are unfiled, and a budget has to pay for each of them.
+    if (src->consolidate_budget > 0) {
+        reset_consolidation_fib_heap(src);
+    }
+    if (src->min != NULL) {
+        if (dst->consolidate_budget > 0) {
+            Fibonacci_Node *root = src->min;
+            do {
+                dst->consolidate_debt += 3;
+                root = root->right;
+            } while (root != src->min);
+        }
+        splice_root_list_fib_heap(dst, src->min, src->min);
+    }
+    dst->n += src->n;
+
+    // d. Hand src's chunks and recycled nodes over to dst's pool. dst's newest chunk
+    // stays first so bump allocation continues where it was.
+    Fibonacci_Node_Pool *to = &dst->pool, *from = &src->pool;
+    if (from->chunks != NULL) {
+        if (to->chunks == NULL) {
+            to->chunks = from->chunks;
+            to->next_chunk_capacity = from->next_chunk_capacity;
+        } else {
+            to->chunks_tail->next = from->chunks;
+        }
+        to->chunks_tail = from->chunks_tail;
+    }
+    if (from->free_list != NULL) {
+        if (to->free_list == NULL) {
+            to->free_list = from->free_list;
+        } else {
+            to->free_tail->right = from->free_list;
+        }
+        to->free_tail = from->free_tail;
+    }
+
+    // e. Leave src empty
+    reset_fib_node_pool(from);
+    src->min = NULL;
+    src->root_list = NULL;
+    src->n = 0;
+    advance_consolidation_fib_heap(dst);
+    return true;
+}
+
+// Helper function to splice a circular list of roots into the root list, next to the minimum
+// (or, with a consolidation budget, at the end among the pending roots).
+// 'list_min' is the smallest node of 'list'; fh->n and the consolidation debt are left to the caller.
+static void splice_root_list_fib_heap(Fibonacci_Heap *fh, Fibonacci_Node *list, Fibonacci_Node *list_min) {
+    if (fh->consolidate_budget > 0 && fh->pending == NULL) {
+        fh->pending = list;
+    }
+    if (fh->root_list == NULL) {
+        fh->min = list_min;
+        fh->root_list = list;
+        return;
+    }
+    Fibonacci_Node *prev = fh->consolidate_budget > 0 ? fh->root_list->left : fh->min;
+    Fibonacci_Node *next = prev->right;
+    Fibonacci_Node *list_last = list->left;
+    prev->right = list;
+    list->left = prev;
+    list_last->right = next;
+    next->left = list_last;
+    if (fib_less(fh, list_min, fh->min)) {
+        fh->min = list_min;
+    }
+}
+
+// Helper function to append a detached node to the pending roots of a heap with a budget
+static void add_pending_root_fib_heap(Fibonacci_Heap *fh, Fibonacci_Node *x) {
+    x->parent = NULL;
+    x->marked = false;
+    x->left = x;
+    x->right = x;
+    splice_root_list_fib_heap(fh, x, x);
+    fh->consolidate_debt += 3; // Picking it, filing it and one link, see set_consolidate_budget_fib_heap
+}
+
+// Helper function to take a root out of the root list of a heap with a budget, along with
+// whatever filing state refers to it. The node is left as a one-node circular list.
+static void unlink_root_fib_heap(Fibonacci_Heap *fh, Fibonacci_Node *x) {
+    // a. Pending roots run from fh->pending to the end of the list
+    if (fh->pending == x) {
+        fh->pending = x->right == fh->root_list ? NULL : x->right;
+    }
+    if (fh->root_list == x) {
+        fh->root_list = x->right == x ? NULL : x->right;
+    }
+
+    // b. Filed roots are found through the table
+    if (fh->carry == x) {
+        fh->carry = NULL;
+    } else if (fh->degree_table[x->degree] == x) {
+        fh->degree_table[x->degree] = NULL;
+    }
+
+    x->left->right = x->right;
+    x->right->left = x->left;
+    x->left = x;
+    x->right = x;
+}
+
+// Helper function to do one step of incremental consolidation. Returns false if every root
+// is filed already.
+// The roots ahead of fh->pending are filed in fh->degree_table (one per degree) or are the
+// carry, a root on its way into the table that is linked with the entry of its degree
+// one step at a time, like a carry rippling through a binary counter.
+static bool step_consolidation_fib_heap(Fibonacci_Heap *fh) {
+    Fibonacci_Node **A = fh->degree_table;
+
+    // a. Without a carry, take the first pending root; it already sits where filed roots go
+    Fibonacci_Node *x = fh->carry;
+    if (x == NULL) {
+        if (fh->pending == NULL) {
+            return false;
+        }
+        x = fh->pending;
+        fh->pending = x->right == fh->root_list ? NULL : x->right;
+        fh->carry = x;
+        return true;
+    }
+
+    // b. File the carry if its degree is free
+    int d = x->degree;
+    Fibonacci_Node *y = A[d];
+    if (y == NULL) {
+        A[d] = x;
+        fh->carry = NULL;
+        return true;
+    }
+
+    // c. Otherwise link it with the filed root of the same degree; the winner carries on
+    if (fib_less(fh, y, x)) {
+        Fibonacci_Node *temp_node = x;
+        x = y;
+        y = temp_node;
+    }
+    unlink_root_fib_heap(fh, y); // Clears A[d] or the carry, whichever y was
+    A[d] = NULL;
+    link_fib_nodes(fh, y, x);
+    fh->carry = x;
+    if (fh->min == y) {
+        fh->min = x; // Equal keys: the minimum must stay a root
+    }
+    return true;
+}
+
+// Helper function to spend an operation's consolidation budget, plus the steps owed for the
+// roots it added
+static void advance_consolidation_fib_heap(Fibonacci_Heap *fh) {
+    if (fh->consolidate_budget == 0) {
+        return;
+    }
+    size_t steps = (size_t)fh->consolidate_budget + fh->consolidate_debt;
+    fh->consolidate_debt = 0;
+    while (steps-- > 0 && step_consolidation_fib_heap(fh)) {
+    }
+}
 
-    // 2. Initialize the new node
-    new_node->key = data;
+// Helper function to forget which roots are filed: afterwards every root is simply a root
+static void reset_consolidation_fib_heap(Fibonacci_Heap *fh) {
+    if (fh->degree_table != NULL) {
+        memset(fh->degree_table, 0, (size_t)fh->degree_table_size * sizeof(Fibonacci_Node *));
+    }
+    fh->pending = NULL;
+    fh->carry = NULL;
+    fh->consolidate_debt = 0;
+}
+
+bool set_consolidate_budget_fib_heap(Fibonacci_Heap *fh, int budget) {
+    if (fh == NULL || budget < 0) {
+        return false;
+    }
+    if (budget == 0) {
+        // a. Back to lazy consolidation, which expects an all-NULL table
+        if (fh->consolidate_budget > 0) {
+            reset_consolidation_fib_heap(fh);
+        }
+    } else if (fh->consolidate_budget == 0 && fh->root_list != NULL) {
+        // b. Consolidate once, then every root has a degree of its own and can be filed
+        consolidate_fib_heap(fh);
+        Fibonacci_Node *root = fh->root_list;
+        do {
+            fh->degree_table[root->degree] = root;
+            root = root->right;
+        } while (root != fh->root_list);
+        fh->pending = NULL;
+        fh->carry = NULL;
+        fh->consolidate_debt = 0;
+    }
+    fh->consolidate_budget = budget;
+    return true;
+}
+
+// Helper function to add an initialized, detached node to the root list
+static Fibonacci_Node *insert_fib_node(Fibonacci_Heap *fh, Fibonacci_Node *new_node) {
+    // 1. Initialize the structural fields
     new_node->degree = 0;
     new_node->marked = false;
     new_node->parent = NULL;
     new_node->child = NULL;
     // new_node->left and new_node->right are set below
 
-    // 3. Add the new node to the root list
+    // 2. Add the new node to the root list
+    if (fh->consolidate_budget > 0) {
+        add_pending_root_fib_heap(fh, new_node);
+        fh->n++;
+        advance_consolidation_fib_heap(fh);
+        return new_node;
+    }
     if (fh->min == NULL) { // If the heap is empty
         fh->min = new_node;
         new_node->left = new_node;
@@ -66,215 +488,509 @@ bool insert_fib_heap(Fibonacci_Heap *fh, void *data) {
         // unless it was NULL, but that's covered by fh->min == NULL case.
     }
 
-    // 4. Update fh->min if the new node's key is smaller
-    if (fh->min == NULL || *(int *)(new_node->key) < *(int *)(fh->min->key)) {
+    // 3. Update fh->min if the new node's key is smaller
+    if (fib_less(fh, new_node, fh->min)) {
         fh->min = new_node;
     }
 
-    // 5. Increment fh->n
+    // 4. Increment fh->n
     fh->n++;
 
+    return new_node;
+}
+
+// Function to insert a new key into the Fibonacci heap
+Fibonacci_Node *insert_fib_heap_key(Fibonacci_Heap *fh, Fibonacci_Key key, void *payload) {
+    if (fh == NULL || fh->compare != NULL) {
+        return NULL; // Heap does not exist or is not keyed by Fibonacci_Key
+    }
+    if (fh->n == INT_MAX || !reserve_degree_table_fib_heap(fh, (size_t)fh->n + 1)) {
+        return NULL;
+    }
+
+    Fibonacci_Node *new_node = alloc_fib_node(fh);
+    if (new_node == NULL) {
+        return NULL; // Memory allocation failed
+    }
+    new_node->key = key;
+    new_node->payload = payload;
+    if (!index_fib_node(fh, new_node)) {
+        free_fib_node(fh, new_node);
+        return NULL; // Growing the index failed
+    }
+    return insert_fib_node(fh, new_node);
+}
+
+// Function to insert a key of any type into the Fibonacci heap
+Fibonacci_Node *insert_fib_heap_ex(Fibonacci_Heap *fh, const void *key, void *payload) {
+    if (fh == NULL || key == NULL) {
+        return NULL;
+    }
+    if (fh->n == INT_MAX || !reserve_degree_table_fib_heap(fh, (size_t)fh->n + 1)) {
+        return NULL;
+    }
+
+    Fibonacci_Node *new_node = alloc_fib_node(fh);
+    if (new_node == NULL) {
+        return NULL; // Memory allocation failed
+    }
+    memcpy(fib_node_key_ptr(fh, new_node), key, fh->key_size);
+    new_node->payload = payload;
+    if (!index_fib_node(fh, new_node)) {
+        free_fib_node(fh, new_node);
+        return NULL; // Growing the index failed
+    }
+    return insert_fib_node(fh, new_node);
+}
+
+// Function to insert many keys at once
+bool insert_many_fib_heap(Fibonacci_Heap *fh, const Fibonacci_Key *keys, size_t count) {
+    if (fh == NULL || fh->compare != NULL || (keys == NULL && count > 0)) {
+        return false;
+    }
+    if (count == 0) {
+        return true;
+    }
+    if (count > (size_t)(INT_MAX - fh->n)) {
+        return false; // fh->n would overflow
+    }
+
+    // a. Everything that can fail happens before the heap is touched
+    if (!reserve_degree_table_fib_heap(fh, (size_t)fh->n + count)) {
+        return false;
+    }
+    if (fh->index != NULL && !reserve_fibonacci_index(fh->index, count)) {
+        return false;
+    }
+    Fibonacci_Node *first = alloc_fib_node_run(fh, count);
+    if (first == NULL) {
+        return false;
+    }
+
+    // b. Initialize the nodes and chain them into one circular list, tracking its minimum
+    size_t stride = fh->pool.node_size;
+    Fibonacci_Node *list_min = first, *prev = NULL, *node = first;
+    for (size_t i = 0; i < count; i++, node = (Fibonacci_Node *)((char *)node + stride)) {
+        node->key = keys[i];
+        node->payload = NULL;
+        node->degree = 0;
+        node->marked = false;
+        node->parent = NULL;
+        node->child = NULL;
+        node->left = prev;
+        if (prev != NULL) {
+            prev->right = node;
+        }
+        if (node->key < list_min->key) {
+            list_min = node;
+        }
+        if (fh->index != NULL) {
+            insert_fibonacci_index(fh->index, node->key, node); // Cannot fail after the reserve
+        }
+        prev = node;
+    }
+    prev->right = first;
+    first->left = prev;
+
+    // c. One splice puts all of them into the root list; consolidation is left to extract_min,
+    // or with a budget paid for right away
+    splice_root_list_fib_heap(fh, first, list_min);
+    fh->n += (int)count;
+    if (fh->consolidate_budget > 0) {
+        fh->consolidate_debt += 3 * count;
+        advance_consolidation_fib_heap(fh);
+    }
+    return true;
+}
+
+// Pointer API insert: the int behind 'data' becomes the key, 'data' becomes the payload
+bool insert_fib_heap(Fibonacci_Heap *fh, void *data) {
+    if (fh == NULL || data == NULL || fh->compare != NULL) {
+        return false;
+    }
+    return insert_fib_heap_key(fh, *(int *)data, data) != NULL;
+}
+
+// Function to register a producer insert buffer with the heap
+Fibonacci_Insert_Buffer *create_insert_buffer_fib_heap(Fibonacci_Heap *fh) {
+    if (fh == NULL || fh->compare != NULL) {
+        return NULL; // Buffered nodes are built without the heap, so keys must be plain Fibonacci_Keys
+    }
+    // sizeof(Fibonacci_Insert_Buffer) is a multiple of the cache line, as aligned_alloc requires
+    Fibonacci_Insert_Buffer *buffer = (Fibonacci_Insert_Buffer *)aligned_alloc(FIB_CACHE_LINE, sizeof(Fibonacci_Insert_Buffer));
+    if (buffer == NULL) {
+        return NULL; // Memory allocation failed
+    }
+    atomic_flag_clear(&buffer->lock);
+    buffer->list = NULL;
+    buffer->list_min = NULL;
+    atomic_init(&buffer->count, 0);
+    buffer->chunk = NULL;
+    buffer->retired = NULL;
+    buffer->retired_tail = NULL;
+    buffer->next_chunk_capacity = FIB_POOL_MIN_CHUNK;
+    buffer->merged_chunk = NULL;
+    buffer->merged_used = 0;
+
+    // Producers may register while the consumer walks the list, so the new buffer is
+    // published with a single compare-and-swap at the head
+    Fibonacci_Insert_Buffer *head = atomic_load_explicit(&fh->buffers, memory_order_relaxed);
+    do {
+        buffer->next = head;
+    } while (!atomic_compare_exchange_weak_explicit(&fh->buffers, &head, buffer, memory_order_release, memory_order_relaxed));
+    return buffer;
+}
+
+// Helper function to take a buffer's lock. Only the producer and the consumer ever take it,
+// each for a few pointer updates, so spinning is cheaper than sleeping.
+static void lock_insert_buffer(Fibonacci_Insert_Buffer *buffer) {
+    while (atomic_flag_test_and_set_explicit(&buffer->lock, memory_order_acquire)) {
+    }
+}
+
+static void unlock_insert_buffer(Fibonacci_Insert_Buffer *buffer) {
+    atomic_flag_clear_explicit(&buffer->lock, memory_order_release);
+}
+
+// Function to insert a key through a producer's buffer
+bool insert_buffered_fib_heap(Fibonacci_Insert_Buffer *buffer, Fibonacci_Key key, void *payload) {
+    if (buffer == NULL) {
+        return false;
+    }
+
+    // a. Only this thread changes 'chunk' and its 'used', so the node is carved out and set
+    // up without the lock; a new chunk is allocated here too if the current one is full
+    Fibonacci_Node_Chunk *chunk = buffer->chunk;
+    Fibonacci_Node_Chunk *full = NULL;
+    if (chunk == NULL || chunk->used == chunk->capacity) {
+        size_t capacity = buffer->next_chunk_capacity;
+        Fibonacci_Node_Chunk *fresh = (Fibonacci_Node_Chunk *)malloc(sizeof(Fibonacci_Node_Chunk) + capacity * sizeof(Fibonacci_Node));
+        if (fresh == NULL) {
+            return false; // Memory allocation failed
+        }
+        fresh->next = NULL;
+        fresh->capacity = capacity;
+        fresh->used = 0;
+        if (capacity < FIB_POOL_MAX_CHUNK) {
+            buffer->next_chunk_capacity = capacity * 2;
+        }
+        full = chunk;
+        chunk = fresh;
+    }
+    Fibonacci_Node *node = &chunk->nodes[chunk->used];
+    node->key = key;
+    node->payload = payload;
+    node->degree = 0;
+    node->marked = false;
+    node->parent = NULL;
+    node->child = NULL;
+
+    // b. Hand the node (and a chunk that just filled up) over to the consumer side
+    lock_insert_buffer(buffer);
+    if (full != NULL) {
+        if (buffer->retired == NULL) {
+            buffer->retired = full;
+        } else {
+            buffer->retired_tail->next = full;
+        }
+        buffer->retired_tail = full;
+    }
+    buffer->chunk = chunk;
+    chunk->used++;
+    if (buffer->list == NULL) {
+        node->left = node;
+        node->right = node;
+        buffer->list = node;
+        buffer->list_min = node;
+    } else {
+        node->right = buffer->list;
+        node->left = buffer->list->left;
+        buffer->list->left->right = node;
+        buffer->list->left = node;
+        if (key < buffer->list_min->key) {
+            buffer->list_min = node;
+        }
+    }
+    atomic_store_explicit(&buffer->count, atomic_load_explicit(&buffer->count, memory_order_relaxed) + 1, memory_order_relaxed);
+    unlock_insert_buffer(buffer);
+    return true;
+}
+
+// Helper function to move one buffer's nodes into the heap (consumer side)
+static bool merge_insert_buffer_fib_heap(Fibonacci_Heap *fh, Fibonacci_Insert_Buffer *buffer) {
+    if (atomic_load_explicit(&buffer->count, memory_order_relaxed) == 0) {
+        return true; // Nothing new since the last merge, so the lock is not needed
+    }
+    lock_insert_buffer(buffer);
+    size_t count = atomic_load_explicit(&buffer->count, memory_order_relaxed);
+
+    // a. Make room in the heap first; if that fails the nodes stay buffered
+    if (count > (size_t)(INT_MAX - fh->n) || !reserve_degree_table_fib_heap(fh, (size_t)fh->n + count)
+        || (fh->index != NULL && !reserve_fibonacci_index(fh->index, count))) {
+        unlock_insert_buffer(buffer);
+        return false;
+    }
+
+    // b. Take the list and the full chunks. Of the producer's current chunk only the nodes
+    // handed out so far belong to the heap; the producer keeps bump-allocating past them.
+    Fibonacci_Node *list = buffer->list;
+    Fibonacci_Node *list_min = buffer->list_min;
+    Fibonacci_Node_Chunk *retired = buffer->retired;
+    Fibonacci_Node_Chunk *retired_tail = buffer->retired_tail;
+    buffer->list = NULL;
+    buffer->list_min = NULL;
+    atomic_store_explicit(&buffer->count, 0, memory_order_relaxed);
+    buffer->retired = NULL;
+    buffer->retired_tail = NULL;
+    buffer->merged_chunk = buffer->chunk;
+    buffer->merged_used = buffer->chunk->used;
+    unlock_insert_buffer(buffer);
+
+    // c. Full chunks join the heap's pool behind its newest chunk, which stays first for bump allocation
+    if (retired != NULL) {
+        if (fh->pool.chunks == NULL) {
+            fh->pool.chunks = retired;
+        } else {
+            fh->pool.chunks_tail->next = retired;
+        }
+        fh->pool.chunks_tail = retired_tail;
+    }
+
+    // d. One splice puts the whole list into the root list, as in insert_many_fib_heap
+    if (fh->index != NULL) {
+        Fibonacci_Node *node = list;
+        do {
+            insert_fibonacci_index(fh->index, node->key, node); // Cannot fail after the reserve
+            node = node->right;
+        } while (node != list);
+    }
+    splice_root_list_fib_heap(fh, list, list_min);
+    fh->n += (int)count;
+    if (fh->consolidate_budget > 0) {
+        fh->consolidate_debt += 3 * count;
+        advance_consolidation_fib_heap(fh);
+    }
     return true;
 }
 
+// Function to merge every producer buffer into the heap
+bool merge_insert_buffers_fib_heap(Fibonacci_Heap *fh) {
+    if (fh == NULL) {
+        return false;
+    }
+    bool merged = true;
+    Fibonacci_Insert_Buffer *buffer = atomic_load_explicit(&fh->buffers, memory_order_acquire);
+    for (; buffer != NULL; buffer = buffer->next) {
+        merged = merge_insert_buffer_fib_heap(fh, buffer) && merged;
+    }
+    return merged;
+}
+
+// Helper function to unlink any node from the heap without freeing it.
+// No sentinel key is needed: the node is cut up to the root list and made the minimum,
+// then removed exactly like extract_min would.
+static Fibonacci_Node *remove_fib_node(Fibonacci_Heap *fh, Fibonacci_Node *node) {
+    // a. Cut the node up to the root list
+    Fibonacci_Node *y = node->parent;
+    if (y != NULL) {
+        cut_fib_node(fh, node, y);
+        cascading_cut_fib_node(fh, y);
+    }
+
+    // b. Treat it as the minimum and remove it
+    fh->min = node;
+    return remove_min_fib_node(fh);
+}
+
 // Function to delete a specific node from the Fibonacci heap
-bool delete_node_fib_heap(Fibonacci_Heap *fh, Fibonacci_Node *node) {
+bool delete_node_fib_heap_key(Fibonacci_Heap *fh, Fibonacci_Node *node, Fibonacci_Key *key_out, void **payload_out) {
     // a. Handle NULL inputs
-    if (fh == NULL || node == NULL) {
+    if (fh == NULL || node == NULL || fh->compare != NULL) {
         return false;
     }
 
-    // b. Create a "negative infinity" key
-    int *neg_inf_key = (int *)malloc(sizeof(int));
-    if (!neg_inf_key) {
-        return false; // Memory allocation failed
-    }
-    *neg_inf_key = INT_MIN;
-
-    // c. Call decrease_key_fib_heap(fh, node, neg_inf_key)
-    // Note: The current decrease_key_fib_heap does not free the old key.
-    // This is a potential memory leak if the original key of 'node' was dynamically allocated
-    // and is not referenced elsewhere. For the purpose of this function, we assume
-    // that the key being replaced by neg_inf_key will be managed or is not a leak concern here,
-    // or that decrease_key should ideally handle freeing the old key if it takes ownership of the new one.
-    // Given the current API, `node->key` is simply overwritten.
-    // Let's store the old key to free it *if* decrease_key succeeds and the node's key was changed.
-    // However, the problem asks to free neg_inf_key, implying it's the one passed around.
-    // The current decrease_key will make node->key = neg_inf_key.
-    
-    void* old_key_of_node = node->key; // Store to potentially free if it's orphaned.
-                                     // This step is complex because we don't know if old_key_of_node
-                                     // should be freed by this function. Typically, data stored in a generic
-                                     // data structure is managed by the user.
-                                     // For the specific case of delete, the node (and its key) is being removed.
-                                     // If extract_min frees the node structure but returns the key,
-                                     // and if this key was `neg_inf_key`, then `neg_inf_key` is freed.
-                                     // What about the original `old_key_of_node`? It's now orphaned.
-                                     // This suggests that keys should probably always be freed by extract_min
-                                     // if they are considered "owned" by the heap.
-                                     // For now, let's follow the exact instructions which focus on neg_inf_key.
-    // MODIFIED logic for delete_node_fib_heap:
-    
-    void* original_key = node->key; // 1. Store original key
-
-    // 2. Create a new int* for INT_MIN
-    int *temp_min_key = (int *)malloc(sizeof(int));
-    if (temp_min_key == NULL) {
-        return false; // Allocation failed
-    }
-    *temp_min_key = INT_MIN;
-
-    // 3. Call decrease_key_fib_heap. decrease_key_fib_heap should not free the old key (original_key).
-    // It just replaces node->key with temp_min_key.
-    if (!decrease_key_fib_heap(fh, node, (void *)temp_min_key)) {
-        free(temp_min_key); // Decrease key failed, free the allocated temp_min_key
-        // original_key is still in the node.
+    // b. Unlink the node
+    if (remove_fib_node(fh, node) == NULL) {
         return false;
     }
-    // Now node->key is temp_min_key. The original_key is orphaned by the node.
+    unindex_fib_node(fh, node);
 
-    // 4. Free the original key
-    if (original_key != NULL) { // Should always be true if node was valid
-        free(original_key);
+    // c. Hand back what it held and recycle it
+    if (key_out != NULL) {
+        *key_out = node->key;
     }
+    if (payload_out != NULL) {
+        *payload_out = node->payload;
+    }
+    free_fib_node(fh, node);
+    return true;
+}
 
-    // 5. Call extract_min_fib_heap. This will extract the node with temp_min_key.
-    void *extracted_key_ptr = extract_min_fib_heap(fh);
+// Function to delete a specific node from a heap of any key type
+bool delete_node_fib_heap_ex(Fibonacci_Heap *fh, Fibonacci_Node *node, void *key_out, void **payload_out) {
+    if (fh == NULL || node == NULL) {
+        return false;
+    }
+    if (remove_fib_node(fh, node) == NULL) {
+        return false;
+    }
+    unindex_fib_node(fh, node);
+    if (key_out != NULL) {
+        memcpy(key_out, fib_node_key_ptr(fh, node), fh->key_size);
+    }
+    if (payload_out != NULL) {
+        *payload_out = node->payload;
+    }
+    free_fib_node(fh, node);
+    return true;
+}
 
-    // 6. Free the INT_MIN key that was extracted.
-    if (extracted_key_ptr == temp_min_key) {
-        free(extracted_key_ptr);
-    } else {
-        // This case indicates a problem: extract_min didn't return the temp_min_key.
-        // This could happen if another INT_MIN key was already in the heap or if decrease_key failed silently
-        // or if extract_min logic is flawed.
-        // We must free temp_min_key if it wasn't the one returned to avoid a leak.
-        if (temp_min_key != NULL) free(temp_min_key);
-        // And if extracted_key_ptr is something else, the caller of extract_min (this function)
-        // is responsible for it. If it's a user key, this would be a bug in logic.
-        // For now, we assume extracted_key_ptr IS temp_min_key.
-        // If it's not, we've already freed temp_min_key, and we let extracted_key_ptr leak if it's
-        // not a key that should be freed here (e.g. if it was another node's key, but that's very unlikely).
-        // This path suggests an error, so returning false might be appropriate or logging.
-        // For now, stick to freeing the temp_min_key if it wasn't returned.
-    }
-    
+// Pointer API delete: the removed payload goes to fh->free_payload, if set
+bool delete_node_fib_heap(Fibonacci_Heap *fh, Fibonacci_Node *node) {
+    void *payload = NULL;
+    if (!delete_node_fib_heap_key(fh, node, NULL, &payload)) {
+        return false;
+    }
+    if (fh->free_payload != NULL && payload != NULL) {
+        fh->free_payload(payload);
+    }
     return true;
 }
 
+// Function to delete a node by its key
+bool delete_fib_node_key(Fibonacci_Heap *fh, Fibonacci_Key key, void **payload_out) {
+    if (fh == NULL || fh->root_list == NULL || fh->compare != NULL) {
+        return false;
+    }
+
+    Fibonacci_Node *node_to_delete = find_node_fib_heap_key(fh, key);
+
+    if (node_to_delete == NULL) {
+        return false; // Node not found
+    }
+
+    return delete_node_fib_heap_key(fh, node_to_delete, NULL, payload_out);
+}
+
 // Function to delete a node by its data content (value)
 // 'data' is assumed to be an int* pointing to the value to delete.
 bool delete_fib_node(Fibonacci_Heap *fh, void *data) {
-    if (fh == NULL || data == NULL || fh->root_list == NULL) {
+    if (fh == NULL || data == NULL) {
+        return false;
+    }
+    void *payload = NULL;
+    if (!delete_fib_node_key(fh, *(int *)data, &payload)) {
         return false;
     }
-    int value_to_delete = *(int*)data;
+    if (fh->free_payload != NULL && payload != NULL) {
+        fh->free_payload(payload);
+    }
+    return true;
+}
 
-    Fibonacci_Node *node_to_delete = find_node_by_value_recursive(fh->root_list, value_to_delete, fh->root_list);
+// Moves 'node' to new_key in either direction. The node itself stays in the heap,
+// so pointers to it held by the caller remain valid.
+static bool change_fib_node(Fibonacci_Heap *fh, Fibonacci_Node *node, Fibonacci_Key new_key) {
+    if (new_key < node->key) {
+        // New value is smaller, use decrease_key logic.
+        return decrease_key_fib_heap_key(fh, node, new_key);
+    } else if (new_key > node->key) {
+        // New value is larger (increase key). Fibonacci heaps are not optimized for increase_key;
+        // unlink the node and put it back as a fresh root with the new key.
+        if (remove_fib_node(fh, node) == NULL) {
+            return false;
+        }
+        unindex_fib_node(fh, node);
+        node->key = new_key;
+        index_fib_node(fh, node); // Cannot fail: the entry just removed made room
+        insert_fib_node(fh, node);
+    }
+    return true; // Values are the same. No change needed.
+}
 
-    if (node_to_delete == NULL) {
+// Function to change the key of a node found by value
+bool change_fib_node_key(Fibonacci_Heap *fh, Fibonacci_Key old_key, Fibonacci_Key new_key) {
+    if (fh == NULL || fh->root_list == NULL || fh->compare != NULL) {
+        return false;
+    }
+
+    Fibonacci_Node *node_to_change = find_node_fib_heap_key(fh, old_key);
+    if (node_to_change == NULL) {
         return false; // Node not found
     }
 
-    return delete_node_fib_heap(fh, node_to_delete);
+    return change_fib_node(fh, node_to_change, new_key);
 }
 
 // Function to change the value of a node in the Fibonacci heap
 // old_val_ptr is an int* pointing to the value to find.
-// new_key_ptr_to_adopt is a new int* (allocated by wrapper) to be adopted by the node.
+// new_key_ptr_to_adopt is a new int* (allocated by caller) to be adopted as the node's payload.
 bool change_fib_node_value(Fibonacci_Heap *fh, void *old_val_ptr, void *new_key_ptr_to_adopt) {
-    if (fh == NULL || old_val_ptr == NULL || new_key_ptr_to_adopt == NULL || fh->root_list == NULL) {
-        if (new_key_ptr_to_adopt != NULL && old_val_ptr == NULL) { 
-            // If old_val_ptr is NULL, node cannot be found, new_key_ptr_to_adopt would leak if not freed by caller (wrapper).
-            // This case implies an error in arguments. The Python wrapper should handle freeing new_key_ptr_to_adopt if this function fails early.
-        }
-        return false;
+    if (fh == NULL || old_val_ptr == NULL || new_key_ptr_to_adopt == NULL || fh->root_list == NULL || fh->compare != NULL) {
+        return false; // Caller keeps ownership of new_key_ptr_to_adopt
     }
 
-    int value_to_find = *(int*)old_val_ptr;
-    int new_value = *(int*)new_key_ptr_to_adopt;
-
-    Fibonacci_Node *node_to_change = find_node_by_value_recursive(fh->root_list, value_to_find, fh->root_list);
-
+    Fibonacci_Node *node_to_change = find_node_fib_heap_key(fh, *(int *)old_val_ptr);
     if (node_to_change == NULL) {
-        // Node not found. Wrapper is responsible for freeing new_key_ptr_to_adopt.
+        return false; // Node not found. Caller keeps ownership of new_key_ptr_to_adopt.
+    }
+
+    void *original_payload = node_to_change->payload;
+    if (!change_fib_node(fh, node_to_change, *(int *)new_key_ptr_to_adopt)) {
         return false;
     }
 
-    // Store the original key of the node to free it after replacement.
-    void* original_node_key = node_to_change->key;
-    int original_node_key_value = *(int*)original_node_key; // Value before change
+    // The node now holds the new key; adopt the new box and drop the old one.
+    node_to_change->payload = new_key_ptr_to_adopt;
+    if (fh->free_payload != NULL && original_payload != NULL) {
+        fh->free_payload(original_payload);
+    }
+    return true;
+}
 
-    // Adopt the new key.
-    // node_to_change->key = new_key_ptr_to_adopt; // This is done by decrease_key or manually if increase
+// Function to get the minimum key from the Fibonacci heap
+bool get_min_fib_heap_key(Fibonacci_Heap *fh, Fibonacci_Key *key_out, void **payload_out) {
+    if (fh != NULL) {
+        merge_insert_buffers_fib_heap(fh);
+    }
+    if (fh == NULL || fh->min == NULL || fh->compare != NULL) {
+        return false; // Heap is empty or invalid
+    }
+    if (key_out != NULL) {
+        *key_out = fh->min->key;
+    }
+    if (payload_out != NULL) {
+        *payload_out = fh->min->payload;
+    }
+    return true;
+}
 
-    if (new_value < original_node_key_value) {
-        // New value is smaller, use decrease_key logic.
-        // decrease_key_fib_heap will set node_to_change->key = new_key_ptr_to_adopt.
-        if (decrease_key_fib_heap(fh, node_to_change, new_key_ptr_to_adopt)) {
-            free(original_node_key); // Free the old key after successful decrease_key
-            return true;
-        } else {
-            // decrease_key failed. The node's key is unchanged.
-            // Wrapper is responsible for freeing new_key_ptr_to_adopt.
-            return false;
-        }
-    } else if (new_value > original_node_key_value) {
-        // New value is larger (increase key). This is complex.
-        // Standard way: delete the node and re-insert the new value.
-        // delete_node_fib_heap will free original_node_key.
-        // We need to pass a pointer to new_value for re-insertion, which is new_key_ptr_to_adopt.
-        // This means delete_node_fib_heap must NOT free new_key_ptr_to_adopt if it's passed in somehow.
-        // This is tricky. Let's simplify:
-        // 1. Free the old key.
-        // 2. Set the node's key to the new key.
-        // 3. If parent exists and heap property violated (child > parent), it's an error or needs complex fixing.
-        //    Fibonacci heaps are not optimized for increase_key.
-        //    For now, we will just update the key. If this breaks heap structure for parent,
-        //    that's a limitation. A full "increase key" would involve removing from parent,
-        //    potentially adding to root list, and then potentially a cascading cut upwards on parent.
-        //    This is beyond typical decrease_key logic.
-        //    A simpler model for increase key: delete and re-insert.
-        //    Let's try delete and re-insert.
-        
-        // The value `value_to_find` (which is `original_node_key_value`) is what we need to delete.
-        // We already have the `node_to_change`.
-        if (delete_node_fib_heap(fh, node_to_change)) { // This will free original_node_key
-            // Now re-insert the new_key_ptr_to_adopt
-            if (insert_fib_heap(fh, new_key_ptr_to_adopt)) {
-                return true; // Successfully deleted and re-inserted
-            } else {
-                // Insertion failed. This is problematic. new_key_ptr_to_adopt was not inserted.
-                // Wrapper should free new_key_ptr_to_adopt.
-                // The heap is now in a state where a node was deleted.
-                return false; // Indicate error.
-            }
-        } else {
-            // Deletion failed. new_key_ptr_to_adopt has not been used. Wrapper should free it.
-            return false;
-        }
-    } else { // new_value == original_node_key_value
-        // Values are the same. No change needed.
-        // However, new_key_ptr_to_adopt was allocated by wrapper and needs to be freed as it won't be used.
-        // This function should not free it; the wrapper should if this returns true (or false) without adopting.
-        // For consistency, if no operation happens, the wrapper should free new_key_ptr_to_adopt.
-        // Let's return true, but the wrapper needs to know new_key_ptr_to_adopt wasn't consumed.
-        // This path is tricky for memory management of new_key_ptr_to_adopt.
-        // The Python wrapper will only free new_key_ptr_to_adopt if change_key fails.
-        // If it succeeds, it assumes new_key_ptr_to_adopt is consumed.
-        // So, if values are same, we must "consume" new_key_ptr_to_adopt and free original_node_key.
-        node_to_change->key = new_key_ptr_to_adopt;
-        free(original_node_key);
-        return true;
+// Function to get the minimum key from a heap of any key type
+bool get_min_fib_heap_ex(Fibonacci_Heap *fh, void *key_out, void **payload_out) {
+    if (fh != NULL) {
+        merge_insert_buffers_fib_heap(fh);
+    }
+    if (fh == NULL || fh->min == NULL) {
+        return false; // Heap is empty or invalid
+    }
+    if (key_out != NULL) {
+        memcpy(key_out, fib_node_key_ptr(fh, fh->min), fh->key_size);
     }
+    if (payload_out != NULL) {
+        *payload_out = fh->min->payload;
+    }
+    return true;
 }
 
-// Function to get the minimum key from the Fibonacci heap
+// Pointer API get_min: returns the payload of the minimum node
 void *get_min(Fibonacci_Heap *fh) {
+    if (fh != NULL) {
+        merge_insert_buffers_fib_heap(fh);
+    }
     if (fh == NULL || fh->min == NULL) {
         return NULL; // Heap is empty or invalid
     }
-    return fh->min->key;
+    return fh->min->payload;
 }
 
 // Helper function to link node y to node x as a child of x
@@ -315,174 +1031,176 @@ static void consolidate_fib_heap(Fibonacci_Heap *fh) {
         return;
     }
 
-    // Max degree is roughly log_phi(n). For simplicity, use a fixed large enough array.
-    // D(n) <= log_phi(n). For n = 2^64 (max for unsigned long long), log_phi(n) approx 92.
-    // A more common practical limit for competitive programming might be n ~ 10^6, log_phi(10^6) ~ 28.
-    // Let's use 64 as a fixed size, which should be safe for typical integer counts.
-    const int MAX_DEGREE_ESTIMATE = 64; // Max degree for n up to approx 2^44
-    Fibonacci_Node *A[MAX_DEGREE_ESTIMATE];
-    memset(A, 0, sizeof(A)); // Initialize A with NULLs (0 for pointers)
-
-    Fibonacci_Node *current_root = fh->root_list;
-    if (current_root == NULL) return;
-
-    // Need to iterate through all root nodes.
-    // Since the list is circular and modified during iteration (nodes removed by link_fib_nodes),
-    // it's safer to collect them first or carefully manage iteration.
-    // Let's create a temporary array of root nodes to iterate over.
-    // Count root nodes first
-    int num_roots = 0;
-    Fibonacci_Node *temp = current_root;
-    do {
-        num_roots++;
-        temp = temp->right;
-    } while (temp != current_root);
-
-    Fibonacci_Node **roots_to_process = (Fibonacci_Node **)malloc(num_roots * sizeof(Fibonacci_Node *));
-    if (roots_to_process == NULL) {
-        // Memory allocation failed, cannot proceed with consolidation robustly.
-        // This is a critical error. For now, just return, but a real system might need error handling.
-        return;
-    }
-    temp = current_root;
-    for (int i = 0; i < num_roots; i++) {
-        roots_to_process[i] = temp;
-        temp = temp->right;
-    }
+    // fh->degree_table has room for every degree a heap of fh->n nodes can reach and is
+    // all NULL between calls, so nothing is allocated here.
+    Fibonacci_Node **A = fh->degree_table;
+    int max_degree = -1;
 
-    // b. For each node w in the original root list
-    for (int i = 0; i < num_roots; i++) {
-        Fibonacci_Node *x = roots_to_process[i];
+    // a. Open the circular root list so it can be walked while roots are linked away
+    Fibonacci_Node *w = fh->root_list;
+    w->left->right = NULL;
 
-        // Ensure x is still in the root list (it might have been linked as a child)
-        // A simple check: if x has a parent, it's no longer a root in the main list.
-        if (x->parent != NULL) {
-            continue;
-        }
+    // b. Link roots of equal degree until every degree appears at most once
+    while (w != NULL) {
+        Fibonacci_Node *x = w;
+        w = w->right;
+        x->parent = NULL; // Children of the extracted node become roots here
+        x->left = x;
+        x->right = x;
 
         int d = x->degree;
         while (A[d] != NULL) {
             Fibonacci_Node *y = A[d]; // y is the other node with the same degree
-
-            // Ensure x and y are different nodes. This should always be true if logic is correct.
-            if (x == y) {
-                 // This case should ideally not happen if nodes are processed correctly.
-                 // If it does, break to avoid infinite loop.
-                break;
-            }
-
-            if (*(int *)(x->key) > *(int *)(y->key)) {
+            if (fib_less(fh, y, x)) {
                 Fibonacci_Node *temp_node = x;
                 x = y;
                 y = temp_node;
             }
             // Now x->key <= y->key, so y will become child of x
-            link_fib_nodes(fh, y, x); // y is removed from root list here
-                                      // x's degree is incremented inside link_fib_nodes
+            link_fib_nodes(fh, y, x);
             A[d] = NULL;
             d++; // Degree of x has increased
-            if (d >= MAX_DEGREE_ESTIMATE) {
-                // Degree exceeds array bounds, something is wrong or MAX_DEGREE_ESTIMATE is too small.
-                // Handle error or resize A if it were dynamic. For fixed size, this is an issue.
-                // This could happen if MAX_DEGREE_ESTIMATE is too small for fh->n.
-                // For now, we'll assume it's large enough.
-                break; // Avoid array out of bounds
-            }
         }
         A[d] = x;
+        if (d > max_degree) {
+            max_degree = d;
+        }
     }
-    free(roots_to_process);
 
-    // c. Reconstruct the root list from array A
+    // c. Rebuild the root list from the table, clearing it for the next call
     fh->min = NULL;
-    fh->root_list = NULL; // Reset root list
-
-    for (int d = 0; d < MAX_DEGREE_ESTIMATE; d++) {
-        if (A[d] != NULL) {
-            Fibonacci_Node *node_to_add = A[d];
-            // Ensure node_to_add is properly a root
-            node_to_add->parent = NULL;
-            // Add A[d] to the root list
-            if (fh->root_list == NULL) {
-                fh->root_list = node_to_add;
-                node_to_add->left = node_to_add;
-                node_to_add->right = node_to_add;
-            } else {
-                // Insert node_to_add to the right of fh->root_list
-                node_to_add->right = fh->root_list->right;
-                node_to_add->left = fh->root_list;
-                fh->root_list->right->left = node_to_add;
-                fh->root_list->right = node_to_add;
-            }
-
-            // Update fh->min
-            if (fh->min == NULL || *(int *)(node_to_add->key) < *(int *)(fh->min->key)) {
-                fh->min = node_to_add;
-            }
+    fh->root_list = NULL;
+    for (int d = 0; d <= max_degree; d++) {
+        Fibonacci_Node *node_to_add = A[d];
+        if (node_to_add == NULL) {
+            continue;
+        }
+        A[d] = NULL;
+        if (fh->root_list == NULL) {
+            fh->root_list = node_to_add;
+        } else {
+            // Insert node_to_add to the right of fh->root_list
+            node_to_add->right = fh->root_list->right;
+            node_to_add->left = fh->root_list;
+            fh->root_list->right->left = node_to_add;
+            fh->root_list->right = node_to_add;
+        }
+        if (fh->min == NULL || fib_less(fh, node_to_add, fh->min)) {
+            fh->min = node_to_add;
         }
     }
-    // If fh->root_list was reconstructed, fh->min is now set.
-    // If the heap became empty (e.g. extracting last element, though consolidate is not directly for that)
-    // then fh->min and fh->root_list will be NULL.
-    // The problem statement said "fh->root_list points to a valid node ... (e.g. fh->min)"
-    // If fh->min is set, fh->root_list can be fh->min.
-    // Our current reconstruction makes fh->root_list point to the *last* node added from A.
-    // It's fine as long as it's a valid entry point.
-    // For consistency, let's make fh->root_list = fh->min if fh->min is not NULL.
-    if (fh->min != NULL) {
-        fh->root_list = fh->min;
-    } else {
-        fh->root_list = NULL; // Should already be NULL if fh->min is NULL
+    fh->root_list = fh->min;
+}
+
+// Helper function to restore heap order after node's key has been lowered
+static void decrease_fib_node(Fibonacci_Heap *fh, Fibonacci_Node *node) {
+    // a. Let y = node->parent
+    Fibonacci_Node *y = node->parent;
+
+    // b. If node is not a root and its key is now less than its parent's key
+    if (y != NULL && fib_less(fh, node, y)) {
+        // i. Call cut_fib_node(fh, node, y)
+        cut_fib_node(fh, node, y);
+        // ii. Call cascading_cut_fib_node(fh, y)
+        cascading_cut_fib_node(fh, y);
     }
+
+    // c. Update fh->min
+    // This check is important even if the node was already a root, or if it became a root.
+    if (fh->min == NULL || fib_less(fh, node, fh->min)) {
+        fh->min = node;
+    }
+    advance_consolidation_fib_heap(fh);
 }
 
 // Function to decrease the key of a node in the Fibonacci heap
-// new_key is an int* that will be adopted by the node.
-// This function does NOT free the old node->key. The caller must do so.
-bool decrease_key_fib_heap(Fibonacci_Heap *fh, Fibonacci_Node *node, void *new_key) {
+bool decrease_key_fib_heap_key(Fibonacci_Heap *fh, Fibonacci_Node *node, Fibonacci_Key new_key) {
     // a. Basic checks
-    if (fh == NULL || node == NULL || new_key == NULL) {
+    if (fh == NULL || node == NULL || fh->compare != NULL) {
         return false; // Invalid input
     }
-    // It's possible that new_key is not strictly less, e.g. when setting to INT_MIN for delete
-    // For a generic decrease_key, it must be less.
-    // However, change_fib_node_value might call this even if new_key == old_key (which is fine).
-    // The > check is important.
-    if (node->key != NULL && *(int *)new_key > *(int *)(node->key)) { 
-        // Only check if node->key is not NULL. If it was NULL, any new key is fine.
-        // This path typically shouldn't be hit if called by change_fib_node_value correctly.
+    if (new_key > node->key) {
         return false; // New key is greater than current key
     }
 
-    // b. Update the key (adopt the new_key pointer)
-    // The old node->key is now orphaned by the node. Caller's responsibility.
+    // b. Update the key (and its index entry) and fix up the heap
+    unindex_fib_node(fh, node);
     node->key = new_key;
+    index_fib_node(fh, node); // Cannot fail: the entry just removed made room
+    decrease_fib_node(fh, node);
+    return true;
+}
 
-    // c. Let y = node->parent
-    Fibonacci_Node *y = node->parent;
-
-    // d. If node is not a root and its key is now less than its parent's key
-    if (y != NULL && (*(int *)(node->key) < *(int *)(y->key))) {
-        // i. Call cut_fib_node(fh, node, y)
-        cut_fib_node(fh, node, y);
-        // ii. Call cascading_cut_fib_node(fh, y)
-        cascading_cut_fib_node(fh, y);
+// Function to decrease the key of a node in a heap of any key type
+bool decrease_key_fib_heap_ex(Fibonacci_Heap *fh, Fibonacci_Node *node, const void *new_key) {
+    if (fh == NULL || node == NULL || new_key == NULL) {
+        return false; // Invalid input
     }
-
-    // e. Update fh->min
-    // This check is important even if the node was already a root, or if it became a root.
-    if (fh->min == NULL || (*(int *)(node->key) < *(int *)(fh->min->key))) {
-        fh->min = node;
+    void *key = fib_node_key_ptr(fh, node);
+    if (fh->compare == NULL) {
+        Fibonacci_Key value;
+        memcpy(&value, new_key, sizeof(value)); // new_key may not be aligned
+        if (value > node->key) {
+            return false; // New key is greater than current key
+        }
+    } else if (fh->compare(new_key, key) > 0) {
+        return false; // New key is greater than current key
     }
+    unindex_fib_node(fh, node);
+    memcpy(key, new_key, fh->key_size);
+    index_fib_node(fh, node); // Cannot fail: the entry just removed made room
+    decrease_fib_node(fh, node);
+    return true;
+}
 
-    // f. Return true
+// Pointer API decrease_key: new_key is an int* that becomes the node's payload.
+// This function does NOT free the old payload. The caller must do so.
+bool decrease_key_fib_heap(Fibonacci_Heap *fh, Fibonacci_Node *node, void *new_key) {
+    if (fh == NULL || node == NULL || new_key == NULL) {
+        return false; // Invalid input
+    }
+    if (!decrease_key_fib_heap_key(fh, node, *(int *)new_key)) {
+        return false;
+    }
+    node->payload = new_key;
     return true;
 }
 
-// Function to extract the minimum key from the Fibonacci heap
-void *extract_min_fib_heap(Fibonacci_Heap *fh) {
-    if (fh == NULL) return NULL;
+// Helper function for remove_min_fib_node on a heap with a consolidation budget. At most
+// 'budget' steps plus three per child of the minimum are spent, and the new minimum is
+// found among the O(log n) filed roots and the few pending ones.
+static Fibonacci_Node *remove_min_bounded_fib_node(Fibonacci_Heap *fh) {
+    // a. Take the minimum out and queue its children as pending roots. fh->min keeps
+    // pointing at z until the rescan; no child is smaller.
+    Fibonacci_Node *z = fh->min;
+    unlink_root_fib_heap(fh, z);
+    while (z->child != NULL) {
+        Fibonacci_Node *child = z->child;
+        z->child = child->right == child ? NULL : child->right;
+        child->left->right = child->right;
+        child->right->left = child->left;
+        add_pending_root_fib_heap(fh, child);
+    }
+    z->degree = 0;
+    fh->n--;
+
+    // b. Spend the budget, then rescan the remaining roots for the minimum
+    advance_consolidation_fib_heap(fh);
+    fh->min = NULL;
+    Fibonacci_Node *root = fh->root_list;
+    if (root != NULL) {
+        do {
+            if (fh->min == NULL || fib_less(fh, root, fh->min)) {
+                fh->min = root;
+            }
+            root = root->right;
+        } while (root != fh->root_list);
+    }
+    return z;
+}
 
+// Helper function to unlink the minimum node from the heap without freeing it
+static Fibonacci_Node *remove_min_fib_node(Fibonacci_Heap *fh) {
     // a. Let z be fh->min
     Fibonacci_Node *z = fh->min;
 
@@ -490,119 +1208,117 @@ void *extract_min_fib_heap(Fibonacci_Heap *fh) {
     if (z == NULL) {
         return NULL;
     }
+    if (fh->consolidate_budget > 0) {
+        return remove_min_bounded_fib_node(fh);
+    }
 
-    // c. Store z->key to be returned later
-    void *min_key = z->key;
-    bool z_had_children = (z->child != NULL); // Track if z initially had children
-
-    // d. If z has children (i.e., z->child is not NULL):
-    if (z_had_children) {
-        Fibonacci_Node *child = z->child;
-        Fibonacci_Node *first_child = child; // To detect cycle completion
-        Fibonacci_Node *next_child;
-
-        // Need to save children before modifying lists extensively
-        // Count children first
-        int num_children = 0;
-        do {
-            num_children++;
-            child = child->right;
-        } while (child != first_child);
-        
-        Fibonacci_Node **children_array = (Fibonacci_Node **)malloc(num_children * sizeof(Fibonacci_Node *));
-        if (children_array == NULL && num_children > 0) {
-            // Memory allocation failed, cannot proceed safely.
-            // This is a critical error state. For now, return NULL as we can't correctly modify the heap.
-            // This indicates an out-of-memory condition.
-            // The key `min_key` is still valid from z, but the heap is now in a bad state.
-            // To prevent use of a corrupted heap, maybe it's better to signal a fatal error.
-            // For now, returning NULL for the key, though z and min_key are technically available.
-            // This makes the function's behavior consistent on failure (return NULL).
-            return NULL; 
-        }
-
-        child = first_child;
-        for(int i=0; i < num_children; ++i) {
-            children_array[i] = child;
-            child = child->right;
-        }
-
-        for (int i = 0; i < num_children; ++i) {
-            Fibonacci_Node *current_child_to_add = children_array[i];
-            // i. Add current_child_to_add to the root list of fh
-            if (fh->root_list == NULL) { // If root list is currently empty (e.g. z was the only root)
-                fh->root_list = current_child_to_add;
-                current_child_to_add->left = current_child_to_add;
-                current_child_to_add->right = current_child_to_add;
-            } else {
-                // Insert current_child_to_add to the right of fh->root_list
-                current_child_to_add->left = fh->root_list;
-                current_child_to_add->right = fh->root_list->right;
-                fh->root_list->right->left = current_child_to_add;
-                fh->root_list->right = current_child_to_add;
-            }
-            // Set current_child_to_add->parent = NULL
-            current_child_to_add->parent = NULL;
-        }
-        
-        if(num_children > 0) free(children_array);
-
-        // ii. Clear z->child (it no longer has children in the heap structure)
-        z->child = NULL; // z->degree is not explicitly reset here as z is removed.
+    // c. Splice z's child list into the root list next to z. The children's parent
+    // pointers are cleared by consolidate_fib_heap, which visits every root anyway.
+    // z's key and payload stay in the node for the caller.
+    if (z->child != NULL) {
+        Fibonacci_Node *first_child = z->child;
+        Fibonacci_Node *last_child = first_child->left;
+        last_child->right = z->right;
+        z->right->left = last_child;
+        z->right = first_child;
+        first_child->left = z;
+        z->child = NULL;
     }
 
-    // e. Remove z from the root list
-    if (z == z->right) { // z is the only node in the root list
-        // This means if z had children, they are now the root list.
-        // If z had no children, the root list is now empty.
-        if (z_had_children) {
-            // fh->root_list was set to one of the children (or is NULL if z had no children)
-            // fh->min will be found by consolidate.
-            // The loop above already made fh->root_list point to one of the children if any.
-        } else {
-            // z was the only node and had no children.
-            fh->min = NULL;
-            fh->root_list = NULL;
-        }
-    } else { // z has siblings in the root list
-        z->left->right = z->right;
-        z->right->left = z->left;
-        
-        // If fh->root_list was z, point it to another node
-        if (fh->root_list == z) {
-            fh->root_list = z->right;
-        }
-        // fh->min will be updated by consolidate. As a temporary measure,
-        // we could set fh->min = fh->root_list, but consolidate handles this.
-        // For robustness, let's ensure fh->min is not z if it's still pointing to it.
-        if (fh->min == z) { // This will always be true here
-            fh->min = fh->root_list; // Temporary new min, consolidate will find the actual one.
-                                     // If fh->root_list became NULL (e.g. z was only node, children became root list, but no children), this is fine.
-        }
-    }
-
-    // f. If z == z->right AND z->child == NULL (originally, not after children are moved)
-    // This condition means the heap had only one node (z) and it had no children.
-    // In this case, fh->root_list will be NULL at this point.
-    if (fh->root_list == NULL) { // This is a better check for emptiness now
+    // d. Remove z from the root list
+    if (z == z->right) {
+        // z was the only node
+        fh->min = NULL;
+        fh->root_list = NULL;
         fh->n = 0;
-        // fh->min is already NULL
-        free(z);
-        return min_key;
+        return z;
     }
+    z->left->right = z->right;
+    z->right->left = z->left;
+    fh->root_list = z->right;
+    fh->min = z->right; // Temporary, consolidate finds the actual minimum
 
-    // g. Call consolidate_fib_heap(fh)
-    // consolidate_fib_heap will update fh->min and ensure fh->root_list points to the new min.
+    // e. Merge trees of equal degree and find the new minimum
     consolidate_fib_heap(fh);
 
-    // h. Decrement fh->n
+    // f. Decrement fh->n and return the unlinked node z
     fh->n--;
+    return z;
+}
 
-    // i. Free the extracted node z
-    free(z);
+// Function to extract the minimum key from the Fibonacci heap
+bool extract_min_fib_heap_key(Fibonacci_Heap *fh, Fibonacci_Key *key_out, void **payload_out) {
+    if (fh == NULL || fh->compare != NULL) return false;
+
+    merge_insert_buffers_fib_heap(fh);
+    Fibonacci_Node *z = remove_min_fib_node(fh);
+    if (z == NULL) {
+        return false; // Heap is empty
+    }
+    unindex_fib_node(fh, z);
+    if (key_out != NULL) {
+        *key_out = z->key;
+    }
+    if (payload_out != NULL) {
+        *payload_out = z->payload;
+    }
+    free_fib_node(fh, z);
+    return true;
+}
+
+// Function to extract up to k minimum keys at once
+size_t extract_min_many_fib_heap(Fibonacci_Heap *fh, Fibonacci_Key *keys_out, void **payloads_out, size_t k) {
+    if (fh == NULL || fh->compare != NULL || keys_out == NULL) {
+        return 0;
+    }
+
+    merge_insert_buffers_fib_heap(fh);
+    size_t extracted = 0;
+    while (extracted < k) {
+        Fibonacci_Node *z = remove_min_fib_node(fh);
+        if (z == NULL) {
+            break; // Heap is empty
+        }
+        unindex_fib_node(fh, z);
+        keys_out[extracted] = z->key;
+        if (payloads_out != NULL) {
+            payloads_out[extracted] = z->payload;
+        } else if (fh->free_payload != NULL && z->payload != NULL) {
+            fh->free_payload(z->payload);
+        }
+        free_fib_node(fh, z);
+        extracted++;
+    }
+    return extracted;
+}
+
+// Function to extract the minimum key from a heap of any key type
+bool extract_min_fib_heap_ex(Fibonacci_Heap *fh, void *key_out, void **payload_out) {
+    if (fh == NULL) return false;
+
+    merge_insert_buffers_fib_heap(fh);
+    Fibonacci_Node *z = remove_min_fib_node(fh);
+    if (z == NULL) {
+        return false; // Heap is empty
+    }
+    unindex_fib_node(fh, z);
+    if (key_out != NULL) {
+        memcpy(key_out, fib_node_key_ptr(fh, z), fh->key_size);
+    }
+    if (payload_out != NULL) {
+        *payload_out = z->payload;
+    }
+    free_fib_node(fh, z);
+    return true;
+}
 
-    // j. Return the stored key
-    return min_key;
+// Pointer API extract_min: returns the payload of the extracted node
+void *extract_min_fib_heap(Fibonacci_Heap *fh) {
+    void *payload = NULL;
+    if (fh == NULL || fh->compare != NULL || !extract_min_fib_heap_key(fh, NULL, &payload)) {
+        return NULL;
+    }
+    return payload;
 }
 
 // Helper function to cut node x from its parent y
@@ -618,7 +1334,19 @@ static void cut_fib_node(Fibonacci_Heap *fh, Fibonacci_Node *x, Fibonacci_Node *
         }
     }
 
-    // b. Decrement y->degree
+    // b. Decrement y->degree. With a budget, a filed root would now sit in the wrong table
+    // slot, so it is queued for filing again.
+    if (fh->consolidate_budget > 0) {
+        if (y->parent == NULL && fh->carry != y && fh->degree_table[y->degree] == y) {
+            unlink_root_fib_heap(fh, y);
+            y->degree--;
+            add_pending_root_fib_heap(fh, y);
+        } else {
+            y->degree--;
+        }
+        add_pending_root_fib_heap(fh, x);
+        return;
+    }
     y->degree--;
 
     // c. Add x to the root list of fh
@@ -668,61 +1396,179 @@ static void cascading_cut_fib_node(Fibonacci_Heap *fh, Fibonacci_Node *y) {
     }
 }
 
-// Helper function to find a node by its integer value (recursive)
-// 'start_node' is the node to begin search from in a list (e.g. fh->root_list or parent->child).
-// 'value_to_find' is the integer value being searched for.
-// 'list_head_marker' is used to detect when a circular list traversal is complete. It should be the same as 'start_node' for the initial call on a list.
-static Fibonacci_Node* find_node_by_value_recursive(Fibonacci_Node *current_search_candidate, int value_to_find, Fibonacci_Node *list_head_marker) {
-    if (current_search_candidate == NULL) {
-        return NULL;
+// Helper function to add a node to the key index, if there is one
+static bool index_fib_node(Fibonacci_Heap *fh, Fibonacci_Node *node) {
+    if (fh->index == NULL) {
+        return true;
     }
+    return insert_fibonacci_index(fh->index, node->key, node);
+}
 
-    Fibonacci_Node *iter_node = current_search_candidate;
-    Fibonacci_Node *found_node = NULL;
+// Helper function to drop a node from the key index, if there is one
+static void unindex_fib_node(Fibonacci_Heap *fh, Fibonacci_Node *node) {
+    if (fh->index != NULL) {
+        remove_fibonacci_index(fh->index, node->key, node);
+    }
+}
 
-    do {
-        // Check current node
-        if (iter_node->key != NULL && *(int*)(iter_node->key) == value_to_find) {
-            return iter_node; // Found the node
+// Helper function to add src's nodes to dst's index ahead of a meld
+static bool merge_index_fib_heap(Fibonacci_Heap *dst, Fibonacci_Heap *src) {
+    // a. Make room up front so the inserts below cannot fail halfway
+    if (!reserve_fibonacci_index(dst->index, (size_t)src->n)) {
+        return false;
+    }
+
+    // b. Copy the smaller of the two tables into the larger one, keeping dst's
+    // (now larger) table. Without an index on src, its node pool is scanned instead.
+    if (src->index != NULL) {
+        if (src->index->count > dst->index->count &&
+            reserve_fibonacci_index(src->index, dst->index->count)) {
+            Fibonacci_Index *larger = src->index;
+            src->index = dst->index;
+            dst->index = larger;
+        }
+        Fibonacci_Index *from = src->index;
+        for (size_t i = 0; i < from->capacity; i++) {
+            if (from->entries[i].value != NULL) {
+                insert_fibonacci_index(dst->index, from->entries[i].key, from->entries[i].value);
+            }
+        }
+        return true;
+    }
+    for (Fibonacci_Node_Chunk *chunk = src->pool.chunks; chunk != NULL; chunk = chunk->next) {
+        for (size_t i = 0; i < chunk->used; i++) {
+            Fibonacci_Node *node = (Fibonacci_Node *)((char *)chunk->nodes + src->pool.node_size * i);
+            if (node->degree >= 0) {
+                insert_fibonacci_index(dst->index, node->key, node);
+            }
         }
+    }
+    return true;
+}
+
+bool enable_index_fib_heap(Fibonacci_Heap *fh) {
+    if (fh == NULL || fh->compare != NULL) {
+        return false; // Only Fibonacci_Key heaps can be indexed
+    }
+    if (fh->index != NULL) {
+        return true; // Already enabled
+    }
 
-        // Recursively search in children (if any)
-        // For child list, the head marker for the child list traversal is iter_node->child itself.
-        if (iter_node->child != NULL) {
-            found_node = find_node_by_value_recursive(iter_node->child, value_to_find, iter_node->child);
-            if (found_node != NULL) {
-                return found_node; // Found in a descendant
+    merge_insert_buffers_fib_heap(fh);
+    Fibonacci_Index *index = (Fibonacci_Index *)malloc(sizeof(Fibonacci_Index));
+    if (index == NULL || !init_fibonacci_index(index, (size_t)fh->n)) {
+        free(index);
+        return false; // Memory allocation failed
+    }
+
+    // Index the nodes already in the heap: every live node sits in one of the pool's chunks
+    for (Fibonacci_Node_Chunk *chunk = fh->pool.chunks; chunk != NULL; chunk = chunk->next) {
+        for (size_t i = 0; i < chunk->used; i++) {
+            Fibonacci_Node *node = (Fibonacci_Node *)((char *)chunk->nodes + fh->pool.node_size * i);
+            if (node->degree >= 0 && !insert_fibonacci_index(index, node->key, node)) {
+                destroy_fibonacci_index(index);
+                free(index);
+                return false;
+            }
+        }
+    }
+    Fibonacci_Insert_Buffer *buffer = atomic_load_explicit(&fh->buffers, memory_order_acquire);
+    for (; buffer != NULL; buffer = buffer->next) {
+        for (size_t i = 0; i < buffer->merged_used; i++) {
+            Fibonacci_Node *node = &buffer->merged_chunk->nodes[i];
+            if (node->degree >= 0 && !insert_fibonacci_index(index, node->key, node)) {
+                destroy_fibonacci_index(index);
+                free(index);
+                return false;
             }
         }
+    }
+    fh->index = index;
+    return true;
+}
 
-        // Move to the next sibling in the current list
-        iter_node = iter_node->right;
-    } while (iter_node != list_head_marker); // Stop after traversing the circular list
+void disable_index_fib_heap(Fibonacci_Heap *fh) {
+    if (fh == NULL || fh->index == NULL) {
+        return;
+    }
+    destroy_fibonacci_index(fh->index);
+    free(fh->index);
+    fh->index = NULL;
+}
 
-    return NULL; // Not found in this list or its descendants
+// Function to find a node by its key
+Fibonacci_Node *find_node_fib_heap_key(Fibonacci_Heap *fh, Fibonacci_Key key) {
+    if (fh == NULL || fh->compare != NULL) {
+        return NULL;
+    }
+    merge_insert_buffers_fib_heap(fh);
+    if (fh->index != NULL) {
+        return (Fibonacci_Node *)find_fibonacci_index(fh->index, key);
+    }
+
+    // Without an index, scan the pool's chunks. This is still O(n), but it reads memory
+    // sequentially and needs no recursion, however deep the trees are.
+    for (Fibonacci_Node_Chunk *chunk = fh->pool.chunks; chunk != NULL; chunk = chunk->next) {
+        for (size_t i = 0; i < chunk->used; i++) {
+            Fibonacci_Node *node = (Fibonacci_Node *)((char *)chunk->nodes + fh->pool.node_size * i);
+            if (node->degree >= 0 && node->key == key) { // Skip recycled slots
+                return node;
+            }
+        }
+    }
+    // Merged nodes from the producers' current chunks are not in the pool yet
+    Fibonacci_Insert_Buffer *buffer = atomic_load_explicit(&fh->buffers, memory_order_acquire);
+    for (; buffer != NULL; buffer = buffer->next) {
+        for (size_t i = 0; i < buffer->merged_used; i++) {
+            Fibonacci_Node *node = &buffer->merged_chunk->nodes[i];
+            if (node->degree >= 0 && node->key == key) {
+                return node;
+            }
+        }
+    }
+    return NULL;
 }
 
 
+// Helper function to free a chain of node chunks, handing live payloads to the destructor
+static void release_fib_node_chunks(Fibonacci_Heap *fh, Fibonacci_Node_Chunk *chunk) {
+    while (chunk != NULL) {
+        Fibonacci_Node_Chunk *next = chunk->next;
+        if (fh->free_payload != NULL) {
+            for (size_t i = 0; i < chunk->used; i++) {
+                Fibonacci_Node *node = (Fibonacci_Node *)((char *)chunk->nodes + fh->pool.node_size * i);
+                if (node->degree >= 0 && node->payload != NULL) { // Skip recycled slots
+                    fh->free_payload(node->payload);
+                }
+            }
+        }
+        free(chunk);
+        chunk = next;
+    }
+}
+
 void destroy_fib_heap(Fibonacci_Heap *fh) {
     if (fh == NULL) {
         return;
     }
-    // Ensure fh->n is reliable. If not, this loop could be problematic.
-    // extract_min_fib_heap should decrement fh->n.
-    while (fh->n > 0 && fh->min != NULL) { // Added fh->min != NULL for extra safety
-        void *key_ptr = extract_min_fib_heap(fh); // This should return the int* key
-        if (key_ptr != NULL) {
-            free(key_ptr); // Free the int* allocated by the wrapper's insert
-        } else {
-            // If extract_min_fib_heap returns NULL but fh->n > 0, something is wrong.
-            // This might indicate heap corruption or a bug in extract_min_fib_heap.
-            // To prevent an infinite loop, break. Consider logging an error.
-            fprintf(stderr, "Warning: destroy_fib_heap encountered NULL key from extract_min_heap while n > 0.\n");
-            break; 
-        }
+    // Every node lives in one of the pool's chunks, so instead of extracting nodes one by one
+    // walk the chunks, hand live payloads to the destructor and release each chunk whole.
+    release_fib_node_chunks(fh, fh->pool.chunks);
+    reset_fib_node_pool(&fh->pool);
+
+    // Producer buffers' chunks hold merged and still buffered nodes, both of which count as in the heap
+    Fibonacci_Insert_Buffer *buffer = atomic_load_explicit(&fh->buffers, memory_order_acquire);
+    while (buffer != NULL) {
+        Fibonacci_Insert_Buffer *next = buffer->next;
+        release_fib_node_chunks(fh, buffer->retired);
+        release_fib_node_chunks(fh, buffer->chunk);
+        free(buffer);
+        buffer = next;
     }
-    // All nodes and their keys should have been freed via extract_min_fib_heap.
-    // Now free the heap structure itself.
+    atomic_store_explicit(&fh->buffers, NULL, memory_order_relaxed);
+    disable_index_fib_heap(fh);
+    free(fh->degree_table);
+    fh->degree_table = NULL;
     fh->min = NULL; // Defensive nulling
     fh->root_list = NULL; // Defensive nulling
     fh->n = 0; // Defensive
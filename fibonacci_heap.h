@@ -1,12 +1,26 @@
 #ifndef FIBONACCI_HEAP_H
 #define FIBONACCI_HEAP_H
 
+#include <stdatomic.h>
 #include <stdbool.h>
 #include <stddef.h>
+#include <stdint.h>
+#include "fibonacci_index.h"
+
+// Keys are stored inline in every node as a signed 64-bit integer, so
+// comparisons never chase a pointer to a separately allocated key.
+typedef int64_t Fibonacci_Key;
+
+// Three-way comparison between two keys of a heap created with create_fib_heap_ex.
+// Returns a negative value, zero or a positive value like memcmp/qsort comparators.
+typedef int (*Fibonacci_Compare)(const void *a, const void *b);
 
 // Node structure
+// Keys up to sizeof(Fibonacci_Key) bytes live in 'key'. Wider keys of a create_fib_heap_ex
+// heap are stored right after the node; use get_key_fib_node to reach either.
 typedef struct Fibonacci_Node {
-    void *key;
+    Fibonacci_Key key;
+    void *payload; // Optional opaque data attached by the caller, never dereferenced by the heap
     int degree;
     bool marked;
     struct Fibonacci_Node *parent;
@@ -15,26 +29,219 @@ typedef struct Fibonacci_Node {
     struct Fibonacci_Node *right;
 } Fibonacci_Node;
 
+// A block of nodes handed out by the node pool. Chunks are chained together and
+// only released when the heap is destroyed.
+typedef struct Fibonacci_Node_Chunk {
+    struct Fibonacci_Node_Chunk *next;
+    size_t capacity; // Number of nodes in this chunk, each pool.node_size bytes apart
+    size_t used;     // Nodes handed out so far (bump allocation)
+    Fibonacci_Node nodes[];
+} Fibonacci_Node_Chunk;
+
+// Per-heap node allocator. Nodes are bump-allocated from the newest chunk and
+// recycled through an intrusive free list linked via node->right.
+typedef struct Fibonacci_Node_Pool {
+    Fibonacci_Node_Chunk *chunks;  // Newest chunk first
+    Fibonacci_Node_Chunk *chunks_tail;
+    Fibonacci_Node *free_list;
+    Fibonacci_Node *free_tail;     // Last node of free_list, so melds can splice it in O(1)
+    size_t next_chunk_capacity;    // Grows geometrically up to FIB_POOL_MAX_CHUNK
+    size_t node_size;              // Stride between nodes, including any out-of-line key
+} Fibonacci_Node_Pool;
+
+#define FIB_POOL_MIN_CHUNK 256
+#define FIB_POOL_MAX_CHUNK 65536
+
+#define FIB_CACHE_LINE 64
+
+// Insert buffer of one producer thread (see create_insert_buffer_fib_heap). Nodes are carved
+// out of the buffer's own chunks and chained into a circular list with its minimum, ready to
+// be spliced into the heap's root list as a whole. 'lock' is only ever contended between the
+// producer and the consumer, and each buffer has cache lines of its own.
+typedef struct Fibonacci_Insert_Buffer {
+    _Alignas(FIB_CACHE_LINE) atomic_flag lock;
+    Fibonacci_Node *list;          // Nodes not merged into the heap yet, or NULL
+    Fibonacci_Node *list_min;
+    _Atomic size_t count;          // Nodes in 'list'; read without the lock as a hint
+    Fibonacci_Node_Chunk *chunk;   // Chunk the producer allocates from
+    Fibonacci_Node_Chunk *retired; // Full chunks the heap has not taken over yet
+    Fibonacci_Node_Chunk *retired_tail;
+    size_t next_chunk_capacity;
+    // Consumer side: 'chunk' as of the last merge and how many of its nodes the heap owns
+    Fibonacci_Node_Chunk *merged_chunk;
+    size_t merged_used;
+    struct Fibonacci_Insert_Buffer *next; // Next buffer of the same heap
+} Fibonacci_Insert_Buffer;
+
 // Heap structure
 typedef struct Fibonacci_Heap {
     Fibonacci_Node *min;
     int n;
-    Fibonacci_Node *root_list; 
+    Fibonacci_Node *root_list;
+    Fibonacci_Node_Pool pool;
+    Fibonacci_Compare compare; // NULL for the built-in Fibonacci_Key ordering
+    size_t key_size;
+    Fibonacci_Index *index;    // Key -> node index, NULL unless enable_index_fib_heap was called
+    // Consolidation scratch table, one slot per possible root degree and all NULL between
+    // calls. Grown by the insert paths so extract_min never allocates.
+    Fibonacci_Node **degree_table;
+    int degree_table_size;
+    int degree_table_max_n;    // Largest n whose trees are guaranteed to fit the table
+    // Bounded-latency mode (see set_consolidate_budget_fib_heap). With a budget, roots of
+    // distinct degrees stay filed in degree_table between calls; the others ('pending') form
+    // the tail of the root list from 'pending' on and are filed a few steps per operation.
+    int consolidate_budget;    // 0: consolidate the whole root list in extract_min
+    Fibonacci_Node *pending;   // First root not yet filed, or NULL
+    Fibonacci_Node *carry;     // Root being filed, linked with one table entry per step
+    size_t consolidate_debt;   // Extra steps owed for roots added since the last operation
+    // Producer insert buffers, newest first. The list only grows until the heap is destroyed.
+    _Atomic(Fibonacci_Insert_Buffer *) buffers;
+    // Called on payloads the heap drops on its own (delete_node_fib_heap, delete_fib_node,
+    // change_fib_node_value, extract_min_many_fib_heap and destroy_fib_heap). NULL by default: payloads are left alone.
+    void (*free_payload)(void *payload);
 } Fibonacci_Heap;
 
+// Creates a heap ordered by Fibonacci_Key values.
 Fibonacci_Heap *create_fib_heap();
 
+// Creates a heap whose keys are opaque blocks of 'key_size' bytes ordered by 'compare'.
+// Passing a NULL compare requires key_size == sizeof(Fibonacci_Key) and gives the same heap
+// as create_fib_heap(). Returns NULL on invalid arguments or allocation failure.
+Fibonacci_Heap *create_fib_heap_ex(Fibonacci_Compare compare, size_t key_size);
+
+// --- Generic key API ---
+// Works on every heap. Keys are passed by pointer and copied (fh->key_size bytes)
+// into or out of the node; payloads are handed back to the caller.
+
+// Returns a pointer to the key stored in 'node'. Valid while the node is in the heap.
+const void *get_key_fib_node(const Fibonacci_Heap *fh, const Fibonacci_Node *node);
+
+Fibonacci_Node *insert_fib_heap_ex(Fibonacci_Heap *fh, const void *key, void *payload);
+
+bool get_min_fib_heap_ex(Fibonacci_Heap *fh, void *key_out, void **payload_out);
+
+bool extract_min_fib_heap_ex(Fibonacci_Heap *fh, void *key_out, void **payload_out);
+
+// Returns false if new_key compares greater than the node's current key.
+bool decrease_key_fib_heap_ex(Fibonacci_Heap *fh, Fibonacci_Node *node, const void *new_key);
+
+bool delete_node_fib_heap_ex(Fibonacci_Heap *fh, Fibonacci_Node *node, void *key_out, void **payload_out);
+
+// Switches the heap between lazy and bounded-latency consolidation. With budget 0 (the
+// default) extract_min links the whole root list, which is O(n) right after n inserts.
+// With budget > 0 every insert, extract_min, decrease_key, delete and meld advances the
+// consolidation by at most 'budget' steps (one step files a root or links two trees), plus
+// three for each root the operation itself added to the root list, so unfiled roots never
+// pile up: extract_min is O(budget + log n) in the worst case and the minimum is exact
+// at all times. Amortized bounds are unchanged. Turning a budget on consolidates the heap
+// once. Returns false if budget is negative.
+bool set_consolidate_budget_fib_heap(Fibonacci_Heap *fh, int budget);
+
+// --- Producer insert buffers ---
+// For many producer threads feeding one consumer thread. Each producer inserts through a
+// buffer of its own, which never touches the heap or another producer's memory, so producers
+// do not contend with one another. The consumer owns the heap as usual; get_min, extract_min
+// (all variants), find_node_fib_heap_key and the functions built on it, and
+// enable_index_fib_heap first merge every buffer, splicing each buffer's list into the root
+// list in O(1) (plus O(count) index updates if the heap has an index). An insert that
+// happened before one of those calls is therefore seen by it, just as if the producer had
+// inserted into the heap directly. fh->n counts merged nodes only.
+// Only for heaps ordered by Fibonacci_Key.
+
+// Registers a new buffer with the heap; safe to call from any thread. The buffer belongs to
+// the heap and is freed by destroy_fib_heap. Returns NULL on a custom-comparator heap or
+// allocation failure.
+Fibonacci_Insert_Buffer *create_insert_buffer_fib_heap(Fibonacci_Heap *fh);
+
+// Inserts 'key' with an optional 'payload' through 'buffer'. Only one thread may use a
+// buffer at a time. Returns false if allocation failed.
+bool insert_buffered_fib_heap(Fibonacci_Insert_Buffer *buffer, Fibonacci_Key key, void *payload);
+
+// Merges every buffer into the heap now (consumer side). Returns false if the heap could not
+// grow for some buffer; its nodes stay buffered until the next merge.
+bool merge_insert_buffers_fib_heap(Fibonacci_Heap *fh);
+
+// --- By-value API ---
+// Only for heaps ordered by Fibonacci_Key (fh->compare == NULL); they fail on other heaps.
+// Keys are passed and returned by value and payloads are handed back to the caller;
+// none of these functions allocate or free anything besides the node itself.
+
+// Inserts 'key' with an optional 'payload'. Returns the new node, which stays valid
+// until it is extracted or deleted, or NULL if allocation failed.
+Fibonacci_Node *insert_fib_heap_key(Fibonacci_Heap *fh, Fibonacci_Key key, void *payload);
+
+// Inserts 'count' keys (with NULL payloads) in one pass: the nodes are carved out of one
+// contiguous block and spliced into the root list together. All or nothing: returns false,
+// leaving the heap unchanged, if allocation failed.
+bool insert_many_fib_heap(Fibonacci_Heap *fh, const Fibonacci_Key *keys, size_t count);
+
+// Copies the minimum key (and its payload, if payload_out is not NULL) without removing it.
+// Returns false if the heap is empty.
+bool get_min_fib_heap_key(Fibonacci_Heap *fh, Fibonacci_Key *key_out, void **payload_out);
+
+// Removes the minimum node and hands back its key and payload. Either out pointer may be NULL.
+// Returns false if the heap is empty.
+bool extract_min_fib_heap_key(Fibonacci_Heap *fh, Fibonacci_Key *key_out, void **payload_out);
+
+// Removes up to k minimum nodes, writing their keys in ascending order to keys_out[0..].
+// Their payloads go to payloads_out if it is not NULL and are otherwise passed to
+// fh->free_payload (if set). Returns how many nodes were removed (less than k only
+// if the heap ran empty).
+size_t extract_min_many_fib_heap(Fibonacci_Heap *fh, Fibonacci_Key *keys_out, void **payloads_out, size_t k);
+
+// Lowers node->key to new_key. Returns false if new_key is greater than the current key.
+bool decrease_key_fib_heap_key(Fibonacci_Heap *fh, Fibonacci_Node *node, Fibonacci_Key new_key);
+
+// Removes 'node' from the heap and hands back its key and payload. Either out pointer may be NULL.
+bool delete_node_fib_heap_key(Fibonacci_Heap *fh, Fibonacci_Node *node, Fibonacci_Key *key_out, void **payload_out);
+
+// Searches for a node holding 'key' and removes it, handing back its payload.
+// Returns false if no node holds 'key'.
+bool delete_fib_node_key(Fibonacci_Heap *fh, Fibonacci_Key key, void **payload_out);
+
+// Searches for a node holding 'old_key' and changes its key to 'new_key', keeping its payload.
+// The key may move in either direction; the same node keeps holding it.
+// Returns false if no node holds 'old_key'.
+bool change_fib_node_key(Fibonacci_Heap *fh, Fibonacci_Key old_key, Fibonacci_Key new_key);
+
+// Moves every node of 'src' into 'dst' and leaves 'src' empty (but usable). The root lists
+// and node pools are spliced together, so this is O(1) unless 'dst' has a key index, in which
+// case it costs O(min(dst->n, src->n)) with an indexed 'src' and O(src->n) otherwise, or a
+// consolidation budget, which adds O(number of src's roots).
+// Nodes keep their addresses; pointers to src's nodes are now pointers into dst.
+// Both heaps must use the same comparator and key size, and src must have no insert buffers.
+// Returns false (changing nothing) on mismatched heaps, dst == src or allocation failure.
+bool meld_fib_heap(Fibonacci_Heap *dst, Fibonacci_Heap *src);
+
+// Builds a hash index from key to node and keeps it up to date on every insert, extract,
+// delete and key change, making find_node_fib_heap_key and the value-based functions
+// (delete_fib_node_key, change_fib_node_key, ...) O(1) expected time.
+// With duplicate keys, value-based functions act on one of the equal-keyed nodes.
+// Returns false if allocation failed or the heap uses a custom comparator.
+bool enable_index_fib_heap(Fibonacci_Heap *fh);
+
+void disable_index_fib_heap(Fibonacci_Heap *fh);
+
+// Returns a node holding 'key', or NULL. Uses the index when enabled and otherwise
+// scans the node pool linearly.
+Fibonacci_Node *find_node_fib_heap_key(Fibonacci_Heap *fh, Fibonacci_Key key);
+
+// --- Pointer API ---
+// Only for heaps ordered by Fibonacci_Key (fh->compare == NULL). 'data' arguments are int* boxes. The int they point to becomes the node's key and the
+// pointer itself becomes the node's payload, which is what get_min/extract_min return.
+
 bool insert_fib_heap(Fibonacci_Heap *fh, void *data);
 
 // For delete_fib_node, 'data' is expected to be an int* pointing to the value to be searched and deleted.
-// The function will search for a node N where *(int*)(N->key) == *(int*)data.
-// If found, the function will free N->key and then delete the node.
+// The function will search for a node N where N->key == *(int*)data.
+// If found, N's payload is passed to fh->free_payload (if set) and the node is deleted.
 bool delete_fib_node(Fibonacci_Heap *fh, void *data);
 
 // For change_fib_node_value, 'old_val' is an int* pointing to the value to be searched.
-// 'new_val' is an int* (already allocated by caller) that will be adopted by the found node.
-// The function will search for a node N where *(int*)(N->key) == *(int*)old_val.
-// If found, it will free N->key, set N->key = new_val, and then perform heap adjustments.
+// 'new_val' is an int* (already allocated by caller) that will be adopted as the node's payload.
+// The function will search for a node N where N->key == *(int*)old_val.
+// If found, N's old payload is passed to fh->free_payload (if set), N->payload = new_val,
+// and N->key is changed to *(int*)new_val with the necessary heap adjustments.
 bool change_fib_node_value(Fibonacci_Heap *fh, void *old_val, void *new_val);
 
 void *get_min(Fibonacci_Heap *fh);
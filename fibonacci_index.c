@@ -0,0 +1,141 @@
+#include <stdlib.h>
+#include <string.h>
+#include "fibonacci_index.h"
+
+#define FIB_INDEX_MIN_CAPACITY 16
+
+// Helper: 64-bit mix (splitmix64 finalizer) so sequential keys spread across the table
+static inline size_t hash_fibonacci_key(int64_t key) {
+    uint64_t x = (uint64_t)key;
+    x ^= x >> 30;
+    x *= UINT64_C(0xbf58476d1ce4e5b9);
+    x ^= x >> 27;
+    x *= UINT64_C(0x94d049bb133111eb);
+    x ^= x >> 31;
+    return (size_t)x;
+}
+
+// Helper: the table is grown before it gets more than 70% full
+static inline bool fibonacci_index_needs_grow(size_t count, size_t capacity) {
+    return (count + 1) * 10 > capacity * 7;
+}
+
+bool init_fibonacci_index(Fibonacci_Index *index, size_t expected) {
+    size_t capacity = FIB_INDEX_MIN_CAPACITY;
+    while (fibonacci_index_needs_grow(expected, capacity)) {
+        capacity *= 2;
+    }
+    index->entries = (Fibonacci_Index_Entry *)calloc(capacity, sizeof(Fibonacci_Index_Entry));
+    if (index->entries == NULL) {
+        return false; // Memory allocation failed
+    }
+    index->capacity = capacity;
+    index->count = 0;
+    return true;
+}
+
+// Helper: place an entry without checking the load factor
+static void place_fibonacci_index(Fibonacci_Index *index, int64_t key, void *value) {
+    size_t mask = index->capacity - 1;
+    size_t i = hash_fibonacci_key(key) & mask;
+    while (index->entries[i].value != NULL) {
+        i = (i + 1) & mask;
+    }
+    index->entries[i].key = key;
+    index->entries[i].value = value;
+    index->count++;
+}
+
+// Helper: rehash everything into a table of 'capacity' slots
+static bool resize_fibonacci_index(Fibonacci_Index *index, size_t capacity) {
+    Fibonacci_Index_Entry *old_entries = index->entries;
+    size_t old_capacity = index->capacity;
+
+    Fibonacci_Index_Entry *entries = (Fibonacci_Index_Entry *)calloc(capacity, sizeof(Fibonacci_Index_Entry));
+    if (entries == NULL) {
+        return false; // Memory allocation failed, the old table is untouched
+    }
+    index->entries = entries;
+    index->capacity = capacity;
+    index->count = 0;
+    for (size_t i = 0; i < old_capacity; i++) {
+        if (old_entries[i].value != NULL) {
+            place_fibonacci_index(index, old_entries[i].key, old_entries[i].value);
+        }
+    }
+    free(old_entries);
+    return true;
+}
+
+bool insert_fibonacci_index(Fibonacci_Index *index, int64_t key, void *value) {
+    if (value == NULL) {
+        return false;
+    }
+    if (fibonacci_index_needs_grow(index->count, index->capacity) &&
+        !resize_fibonacci_index(index, index->capacity * 2)) {
+        return false;
+    }
+    place_fibonacci_index(index, key, value);
+    return true;
+}
+
+bool reserve_fibonacci_index(Fibonacci_Index *index, size_t additional) {
+    size_t capacity = index->capacity;
+    while (fibonacci_index_needs_grow(index->count + additional, capacity)) {
+        capacity *= 2;
+    }
+    return capacity == index->capacity || resize_fibonacci_index(index, capacity);
+}
+
+void *find_fibonacci_index(const Fibonacci_Index *index, int64_t key) {
+    size_t mask = index->capacity - 1;
+    size_t i = hash_fibonacci_key(key) & mask;
+    while (index->entries[i].value != NULL) {
+        if (index->entries[i].key == key) {
+            return index->entries[i].value;
+        }
+        i = (i + 1) & mask;
+    }
+    return NULL;
+}
+
+bool remove_fibonacci_index(Fibonacci_Index *index, int64_t key, void *value) {
+    size_t mask = index->capacity - 1;
+    size_t i = hash_fibonacci_key(key) & mask;
+
+    // a. Find the exact pair
+    while (index->entries[i].value != value || index->entries[i].key != key) {
+        if (index->entries[i].value == NULL) {
+            return false; // Reached the end of the probe run
+        }
+        i = (i + 1) & mask;
+    }
+
+    // b. Backward-shift the rest of the run so lookups never hit a hole
+    size_t hole = i;
+    size_t j = (i + 1) & mask;
+    while (index->entries[j].value != NULL) {
+        size_t home = hash_fibonacci_key(index->entries[j].key) & mask;
+        // Move entry j into the hole unless its home lies cyclically in (hole, j]
+        if (((j - home) & mask) >= ((j - hole) & mask)) {
+            index->entries[hole] = index->entries[j];
+            hole = j;
+        }
+        j = (j + 1) & mask;
+    }
+    index->entries[hole].value = NULL;
+    index->count--;
+    return true;
+}
+
+void clear_fibonacci_index(Fibonacci_Index *index) {
+    memset(index->entries, 0, index->capacity * sizeof(Fibonacci_Index_Entry));
+    index->count = 0;
+}
+
+void destroy_fibonacci_index(Fibonacci_Index *index) {
+    free(index->entries);
+    index->entries = NULL;
+    index->capacity = 0;
+    index->count = 0;
+}
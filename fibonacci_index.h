@@ -0,0 +1,47 @@
+#ifndef FIBONACCI_INDEX_H
+#define FIBONACCI_INDEX_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Open-addressing hash index from a 64-bit key to an opaque value (a node pointer).
+// Linear probing with backward-shift deletion, so there are no tombstones.
+//
+// Duplicate keys are allowed: every (key, value) pair gets its own slot, and all the
+// slots for one key sit in the same probe run. find_fibonacci_index returns the first
+// of them in probe order; remove_fibonacci_index removes one exact (key, value) pair.
+
+typedef struct Fibonacci_Index_Entry {
+    int64_t key;
+    void *value; // NULL marks an empty slot
+} Fibonacci_Index_Entry;
+
+typedef struct Fibonacci_Index {
+    Fibonacci_Index_Entry *entries;
+    size_t capacity; // Always a power of two
+    size_t count;
+} Fibonacci_Index;
+
+// Allocates room for at least 'expected' entries before the first resize.
+bool init_fibonacci_index(Fibonacci_Index *index, size_t expected);
+
+// Adds (key, value). 'value' must not be NULL. Returns false if growing the table failed.
+bool insert_fibonacci_index(Fibonacci_Index *index, int64_t key, void *value);
+
+// Grows the table so that 'additional' more entries fit without another resize.
+// Returns false if allocation failed; the index is unchanged in that case.
+bool reserve_fibonacci_index(Fibonacci_Index *index, size_t additional);
+
+// Returns a value stored under 'key', or NULL if there is none.
+void *find_fibonacci_index(const Fibonacci_Index *index, int64_t key);
+
+// Removes the (key, value) pair. Returns false if it was not in the index.
+bool remove_fibonacci_index(Fibonacci_Index *index, int64_t key, void *value);
+
+// Removes every entry but keeps the table allocated.
+void clear_fibonacci_index(Fibonacci_Index *index);
+
+void destroy_fibonacci_index(Fibonacci_Index *index);
+
+#endif // FIBONACCI_INDEX_H
@@ -0,0 +1,76 @@
+#include <limits.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include "fibonacci_parallel.h"
+
+// One thread's share of the build
+typedef struct Fibonacci_Build_Slice {
+    const Fibonacci_Key *keys;
+    size_t count;
+    Fibonacci_Heap *heap; // NULL if the build failed
+    pthread_t thread;
+    bool started;
+} Fibonacci_Build_Slice;
+
+// Forward declarations for helper functions
+static void *build_fib_heap_slice(void *arg);
+
+// Helper function run by each thread: builds the slice's heap from its own pool
+static void *build_fib_heap_slice(void *arg) {
+    Fibonacci_Build_Slice *slice = (Fibonacci_Build_Slice *)arg;
+    slice->heap = create_fib_heap();
+    if (slice->heap != NULL && !insert_many_fib_heap(slice->heap, slice->keys, slice->count)) {
+        destroy_fib_heap(slice->heap);
+        slice->heap = NULL;
+    }
+    return NULL;
+}
+
+// Function to build a heap from an array of keys with several threads
+Fibonacci_Heap *build_parallel_fib_heap(const Fibonacci_Key *keys, size_t count, size_t threads) {
+    if (threads == 0 || count > INT_MAX || (keys == NULL && count > 0)) {
+        return NULL;
+    }
+    if (threads > count / FIB_PARALLEL_MIN_SLICE) {
+        threads = count / FIB_PARALLEL_MIN_SLICE > 0 ? count / FIB_PARALLEL_MIN_SLICE : 1;
+    }
+    Fibonacci_Build_Slice *slices = (Fibonacci_Build_Slice *)malloc(threads * sizeof(Fibonacci_Build_Slice));
+    if (slices == NULL) {
+        return NULL; // Memory allocation failed
+    }
+
+    // a. Start a thread for every slice but the first, which the caller builds itself.
+    // Slice sizes differ by at most one key.
+    size_t start = 0;
+    for (size_t t = 0; t < threads; t++) {
+        size_t len = count / threads + (t < count % threads ? 1 : 0);
+        slices[t].keys = keys + start;
+        slices[t].count = len;
+        slices[t].heap = NULL;
+        slices[t].started = t > 0 && pthread_create(&slices[t].thread, NULL, build_fib_heap_slice, &slices[t]) == 0;
+        start += len;
+    }
+    for (size_t t = 0; t < threads; t++) {
+        if (t == 0 || !slices[t].started) {
+            build_fib_heap_slice(&slices[t]);
+        }
+    }
+
+    // b. Join the sub-heaps in order; every meld is O(1) because none has an index or a budget
+    bool ok = true;
+    for (size_t t = 0; t < threads; t++) {
+        if (slices[t].started) {
+            pthread_join(slices[t].thread, NULL);
+        }
+        ok = ok && slices[t].heap != NULL;
+    }
+    Fibonacci_Heap *heap = slices[0].heap;
+    for (size_t t = 1; t < threads && ok; t++) {
+        ok = meld_fib_heap(heap, slices[t].heap);
+    }
+    for (size_t t = ok ? 1 : 0; t < threads; t++) {
+        destroy_fib_heap(slices[t].heap); // Empty after a successful meld
+    }
+    free(slices);
+    return ok ? heap : NULL;
+}
@@ -0,0 +1,22 @@
+#ifndef FIBONACCI_PARALLEL_H
+#define FIBONACCI_PARALLEL_H
+
+#include <stddef.h>
+#include "fibonacci_heap.h"
+
+// Parallel bulk build of a Fibonacci heap. The keys are split into one contiguous slice per
+// thread; every thread builds a heap of its own with insert_many_fib_heap, carving its nodes
+// out of its own pool, so the threads share nothing and allocate in parallel. The sub-heaps
+// are then melded into the first one: each meld splices a root list and a chunk list and
+// compares two minima, O(1) per thread. Like insert_many_fib_heap, the result is one long
+// root list whose consolidation is left to the first extract_min.
+
+// Slices are at least this long; smaller inputs use fewer threads (down to just the caller)
+#define FIB_PARALLEL_MIN_SLICE 16384
+
+// Builds a heap of 'count' keys (with NULL payloads) using up to 'threads' threads, the
+// calling thread included. Returns NULL if threads is 0, count exceeds INT_MAX or
+// allocation failed. If a thread cannot be started, its slice is built by the caller.
+Fibonacci_Heap *build_parallel_fib_heap(const Fibonacci_Key *keys, size_t count, size_t threads);
+
+#endif // FIBONACCI_PARALLEL_H
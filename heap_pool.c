@@ -0,0 +1,94 @@
+#include <stdlib.h>
+#include <stdalign.h>
+#include "heap_pool.h"
+
+// Helper: the free list link lives in the first bytes of a recycled item
+static inline void **heap_pool_link(void *item) {
+    return (void **)item;
+}
+
+void init_heap_pool(Heap_Pool *pool, size_t item_size) {
+    size_t align = alignof(max_align_t);
+    if (item_size < sizeof(void *)) {
+        item_size = sizeof(void *); // Room for the free list link
+    }
+    pool->item_size = (item_size + align - 1) / align * align;
+    pool->chunks = NULL;
+    pool->chunks_tail = NULL;
+    pool->free_list = NULL;
+    pool->free_tail = NULL;
+    pool->next_chunk_capacity = HEAP_POOL_MIN_CHUNK;
+}
+
+void *alloc_heap_pool(Heap_Pool *pool) {
+    // a. Reuse a recycled item if there is one
+    if (pool->free_list != NULL) {
+        void *item = pool->free_list;
+        pool->free_list = *heap_pool_link(item);
+        if (pool->free_list == NULL) {
+            pool->free_tail = NULL;
+        }
+        return item;
+    }
+
+    // b. Otherwise bump-allocate from the newest chunk, adding a chunk when it is full
+    Heap_Pool_Chunk *chunk = pool->chunks;
+    if (chunk == NULL || chunk->used == chunk->capacity) {
+        size_t capacity = pool->next_chunk_capacity;
+        chunk = (Heap_Pool_Chunk *)malloc(sizeof(Heap_Pool_Chunk) + capacity * pool->item_size);
+        if (chunk == NULL) {
+            return NULL; // Memory allocation failed
+        }
+        chunk->capacity = capacity;
+        chunk->used = 0;
+        chunk->next = pool->chunks;
+        if (pool->chunks == NULL) {
+            pool->chunks_tail = chunk;
+        }
+        pool->chunks = chunk;
+        if (capacity < HEAP_POOL_MAX_CHUNK) {
+            pool->next_chunk_capacity = capacity * 2;
+        }
+    }
+    return HEAP_POOL_ITEM(pool, chunk, chunk->used++);
+}
+
+void free_heap_pool(Heap_Pool *pool, void *item) {
+    *heap_pool_link(item) = pool->free_list;
+    if (pool->free_list == NULL) {
+        pool->free_tail = item;
+    }
+    pool->free_list = item;
+}
+
+void splice_heap_pool(Heap_Pool *dst, Heap_Pool *src) {
+    // dst's newest chunk stays first so bump allocation continues where it was
+    if (src->chunks != NULL) {
+        if (dst->chunks == NULL) {
+            dst->chunks = src->chunks;
+            dst->next_chunk_capacity = src->next_chunk_capacity;
+        } else {
+            dst->chunks_tail->next = src->chunks;
+        }
+        dst->chunks_tail = src->chunks_tail;
+    }
+    if (src->free_list != NULL) {
+        if (dst->free_list == NULL) {
+            dst->free_list = src->free_list;
+        } else {
+            *heap_pool_link(dst->free_tail) = src->free_list;
+        }
+        dst->free_tail = src->free_tail;
+    }
+    init_heap_pool(src, src->item_size);
+}
+
+void destroy_heap_pool(Heap_Pool *pool) {
+    Heap_Pool_Chunk *chunk = pool->chunks;
+    while (chunk != NULL) {
+        Heap_Pool_Chunk *next = chunk->next;
+        free(chunk);
+        chunk = next;
+    }
+    init_heap_pool(pool, pool->item_size);
+}
@@ -0,0 +1,50 @@
+#ifndef HEAP_POOL_H
+#define HEAP_POOL_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+// Fixed-size item allocator shared by the heap engines other than Fibonacci_Heap (which
+// keeps its own Fibonacci_Node_Pool). Items are bump-allocated from chunks that grow
+// geometrically and are recycled through a free list threaded through their first
+// pointer-sized bytes, so an engine must not rely on those bytes once an item is freed.
+// Items never move, which is what lets engines hand out item pointers as handles.
+
+typedef struct Heap_Pool_Chunk {
+    struct Heap_Pool_Chunk *next;
+    size_t capacity; // Items in this chunk, each pool->item_size bytes apart
+    size_t used;     // Items handed out so far (bump allocation)
+    _Alignas(max_align_t) unsigned char items[];
+} Heap_Pool_Chunk;
+
+typedef struct Heap_Pool {
+    Heap_Pool_Chunk *chunks;      // Newest chunk first
+    Heap_Pool_Chunk *chunks_tail;
+    void *free_list;
+    void *free_tail;              // Last item of free_list, so splice_heap_pool is O(1)
+    size_t next_chunk_capacity;
+    size_t item_size;
+} Heap_Pool;
+
+#define HEAP_POOL_MIN_CHUNK 256
+#define HEAP_POOL_MAX_CHUNK 65536
+
+// Returns the i-th item of 'chunk'; used to visit every item ever handed out.
+#define HEAP_POOL_ITEM(pool, chunk, i) ((void *)((chunk)->items + (pool)->item_size * (i)))
+
+// 'item_size' is rounded up so consecutive items stay aligned for any type.
+void init_heap_pool(Heap_Pool *pool, size_t item_size);
+
+// Returns an uninitialized item, or NULL if allocation failed.
+void *alloc_heap_pool(Heap_Pool *pool);
+
+void free_heap_pool(Heap_Pool *pool, void *item);
+
+// Moves every chunk and recycled item of 'src' into 'dst' in O(1) and leaves 'src' empty.
+// Both pools must have the same item_size.
+void splice_heap_pool(Heap_Pool *dst, Heap_Pool *src);
+
+// Releases every chunk. Items are not visited; the owner does that first if it needs to.
+void destroy_heap_pool(Heap_Pool *pool);
+
+#endif // HEAP_POOL_H
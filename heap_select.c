@@ -0,0 +1,211 @@
+#include <stdlib.h>
+#include <string.h>
+#include "heap_select.h"
+
+// Forward declarations for helper functions
+static int64_t rank_heap_select(const Heap_Select *s, int64_t key);
+static void sift_up_ranks(int64_t *ranks, void **payloads, size_t i);
+static void sift_down_ranks(int64_t *ranks, void **payloads, size_t n, size_t i);
+static void replace_root_heap_select(Heap_Select *s, int64_t rank, void *payload);
+
+// Function to create an empty selector
+Heap_Select *create_heap_select(size_t k, bool largest) {
+    if (k == 0 || k > SIZE_MAX / sizeof(int64_t)) {
+        return NULL;
+    }
+    Heap_Select *s = (Heap_Select *)malloc(sizeof(Heap_Select));
+    if (s == NULL) {
+        return NULL; // Memory allocation failed
+    }
+    s->ranks = (int64_t *)malloc(k * sizeof(int64_t));
+    s->payloads = (void **)malloc(k * sizeof(void *));
+    if (s->ranks == NULL || s->payloads == NULL) {
+        free(s->ranks);
+        free(s->payloads);
+        free(s);
+        return NULL;
+    }
+    s->n = 0;
+    s->k = k;
+    s->largest = largest;
+    s->free_payload = NULL;
+    return s;
+}
+
+// Helper function to map a key to its rank (larger is better); it is its own inverse
+static int64_t rank_heap_select(const Heap_Select *s, int64_t key) {
+    return s->largest ? key : ~key;
+}
+
+// Helper function to move entry i of a min-heap of ranks up to its place. 'payloads' may be NULL.
+static void sift_up_ranks(int64_t *ranks, void **payloads, size_t i) {
+    int64_t rank = ranks[i];
+    void *payload = payloads != NULL ? payloads[i] : NULL;
+    while (i > 0) {
+        size_t parent = (i - 1) / HEAP_SELECT_ARITY;
+        if (ranks[parent] <= rank) {
+            break;
+        }
+        ranks[i] = ranks[parent];
+        if (payloads != NULL) {
+            payloads[i] = payloads[parent];
+        }
+        i = parent;
+    }
+    ranks[i] = rank;
+    if (payloads != NULL) {
+        payloads[i] = payload;
+    }
+}
+
+// Helper function to move entry i of a min-heap of n ranks down to its place. 'payloads' may be NULL.
+static void sift_down_ranks(int64_t *ranks, void **payloads, size_t n, size_t i) {
+    int64_t rank = ranks[i];
+    void *payload = payloads != NULL ? payloads[i] : NULL;
+    for (;;) {
+        // a. Find the smallest child, if any
+        size_t first = i * HEAP_SELECT_ARITY + 1;
+        if (first >= n) {
+            break;
+        }
+        size_t last = first + HEAP_SELECT_ARITY < n ? first + HEAP_SELECT_ARITY : n;
+        size_t smallest = first;
+        for (size_t c = first + 1; c < last; c++) {
+            if (ranks[c] < ranks[smallest]) {
+                smallest = c;
+            }
+        }
+
+        // b. Stop once no child is smaller; otherwise pull it up
+        if (ranks[smallest] >= rank) {
+            break;
+        }
+        ranks[i] = ranks[smallest];
+        if (payloads != NULL) {
+            payloads[i] = payloads[smallest];
+        }
+        i = smallest;
+    }
+    ranks[i] = rank;
+    if (payloads != NULL) {
+        payloads[i] = payload;
+    }
+}
+
+// Helper function to put a better element in place of the worst one kept
+static void replace_root_heap_select(Heap_Select *s, int64_t rank, void *payload) {
+    void *evicted = s->payloads[0];
+    if (s->free_payload != NULL && evicted != NULL) {
+        s->free_payload(evicted);
+    }
+    s->ranks[0] = rank;
+    s->payloads[0] = payload;
+    sift_down_ranks(s->ranks, s->payloads, s->n, 0);
+}
+
+// Function to offer one key to the selector
+bool insert_heap_select(Heap_Select *s, int64_t key, void *payload) {
+    if (s == NULL) {
+        return false;
+    }
+    int64_t rank = rank_heap_select(s, key);
+    if (s->n < s->k) {
+        s->ranks[s->n] = rank;
+        s->payloads[s->n] = payload;
+        sift_up_ranks(s->ranks, s->payloads, s->n++);
+        return true;
+    }
+    if (rank <= s->ranks[0]) {
+        return false; // No better than the k-th best
+    }
+    replace_root_heap_select(s, rank, payload);
+    return true;
+}
+
+// Function to offer many keys to the selector
+size_t insert_many_heap_select(Heap_Select *s, const int64_t *keys, size_t count) {
+    if (s == NULL || keys == NULL) {
+        return 0;
+    }
+    size_t kept = 0, i = 0;
+
+    // a. Fill up to k
+    for (; i < count && s->n < s->k; i++, kept++) {
+        s->ranks[s->n] = rank_heap_select(s, keys[i]);
+        s->payloads[s->n] = NULL;
+        sift_up_ranks(s->ranks, s->payloads, s->n++);
+    }
+
+    // b. Then most keys only meet the threshold, which is reloaded after each replacement
+    int64_t threshold = s->n > 0 ? s->ranks[0] : 0;
+    for (; i < count; i++) {
+        int64_t rank = rank_heap_select(s, keys[i]);
+        if (rank <= threshold) {
+            continue;
+        }
+        replace_root_heap_select(s, rank, NULL);
+        threshold = s->ranks[0];
+        kept++;
+    }
+    return kept;
+}
+
+bool get_threshold_heap_select(const Heap_Select *s, int64_t *key_out) {
+    if (s == NULL || s->n < s->k) {
+        return false;
+    }
+    if (key_out != NULL) {
+        *key_out = rank_heap_select(s, s->ranks[0]);
+    }
+    return true;
+}
+
+// Function to list the kept elements best first
+size_t sorted_heap_select(const Heap_Select *s, int64_t *keys_out, void **payloads_out) {
+    if (s == NULL || keys_out == NULL) {
+        return 0;
+    }
+    // Heapsort a copy of the min-heap: moving each minimum behind the shrinking heap leaves
+    // the ranks in descending order, best first
+    memcpy(keys_out, s->ranks, s->n * sizeof(int64_t));
+    if (payloads_out != NULL) {
+        memcpy(payloads_out, s->payloads, s->n * sizeof(void *));
+    }
+    for (size_t end = s->n; end > 1; end--) {
+        int64_t rank = keys_out[0];
+        keys_out[0] = keys_out[end - 1];
+        keys_out[end - 1] = rank;
+        if (payloads_out != NULL) {
+            void *payload = payloads_out[0];
+            payloads_out[0] = payloads_out[end - 1];
+            payloads_out[end - 1] = payload;
+        }
+        sift_down_ranks(keys_out, payloads_out, end - 1, 0);
+    }
+    for (size_t i = 0; i < s->n; i++) {
+        keys_out[i] = rank_heap_select(s, keys_out[i]);
+    }
+    return s->n;
+}
+
+void clear_heap_select(Heap_Select *s) {
+    if (s == NULL) {
+        return;
+    }
+    for (size_t i = 0; s->free_payload != NULL && i < s->n; i++) {
+        if (s->payloads[i] != NULL) {
+            s->free_payload(s->payloads[i]);
+        }
+    }
+    s->n = 0;
+}
+
+void destroy_heap_select(Heap_Select *s) {
+    if (s == NULL) {
+        return;
+    }
+    clear_heap_select(s);
+    free(s->ranks);
+    free(s->payloads);
+    free(s);
+}
@@ -0,0 +1,59 @@
+#ifndef HEAP_SELECT_H
+#define HEAP_SELECT_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Streaming selection of the k largest (top-k) or k smallest (bottom-k) keys of a stream.
+// The selector keeps at most k elements in one preallocated array, ordered as an implicit
+// d-ary heap with the worst kept element, the current k-th best, at the root. Once k
+// elements are kept, a candidate no better than the root is rejected with one comparison;
+// a better one replaces the root and is sifted down in O(log k). Memory is O(k) and nothing
+// is allocated after create_heap_select, so a stream of any length costs O(n + r log k) for
+// r replacements (r is O(k log(n/k)) in expectation for a randomly ordered stream).
+//
+// Keys are stored as ranks in which larger means better: the key itself for top-k and its
+// bitwise complement (~key, which reverses the order of int64 without overflow) for
+// bottom-k, so both directions share one min-heap of ranks.
+
+#define HEAP_SELECT_ARITY 4
+
+typedef struct Heap_Select {
+    int64_t *ranks;   // k entries; ranks[0] is the worst element kept
+    void **payloads;  // k entries, moved along with ranks
+    size_t n;
+    size_t k;
+    bool largest;     // Top-k if true, bottom-k if false
+    // Called on payloads the selector drops on its own (evicted elements and
+    // destroy_heap_select). NULL by default: payloads are left alone.
+    void (*free_payload)(void *payload);
+} Heap_Select;
+
+// Creates a selector for the k largest (largest == true) or k smallest keys.
+// Returns NULL if k is 0 or allocation failed.
+Heap_Select *create_heap_select(size_t k, bool largest);
+
+// Offers 'key' with an optional 'payload'. Returns true if it is kept (evicting the worst
+// element if k were kept already) and false if it was rejected, in which case the payload
+// stays with the caller. Ties with the k-th best are rejected.
+bool insert_heap_select(Heap_Select *s, int64_t key, void *payload);
+
+// Offers 'count' keys (with NULL payloads). Returns how many of them were kept at the time.
+size_t insert_many_heap_select(Heap_Select *s, const int64_t *keys, size_t count);
+
+// Copies the k-th best key, which a candidate has to beat, to *key_out. Returns false while
+// fewer than k elements are kept (every candidate is accepted then).
+bool get_threshold_heap_select(const Heap_Select *s, int64_t *key_out);
+
+// Writes the kept keys best first to keys_out[0..] (and their payloads to payloads_out if it
+// is not NULL), leaving the selector unchanged. Both arrays need room for s->n entries.
+// Returns s->n.
+size_t sorted_heap_select(const Heap_Select *s, int64_t *keys_out, void **payloads_out);
+
+// Drops every element (passing payloads to s->free_payload if set); k stays.
+void clear_heap_select(Heap_Select *s);
+
+void destroy_heap_select(Heap_Select *s);
+
+#endif // HEAP_SELECT_H
@@ -0,0 +1,252 @@
+#include <stdlib.h>
+#include "multi_queue.h"
+
+// Extractions that found two empty shards this many times in a row check every shard
+#define MULTI_QUEUE_EMPTY_SAMPLES 4
+
+// Forward declarations for helper functions
+static size_t random_shard(const Multi_Queue *mq);
+static bool try_lock_shard(Multi_Queue_Shard *shard);
+static void unlock_shard(Multi_Queue_Shard *shard);
+static Multi_Queue_Shard *lock_random_shard(Multi_Queue *mq);
+static void publish_shard(Multi_Queue_Shard *shard);
+static bool shard_before(Multi_Queue_Shard *a, Multi_Queue_Shard *b);
+static Multi_Queue_Shard *first_nonempty_shard(Multi_Queue *mq);
+
+// Per-thread random state, seeded on first use from a shared counter
+static _Thread_local uint64_t rng_state;
+static atomic_uint_fast64_t rng_seed;
+
+// Function to create an empty MultiQueue
+Multi_Queue *create_multi_queue(size_t threads, size_t factor) {
+    if (threads == 0 || factor == 0 || threads > SIZE_MAX / factor) {
+        return NULL;
+    }
+    size_t count = threads * factor < MULTI_QUEUE_MIN_SHARDS ? MULTI_QUEUE_MIN_SHARDS : threads * factor;
+    if (count > SIZE_MAX / sizeof(Multi_Queue_Shard)) {
+        return NULL;
+    }
+    Multi_Queue *mq = (Multi_Queue *)malloc(sizeof(Multi_Queue));
+    if (mq == NULL) {
+        return NULL; // Memory allocation failed
+    }
+    // sizeof(Multi_Queue_Shard) is a multiple of the cache line, as aligned_alloc requires
+    mq->shards = (Multi_Queue_Shard *)aligned_alloc(MULTI_QUEUE_CACHE_LINE, count * sizeof(Multi_Queue_Shard));
+    if (mq->shards == NULL) {
+        free(mq);
+        return NULL;
+    }
+    mq->count = 0;
+    mq->free_payload = NULL;
+    for (size_t i = 0; i < count; i++) {
+        Multi_Queue_Shard *shard = &mq->shards[i];
+        atomic_flag_clear(&shard->lock);
+        atomic_init(&shard->top, 0);
+        atomic_init(&shard->n, 0);
+        shard->heap = create_fib_heap();
+        if (shard->heap == NULL) {
+            destroy_multi_queue(mq); // Releases the shards created so far
+            return NULL;
+        }
+        mq->count++;
+    }
+    return mq;
+}
+
+// Helper function to pick a shard uniformly at random with the calling thread's xorshift state
+static size_t random_shard(const Multi_Queue *mq) {
+    uint64_t x = rng_state;
+    if (x == 0) {
+        // splitmix64 of a fresh counter value, so threads start far apart
+        x = atomic_fetch_add(&rng_seed, 1) + 0x9E3779B97F4A7C15ULL;
+        x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+        x = (x ^ (x >> 31)) | 1;
+    }
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    rng_state = x;
+    return (size_t)((x * 0x2545F4914F6CDD1DULL) >> 32) % mq->count;
+}
+
+// Helper function to take a shard's lock without waiting. Returns false if it is taken.
+static bool try_lock_shard(Multi_Queue_Shard *shard) {
+    return !atomic_flag_test_and_set_explicit(&shard->lock, memory_order_acquire);
+}
+
+static void unlock_shard(Multi_Queue_Shard *shard) {
+    atomic_flag_clear_explicit(&shard->lock, memory_order_release);
+}
+
+// Helper function to lock some random shard, sampling again whenever the pick is taken
+static Multi_Queue_Shard *lock_random_shard(Multi_Queue *mq) {
+    for (;;) {
+        Multi_Queue_Shard *shard = &mq->shards[random_shard(mq)];
+        if (try_lock_shard(shard)) {
+            return shard;
+        }
+    }
+}
+
+// Helper function to refresh the lock-free view of a locked shard after it changed
+static void publish_shard(Multi_Queue_Shard *shard) {
+    int64_t top;
+    if (get_min_fib_heap_key(shard->heap, &top, NULL)) {
+        atomic_store_explicit(&shard->top, top, memory_order_relaxed);
+    }
+    atomic_store_explicit(&shard->n, (size_t)shard->heap->n, memory_order_relaxed);
+}
+
+// Helper function returning true if shard a looks like the better one to pop from: it is not
+// empty and its minimum is smaller than b's. The view may be stale; the lock decides.
+static bool shard_before(Multi_Queue_Shard *a, Multi_Queue_Shard *b) {
+    if (atomic_load_explicit(&a->n, memory_order_relaxed) == 0) {
+        return false;
+    }
+    if (atomic_load_explicit(&b->n, memory_order_relaxed) == 0) {
+        return true;
+    }
+    return atomic_load_explicit(&a->top, memory_order_relaxed) < atomic_load_explicit(&b->top, memory_order_relaxed);
+}
+
+// Helper function to find a shard that looks non-empty, starting at a random one
+static Multi_Queue_Shard *first_nonempty_shard(Multi_Queue *mq) {
+    size_t start = random_shard(mq);
+    for (size_t i = 0; i < mq->count; i++) {
+        Multi_Queue_Shard *shard = &mq->shards[(start + i) % mq->count];
+        if (atomic_load_explicit(&shard->n, memory_order_relaxed) > 0) {
+            return shard;
+        }
+    }
+    return NULL;
+}
+
+// Function to insert a key into a random shard
+bool insert_multi_queue(Multi_Queue *mq, int64_t key, void *payload) {
+    if (mq == NULL) {
+        return false;
+    }
+    Multi_Queue_Shard *shard = lock_random_shard(mq);
+    bool inserted = insert_fib_heap_key(shard->heap, key, payload) != NULL;
+    publish_shard(shard);
+    unlock_shard(shard);
+    return inserted;
+}
+
+// Function to insert many keys, one batch per shard
+bool insert_many_multi_queue(Multi_Queue *mq, const int64_t *keys, size_t count) {
+    if (mq == NULL || (keys == NULL && count > 0)) {
+        return false;
+    }
+    // Inputs are often sorted, and a batch of neighbouring keys in one shard would raise the
+    // rank error to about m * MULTI_QUEUE_BATCH. So each block of up to m batches is dealt
+    // out in stripes, batch r taking every m-th key from the r-th on, and the stripes go to
+    // consecutive shards from a random one, which keeps the shards level. A busy shard is
+    // not waited for: its stripe goes to a random one instead.
+    int64_t stripe[MULTI_QUEUE_BATCH];
+    size_t block = mq->count * MULTI_QUEUE_BATCH;
+    for (size_t start = 0; start < count; start += block) {
+        size_t len = count - start < block ? count - start : block;
+        size_t lanes = len < mq->count ? len : mq->count;
+        size_t first = random_shard(mq);
+        for (size_t r = 0; r < lanes; r++) {
+            size_t batch = 0;
+            for (size_t i = r; i < len; i += mq->count) {
+                stripe[batch++] = keys[start + i];
+            }
+            Multi_Queue_Shard *shard = &mq->shards[(first + r) % mq->count];
+            if (!try_lock_shard(shard)) {
+                shard = lock_random_shard(mq);
+            }
+            bool inserted = insert_many_fib_heap(shard->heap, stripe, batch);
+            publish_shard(shard);
+            unlock_shard(shard);
+            if (!inserted) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// Function to extract one of the smallest elements
+bool extract_min_multi_queue(Multi_Queue *mq, int64_t *key_out, void **payload_out) {
+    if (mq == NULL) {
+        return false;
+    }
+    int empty_samples = 0;
+    for (;;) {
+        // a. Sample two shards and take the one with the smaller minimum
+        Multi_Queue_Shard *a = &mq->shards[random_shard(mq)];
+        Multi_Queue_Shard *b = &mq->shards[random_shard(mq)];
+        Multi_Queue_Shard *shard = shard_before(b, a) ? b : a;
+
+        // b. Both looked empty: after a few tries, settle whether anything is left at all
+        if (atomic_load_explicit(&shard->n, memory_order_relaxed) == 0) {
+            if (++empty_samples < MULTI_QUEUE_EMPTY_SAMPLES) {
+                continue;
+            }
+            empty_samples = 0;
+            shard = first_nonempty_shard(mq);
+            if (shard == NULL) {
+                return false;
+            }
+        }
+
+        // c. Pop from it unless another thread holds it, in which case sample again
+        if (!try_lock_shard(shard)) {
+            continue;
+        }
+        bool found = extract_min_fib_heap_key(shard->heap, key_out, payload_out);
+        publish_shard(shard);
+        unlock_shard(shard);
+        if (found) {
+            return true;
+        }
+    }
+}
+
+// Function to extract up to k elements
+size_t extract_min_many_multi_queue(Multi_Queue *mq, int64_t *keys_out, void **payloads_out, size_t k) {
+    if (mq == NULL || keys_out == NULL) {
+        return 0;
+    }
+    size_t extracted = 0;
+    while (extracted < k) {
+        void *payload;
+        if (!extract_min_multi_queue(mq, &keys_out[extracted], &payload)) {
+            break; // Every shard is empty
+        }
+        if (payloads_out != NULL) {
+            payloads_out[extracted] = payload;
+        } else if (mq->free_payload != NULL && payload != NULL) {
+            mq->free_payload(payload);
+        }
+        extracted++;
+    }
+    return extracted;
+}
+
+size_t size_multi_queue(const Multi_Queue *mq) {
+    if (mq == NULL) {
+        return 0;
+    }
+    size_t n = 0;
+    for (size_t i = 0; i < mq->count; i++) {
+        n += atomic_load_explicit(&mq->shards[i].n, memory_order_relaxed);
+    }
+    return n;
+}
+
+void destroy_multi_queue(Multi_Queue *mq) {
+    if (mq == NULL) {
+        return;
+    }
+    for (size_t i = 0; i < mq->count; i++) {
+        mq->shards[i].heap->free_payload = mq->free_payload;
+        destroy_fib_heap(mq->shards[i].heap);
+    }
+    free(mq->shards);
+    free(mq);
+}
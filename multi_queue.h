@@ -0,0 +1,76 @@
+#ifndef MULTI_QUEUE_H
+#define MULTI_QUEUE_H
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "fibonacci_heap.h"
+
+// Relaxed concurrent priority queue (the MultiQueue of Rihani, Sanders and Dementiev):
+// m = c*P Fibonacci heaps ("shards") for P threads, each behind its own try-lock. An insert
+// goes to a random shard. An extraction samples two shards, compares their cached minima
+// without locking and pops from the better one. A thread never waits for a lock: if the
+// shard it picked is busy, it samples again. With c >= 2 most picks find a free shard,
+// so throughput grows almost linearly with the number of threads.
+//
+// The price is ordering: extract_min returns one of the smallest elements, not always the
+// smallest. Number the elements 0, 1, ... by key; the rank error of an extraction is the
+// number of the element it returned. Sampling two shards keeps the rank error at O(m) in
+// expectation and O(m log m) with high probability (Alistarh et al., "The Power of Choice
+// in Priority Scheduling", PODC 2017), independent of the queue's size. With one sample
+// instead of two the error would grow without bound. Choose c as small as contention
+// allows (2 is typical) to keep m, and with it the rank error, small.
+//
+// insert, insert_many, extract_min, extract_min_many and size_multi_queue may be called
+// from any number of threads at once; create and destroy may not.
+
+#define MULTI_QUEUE_CACHE_LINE 64
+#define MULTI_QUEUE_MIN_SHARDS 2
+#define MULTI_QUEUE_BATCH 64  // Keys insert_many_multi_queue puts into one shard at a time
+
+// Each shard sits on cache lines of its own, so threads using different shards do not
+// contend for the same line.
+typedef struct Multi_Queue_Shard {
+    _Alignas(MULTI_QUEUE_CACHE_LINE) atomic_flag lock;
+    _Atomic int64_t top;  // Minimum key of 'heap' (if n > 0), read without the lock
+    _Atomic size_t n;     // Elements in 'heap', read without the lock
+    Fibonacci_Heap *heap;
+} Multi_Queue_Shard;
+
+typedef struct Multi_Queue {
+    Multi_Queue_Shard *shards;
+    size_t count;  // m = threads * factor
+    // Called on payloads the queue drops on its own (extract_min_many_multi_queue and
+    // destroy_multi_queue). NULL by default: payloads are left alone.
+    void (*free_payload)(void *payload);
+} Multi_Queue;
+
+// Creates an empty queue of threads * factor shards (at least MULTI_QUEUE_MIN_SHARDS).
+// Returns NULL if either argument is 0 or allocation failed.
+Multi_Queue *create_multi_queue(size_t threads, size_t factor);
+
+// Inserts 'key' with an optional 'payload' into a random shard. Returns false if
+// allocation failed.
+bool insert_multi_queue(Multi_Queue *mq, int64_t key, void *payload);
+
+// Inserts 'count' keys (with NULL payloads) in batches of up to MULTI_QUEUE_BATCH per random
+// shard; a batch holds every m-th key of its block, so sorted input spreads evenly. Returns
+// false if allocation failed; keys of earlier batches stay in the queue.
+bool insert_many_multi_queue(Multi_Queue *mq, const int64_t *keys, size_t count);
+
+// Removes one of the smallest elements (see the rank error above). Returns false if
+// every shard was empty when checked.
+bool extract_min_multi_queue(Multi_Queue *mq, int64_t *key_out, void **payload_out);
+
+// Removes up to k elements with extract_min_multi_queue, writing their keys to keys_out[0..]
+// (in roughly ascending order). Payloads go to payloads_out if it is not NULL and are
+// otherwise passed to mq->free_payload (if set). Returns how many elements were removed.
+size_t extract_min_many_multi_queue(Multi_Queue *mq, int64_t *keys_out, void **payloads_out, size_t k);
+
+// Number of elements; a snapshot that concurrent operations may change at once.
+size_t size_multi_queue(const Multi_Queue *mq);
+
+void destroy_multi_queue(Multi_Queue *mq);
+
+#endif // MULTI_QUEUE_H
@@ -0,0 +1,287 @@
+#include <stdlib.h>
+#include "pairing_heap.h"
+
+// Forward declarations for helper functions
+static Pairing_Node *link_pairing_nodes(Pairing_Node *a, Pairing_Node *b);
+static Pairing_Node *merge_pairs_pairing_heap(Pairing_Node *first);
+static void cut_pairing_node(Pairing_Node *node);
+static Pairing_Node *next_preorder_pairing_node(Pairing_Node *node);
+
+// Function to create an empty pairing heap
+Pairing_Heap *create_pairing_heap(void) {
+    Pairing_Heap *h = (Pairing_Heap *)malloc(sizeof(Pairing_Heap));
+    if (h == NULL) {
+        return NULL; // Memory allocation failed
+    }
+    h->root = NULL;
+    h->n = 0;
+    h->free_payload = NULL;
+    init_heap_pool(&h->nodes, sizeof(Pairing_Node));
+    return h;
+}
+
+// Helper function to link two detached trees (either may be NULL), returning the new root.
+// The root with the larger key becomes the leftmost child of the other; ties keep 'a' on top.
+static Pairing_Node *link_pairing_nodes(Pairing_Node *a, Pairing_Node *b) {
+    if (a == NULL) {
+        return b;
+    }
+    if (b == NULL) {
+        return a;
+    }
+    if (b->key < a->key) {
+        Pairing_Node *tmp = a;
+        a = b;
+        b = tmp;
+    }
+    b->next = a->child;
+    if (a->child != NULL) {
+        a->child->prev = b;
+    }
+    b->prev = a;
+    a->child = b;
+    return a;
+}
+
+// Helper function to combine a sibling list into one tree with the two-pass rule
+static Pairing_Node *merge_pairs_pairing_heap(Pairing_Node *first) {
+    // a. Left to right: link neighbours in pairs, stacking the results in reverse through next
+    Pairing_Node *pairs = NULL;
+    while (first != NULL) {
+        Pairing_Node *a = first;
+        Pairing_Node *b = a->next;
+        first = b != NULL ? b->next : NULL;
+        a->prev = a->next = NULL;
+        if (b != NULL) {
+            b->prev = b->next = NULL;
+            a = link_pairing_nodes(a, b);
+        }
+        a->next = pairs;
+        pairs = a;
+    }
+
+    // b. Right to left: fold the pairs into one tree, starting from the last pair
+    Pairing_Node *root = NULL;
+    while (pairs != NULL) {
+        Pairing_Node *next = pairs->next;
+        pairs->next = NULL;
+        root = link_pairing_nodes(root, pairs);
+        pairs = next;
+    }
+    return root;
+}
+
+// Helper function to detach a non-root node (with its subtree) from its parent and siblings
+static void cut_pairing_node(Pairing_Node *node) {
+    if (node->prev->child == node) {
+        node->prev->child = node->next; // Leftmost child: prev is the parent
+    } else {
+        node->prev->next = node->next;
+    }
+    if (node->next != NULL) {
+        node->next->prev = node->prev;
+    }
+    node->prev = node->next = NULL;
+}
+
+// Helper function to step to the next node in preorder without a stack: down to the
+// leftmost child, else right to the next sibling of the node or of its nearest ancestor
+static Pairing_Node *next_preorder_pairing_node(Pairing_Node *node) {
+    if (node->child != NULL) {
+        return node->child;
+    }
+    while (node != NULL && node->next == NULL) {
+        // Walk left to the leftmost sibling, whose prev is the parent (NULL at the root)
+        while (node->prev != NULL && node->prev->child != node) {
+            node = node->prev;
+        }
+        node = node->prev;
+    }
+    return node != NULL ? node->next : NULL;
+}
+
+// Function to insert a key into the pairing heap
+Pairing_Node *insert_pairing_heap(Pairing_Heap *h, int64_t key, void *payload) {
+    if (h == NULL) {
+        return NULL;
+    }
+    Pairing_Node *node = (Pairing_Node *)alloc_heap_pool(&h->nodes);
+    if (node == NULL) {
+        return NULL; // Memory allocation failed
+    }
+    node->key = key;
+    node->payload = payload;
+    node->child = node->next = node->prev = NULL;
+    h->root = link_pairing_nodes(h->root, node);
+    h->n++;
+    return node;
+}
+
+// Function to insert many keys at once
+bool insert_many_pairing_heap(Pairing_Heap *h, const int64_t *keys, size_t count) {
+    if (h == NULL || (keys == NULL && count > 0)) {
+        return false;
+    }
+
+    // a. Chain the new nodes as one sibling list, releasing them again if the pool runs dry
+    Pairing_Node *list = NULL;
+    for (size_t i = count; i-- > 0;) {
+        Pairing_Node *node = (Pairing_Node *)alloc_heap_pool(&h->nodes);
+        if (node == NULL) {
+            while (list != NULL) {
+                Pairing_Node *next = list->next;
+                free_heap_pool(&h->nodes, list);
+                list = next;
+            }
+            return false;
+        }
+        node->key = keys[i];
+        node->payload = NULL;
+        node->child = node->prev = NULL;
+        node->next = list;
+        list = node;
+    }
+
+    // b. Pair the batch into one tree and link it under the current root
+    h->root = link_pairing_nodes(h->root, merge_pairs_pairing_heap(list));
+    h->n += count;
+    return true;
+}
+
+// Function to get the minimum without removing it
+bool get_min_pairing_heap(const Pairing_Heap *h, int64_t *key_out, void **payload_out) {
+    if (h == NULL || h->root == NULL) {
+        return false;
+    }
+    if (key_out != NULL) {
+        *key_out = h->root->key;
+    }
+    if (payload_out != NULL) {
+        *payload_out = h->root->payload;
+    }
+    return true;
+}
+
+// Function to extract the minimum
+bool extract_min_pairing_heap(Pairing_Heap *h, int64_t *key_out, void **payload_out) {
+    if (h == NULL || h->root == NULL) {
+        return false;
+    }
+    return delete_node_pairing_heap(h, h->root, key_out, payload_out);
+}
+
+// Function to extract up to k minimum keys at once
+size_t extract_min_many_pairing_heap(Pairing_Heap *h, int64_t *keys_out, void **payloads_out, size_t k) {
+    if (h == NULL || keys_out == NULL) {
+        return 0;
+    }
+    size_t extracted = 0;
+    while (extracted < k && h->root != NULL) {
+        void *payload;
+        delete_node_pairing_heap(h, h->root, &keys_out[extracted], &payload);
+        if (payloads_out != NULL) {
+            payloads_out[extracted] = payload;
+        } else if (h->free_payload != NULL && payload != NULL) {
+            h->free_payload(payload);
+        }
+        extracted++;
+    }
+    return extracted;
+}
+
+// Function to decrease the key of a node
+bool decrease_key_pairing_heap(Pairing_Heap *h, Pairing_Node *node, int64_t new_key) {
+    if (h == NULL || node == NULL || new_key > node->key) {
+        return false;
+    }
+    node->key = new_key;
+    if (node != h->root) {
+        // The subtree stays heap-ordered; only the link to the parent may be violated
+        cut_pairing_node(node);
+        h->root = link_pairing_nodes(h->root, node);
+    }
+    return true;
+}
+
+// Function to change the key of a node in either direction
+void change_key_pairing_heap(Pairing_Heap *h, Pairing_Node *node, int64_t new_key) {
+    if (new_key <= node->key) {
+        decrease_key_pairing_heap(h, node, new_key);
+        return;
+    }
+    // A larger key may violate the order below the node: detach it, give its children back
+    // to the heap and link it in again as a single node
+    if (node == h->root) {
+        h->root = NULL;
+    } else {
+        cut_pairing_node(node);
+    }
+    Pairing_Node *children = merge_pairs_pairing_heap(node->child);
+    node->child = NULL;
+    node->key = new_key;
+    h->root = link_pairing_nodes(link_pairing_nodes(h->root, children), node);
+}
+
+// Function to delete a specific node
+bool delete_node_pairing_heap(Pairing_Heap *h, Pairing_Node *node, int64_t *key_out, void **payload_out) {
+    if (h == NULL || node == NULL) {
+        return false;
+    }
+    if (key_out != NULL) {
+        *key_out = node->key;
+    }
+    if (payload_out != NULL) {
+        *payload_out = node->payload;
+    }
+    Pairing_Node *children = merge_pairs_pairing_heap(node->child);
+    if (node == h->root) {
+        h->root = children;
+    } else {
+        cut_pairing_node(node);
+        h->root = link_pairing_nodes(h->root, children);
+    }
+    free_heap_pool(&h->nodes, node);
+    h->n--;
+    return true;
+}
+
+// Function to find a node by its key
+Pairing_Node *find_node_pairing_heap_key(const Pairing_Heap *h, int64_t key) {
+    if (h == NULL) {
+        return NULL;
+    }
+    for (Pairing_Node *node = h->root; node != NULL; node = next_preorder_pairing_node(node)) {
+        if (node->key == key) {
+            return node;
+        }
+    }
+    return NULL;
+}
+
+// Function to meld two pairing heaps
+bool meld_pairing_heap(Pairing_Heap *dst, Pairing_Heap *src) {
+    if (dst == NULL || src == NULL || dst == src) {
+        return false;
+    }
+    dst->root = link_pairing_nodes(dst->root, src->root);
+    dst->n += src->n;
+    splice_heap_pool(&dst->nodes, &src->nodes); // The nodes' memory now belongs to dst
+    src->root = NULL;
+    src->n = 0;
+    return true;
+}
+
+void destroy_pairing_heap(Pairing_Heap *h) {
+    if (h == NULL) {
+        return;
+    }
+    if (h->free_payload != NULL) {
+        for (Pairing_Node *node = h->root; node != NULL; node = next_preorder_pairing_node(node)) {
+            if (node->payload != NULL) {
+                h->free_payload(node->payload);
+            }
+        }
+    }
+    destroy_heap_pool(&h->nodes);
+    free(h);
+}
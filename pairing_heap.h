@@ -0,0 +1,72 @@
+#ifndef PAIRING_HEAP_H
+#define PAIRING_HEAP_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "heap_pool.h"
+
+// Pairing heap with two-pass merging. It offers the operations of fibonacci_heap.h with
+// O(1) insert and meld, O(log n) amortized extract_min and delete, and o(log n) amortized
+// decrease_key. There are no marks, no degree table and no cascading cuts: every
+// restructuring is a link of two roots, which tends to make it faster in practice.
+//
+// Each tree is stored as a binary tree: 'child' is the leftmost child and 'next' the
+// sibling to its right. 'prev' is the sibling to the left, or the parent for a leftmost
+// child, so a node can be cut out in O(1). Nodes come from a pool and never move, so
+// they serve as handles.
+
+typedef struct Pairing_Node {
+    int64_t key;
+    void *payload;              // Optional opaque data attached by the caller
+    struct Pairing_Node *child;
+    struct Pairing_Node *next;
+    struct Pairing_Node *prev;
+} Pairing_Node;
+
+typedef struct Pairing_Heap {
+    Pairing_Node *root;
+    size_t n;
+    Heap_Pool nodes;
+    // Called on payloads the heap drops on its own (extract_min_many_pairing_heap and
+    // destroy_pairing_heap). NULL by default: payloads are left alone.
+    void (*free_payload)(void *payload);
+} Pairing_Heap;
+
+Pairing_Heap *create_pairing_heap(void);
+
+// Inserts 'key' with an optional 'payload'. Returns the new node, or NULL if allocation
+// failed.
+Pairing_Node *insert_pairing_heap(Pairing_Heap *h, int64_t key, void *payload);
+
+// Inserts 'count' keys (with NULL payloads): the batch is paired up into one tree in
+// O(count) and linked under the root. All or nothing: returns false if allocation failed.
+bool insert_many_pairing_heap(Pairing_Heap *h, const int64_t *keys, size_t count);
+
+bool get_min_pairing_heap(const Pairing_Heap *h, int64_t *key_out, void **payload_out);
+
+bool extract_min_pairing_heap(Pairing_Heap *h, int64_t *key_out, void **payload_out);
+
+// Removes up to k minimum elements, writing their keys in ascending order to keys_out[0..].
+// Payloads go to payloads_out if it is not NULL and are otherwise passed to
+// h->free_payload (if set). Returns how many elements were removed.
+size_t extract_min_many_pairing_heap(Pairing_Heap *h, int64_t *keys_out, void **payloads_out, size_t k);
+
+// Returns false if new_key is greater than the node's current key.
+bool decrease_key_pairing_heap(Pairing_Heap *h, Pairing_Node *node, int64_t new_key);
+
+// Moves the node to new_key in either direction; the node stays the same.
+void change_key_pairing_heap(Pairing_Heap *h, Pairing_Node *node, int64_t new_key);
+
+bool delete_node_pairing_heap(Pairing_Heap *h, Pairing_Node *node, int64_t *key_out, void **payload_out);
+
+// Returns a node holding 'key', or NULL. Walks every tree without extra memory.
+Pairing_Node *find_node_pairing_heap_key(const Pairing_Heap *h, int64_t key);
+
+// Moves every element of 'src' into 'dst' in O(1) and leaves 'src' empty; nodes stay valid.
+// Returns false on dst == src.
+bool meld_pairing_heap(Pairing_Heap *dst, Pairing_Heap *src);
+
+void destroy_pairing_heap(Pairing_Heap *h);
+
+#endif // PAIRING_HEAP_H
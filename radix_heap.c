@@ -0,0 +1,361 @@
+#include <stdlib.h>
+#include "radix_heap.h"
+
+// Forward declarations for helper functions
+static unsigned bucket_of_radix_key(uint64_t last, uint64_t key);
+static unsigned first_occupied_radix_bucket(const Radix_Heap *h);
+static void link_radix_node(Radix_Heap *h, Radix_Heap_Node *node);
+static void unlink_radix_node(Radix_Heap *h, Radix_Heap_Node *node);
+static Radix_Heap_Node *min_of_radix_bucket(const Radix_Heap *h, unsigned bucket);
+static void redistribute_radix_heap(Radix_Heap *h);
+
+// Function to create an empty radix heap
+Radix_Heap *create_radix_heap(unsigned key_bits) {
+    if (key_bits != 32 && key_bits != 64) {
+        return NULL;
+    }
+    Radix_Heap *h = (Radix_Heap *)malloc(sizeof(Radix_Heap));
+    if (h == NULL) {
+        return NULL; // Memory allocation failed
+    }
+    for (unsigned i = 0; i < RADIX_HEAP_BUCKETS; i++) {
+        h->buckets[i] = NULL;
+    }
+    h->occupied[0] = h->occupied[1] = 0;
+    h->last = 0;
+    h->key_bits = key_bits;
+    h->max_key = key_bits == 32 ? UINT32_MAX : UINT64_MAX;
+    h->n = 0;
+    h->min = NULL;
+    h->free_payload = NULL;
+    init_heap_pool(&h->nodes, sizeof(Radix_Heap_Node));
+    return h;
+}
+
+// Helper function: 0 for key == last, else one more than the highest bit in which they differ
+static unsigned bucket_of_radix_key(uint64_t last, uint64_t key) {
+    uint64_t diff = key ^ last;
+    if (diff == 0) {
+        return 0;
+    }
+#if defined(__GNUC__) || defined(__clang__)
+    return 64 - (unsigned)__builtin_clzll(diff);
+#else
+    unsigned bucket = 0;
+    while (diff != 0) {
+        diff >>= 1;
+        bucket++;
+    }
+    return bucket;
+#endif
+}
+
+// Helper function to find the lowest non-empty bucket; the heap must not be empty
+static unsigned first_occupied_radix_bucket(const Radix_Heap *h) {
+    unsigned word = h->occupied[0] != 0 ? 0 : 1;
+    uint64_t bits = h->occupied[word];
+#if defined(__GNUC__) || defined(__clang__)
+    return word * 64 + (unsigned)__builtin_ctzll(bits);
+#else
+    unsigned bit = 0;
+    while ((bits & 1) == 0) {
+        bits >>= 1;
+        bit++;
+    }
+    return word * 64 + bit;
+#endif
+}
+
+// Helper function to push a node onto the front of the bucket its key belongs in
+static void link_radix_node(Radix_Heap *h, Radix_Heap_Node *node) {
+    unsigned bucket = bucket_of_radix_key(h->last, node->key);
+    node->bucket = bucket;
+    node->prev = NULL;
+    node->next = h->buckets[bucket];
+    if (node->next != NULL) {
+        node->next->prev = node;
+    }
+    h->buckets[bucket] = node;
+    h->occupied[bucket / 64] |= (uint64_t)1 << (bucket % 64);
+}
+
+// Helper function to take a node out of its bucket list
+static void unlink_radix_node(Radix_Heap *h, Radix_Heap_Node *node) {
+    if (node->prev != NULL) {
+        node->prev->next = node->next;
+    } else {
+        h->buckets[node->bucket] = node->next;
+        if (node->next == NULL) {
+            h->occupied[node->bucket / 64] &= ~((uint64_t)1 << (node->bucket % 64));
+        }
+    }
+    if (node->next != NULL) {
+        node->next->prev = node->prev;
+    }
+}
+
+// Helper function to find the smallest key in one (non-empty) bucket
+static Radix_Heap_Node *min_of_radix_bucket(const Radix_Heap *h, unsigned bucket) {
+    Radix_Heap_Node *min = h->buckets[bucket];
+    if (bucket == 0) {
+        return min; // Every key in bucket 0 equals last
+    }
+    for (Radix_Heap_Node *node = min->next; node != NULL; node = node->next) {
+        if (node->key < min->key) {
+            min = node;
+        }
+    }
+    return min;
+}
+
+// Helper function to refill an empty bucket 0 from the lowest non-empty bucket
+static void redistribute_radix_heap(Radix_Heap *h) {
+    unsigned bucket = first_occupied_radix_bucket(h);
+    if (bucket == 0) {
+        return;
+    }
+
+    // a. Its minimum becomes the new last, so it lands in bucket 0
+    if (h->min == NULL) {
+        h->min = min_of_radix_bucket(h, bucket);
+    }
+    h->last = h->min->key;
+
+    // b. Every other key shares the bits above 'bucket' with last, so it moves strictly lower
+    Radix_Heap_Node *node = h->buckets[bucket];
+    h->buckets[bucket] = NULL;
+    h->occupied[bucket / 64] &= ~((uint64_t)1 << (bucket % 64));
+    while (node != NULL) {
+        Radix_Heap_Node *next = node->next;
+        link_radix_node(h, node);
+        node = next;
+    }
+}
+
+bool accepts_key_radix_heap(const Radix_Heap *h, uint64_t key) {
+    return h != NULL && key >= h->last && key <= h->max_key;
+}
+
+// Function to insert a key into the radix heap
+Radix_Heap_Node *insert_radix_heap(Radix_Heap *h, uint64_t key, void *payload) {
+    if (!accepts_key_radix_heap(h, key)) {
+        return NULL;
+    }
+    Radix_Heap_Node *node = (Radix_Heap_Node *)alloc_heap_pool(&h->nodes);
+    if (node == NULL) {
+        return NULL; // Memory allocation failed
+    }
+    node->key = key;
+    node->payload = payload;
+    link_radix_node(h, node);
+    if (h->n == 0 || (h->min != NULL && key < h->min->key)) {
+        h->min = node;
+    }
+    h->n++;
+    return node;
+}
+
+// Function to insert many keys at once
+bool insert_many_radix_heap(Radix_Heap *h, const uint64_t *keys, size_t count) {
+    if (h == NULL || (keys == NULL && count > 0)) {
+        return false;
+    }
+    for (size_t i = 0; i < count; i++) {
+        if (!accepts_key_radix_heap(h, keys[i])) {
+            return false;
+        }
+    }
+
+    // a. Allocate the whole batch before touching the buckets, so a failure changes nothing
+    Radix_Heap_Node *batch = NULL;
+    for (size_t i = 0; i < count; i++) {
+        Radix_Heap_Node *node = (Radix_Heap_Node *)alloc_heap_pool(&h->nodes);
+        if (node == NULL) {
+            while (batch != NULL) {
+                Radix_Heap_Node *next = batch->next;
+                free_heap_pool(&h->nodes, batch);
+                batch = next;
+            }
+            return false;
+        }
+        node->key = keys[i];
+        node->payload = NULL;
+        node->next = batch;
+        batch = node;
+    }
+
+    // b. File each node; the cached minimum stays correct as long as it was known
+    bool min_known = h->n == 0 || h->min != NULL;
+    while (batch != NULL) {
+        Radix_Heap_Node *next = batch->next;
+        link_radix_node(h, batch);
+        if (min_known && (h->min == NULL || batch->key < h->min->key)) {
+            h->min = batch;
+        }
+        batch = next;
+    }
+    h->n += count;
+    return true;
+}
+
+// Function to get the minimum without removing it
+bool get_min_radix_heap(Radix_Heap *h, uint64_t *key_out, void **payload_out) {
+    if (h == NULL || h->n == 0) {
+        return false;
+    }
+    if (h->min == NULL) {
+        h->min = min_of_radix_bucket(h, first_occupied_radix_bucket(h));
+    }
+    if (key_out != NULL) {
+        *key_out = h->min->key;
+    }
+    if (payload_out != NULL) {
+        *payload_out = h->min->payload;
+    }
+    return true;
+}
+
+// Function to extract the minimum
+bool extract_min_radix_heap(Radix_Heap *h, uint64_t *key_out, void **payload_out) {
+    if (h == NULL || h->n == 0) {
+        return false;
+    }
+    if (h->buckets[0] == NULL) {
+        redistribute_radix_heap(h);
+    }
+    // Any node of bucket 0 will do: they all hold 'last'
+    Radix_Heap_Node *node = h->buckets[0];
+    return delete_node_radix_heap(h, node, key_out, payload_out);
+}
+
+// Function to extract up to k minimum keys at once
+size_t extract_min_many_radix_heap(Radix_Heap *h, uint64_t *keys_out, void **payloads_out, size_t k) {
+    if (h == NULL || keys_out == NULL) {
+        return 0;
+    }
+    size_t extracted = 0;
+    while (extracted < k && h->n > 0) {
+        void *payload;
+        extract_min_radix_heap(h, &keys_out[extracted], &payload);
+        if (payloads_out != NULL) {
+            payloads_out[extracted] = payload;
+        } else if (h->free_payload != NULL && payload != NULL) {
+            h->free_payload(payload);
+        }
+        extracted++;
+    }
+    return extracted;
+}
+
+// Function to decrease the key of a node
+bool decrease_key_radix_heap(Radix_Heap *h, Radix_Heap_Node *node, uint64_t new_key) {
+    if (h == NULL || node == NULL || new_key > node->key) {
+        return false;
+    }
+    return change_key_radix_heap(h, node, new_key);
+}
+
+// Function to change the key of a node in either direction
+bool change_key_radix_heap(Radix_Heap *h, Radix_Heap_Node *node, uint64_t new_key) {
+    if (node == NULL || !accepts_key_radix_heap(h, new_key)) {
+        return false;
+    }
+    uint64_t old_key = node->key;
+    unlink_radix_node(h, node);
+    node->key = new_key;
+    link_radix_node(h, node);
+    if (h->min == node && new_key > old_key) {
+        h->min = NULL; // Some other node may be smaller now
+    } else if (h->min != NULL && new_key < h->min->key) {
+        h->min = node;
+    }
+    return true;
+}
+
+// Function to delete a specific node
+bool delete_node_radix_heap(Radix_Heap *h, Radix_Heap_Node *node, uint64_t *key_out, void **payload_out) {
+    if (h == NULL || node == NULL) {
+        return false;
+    }
+    if (key_out != NULL) {
+        *key_out = node->key;
+    }
+    if (payload_out != NULL) {
+        *payload_out = node->payload;
+    }
+    unlink_radix_node(h, node);
+    if (h->min == node) {
+        h->min = h->buckets[0]; // Another copy of the same key if there is one, else unknown
+    }
+    free_heap_pool(&h->nodes, node);
+    h->n--;
+    return true;
+}
+
+// Function to find a node by its key
+Radix_Heap_Node *find_node_radix_heap_key(const Radix_Heap *h, uint64_t key) {
+    if (h == NULL || key < h->last) {
+        return NULL;
+    }
+    for (Radix_Heap_Node *node = h->buckets[bucket_of_radix_key(h->last, key)]; node != NULL; node = node->next) {
+        if (node->key == key) {
+            return node;
+        }
+    }
+    return NULL;
+}
+
+bool can_meld_radix_heap(Radix_Heap *dst, Radix_Heap *src) {
+    if (dst == NULL || src == NULL || dst == src || dst->key_bits != src->key_bits) {
+        return false;
+    }
+    uint64_t src_min;
+    return !get_min_radix_heap(src, &src_min, NULL) || src_min >= dst->last;
+}
+
+// Function to meld two radix heaps
+bool meld_radix_heap(Radix_Heap *dst, Radix_Heap *src) {
+    if (!can_meld_radix_heap(dst, src)) {
+        return false;
+    }
+
+    // a. Buckets depend on 'last', so src's nodes are filed again relative to dst's
+    for (unsigned i = 0; i < RADIX_HEAP_BUCKETS; i++) {
+        Radix_Heap_Node *node = src->buckets[i];
+        while (node != NULL) {
+            Radix_Heap_Node *next = node->next;
+            link_radix_node(dst, node);
+            node = next;
+        }
+        src->buckets[i] = NULL;
+    }
+    // can_meld_radix_heap looked up src's minimum, so it is known whenever src is not empty
+    if (dst->n == 0 || (dst->min != NULL && src->n > 0 && src->min->key < dst->min->key)) {
+        dst->min = src->min;
+    }
+    dst->n += src->n;
+
+    // b. The nodes' memory now belongs to dst
+    splice_heap_pool(&dst->nodes, &src->nodes);
+    src->occupied[0] = src->occupied[1] = 0;
+    src->n = 0;
+    src->min = NULL;
+    return true;
+}
+
+void destroy_radix_heap(Radix_Heap *h) {
+    if (h == NULL) {
+        return;
+    }
+    if (h->free_payload != NULL) {
+        for (unsigned i = 0; i < RADIX_HEAP_BUCKETS; i++) {
+            for (Radix_Heap_Node *node = h->buckets[i]; node != NULL; node = node->next) {
+                if (node->payload != NULL) {
+                    h->free_payload(node->payload);
+                }
+            }
+        }
+    }
+    destroy_heap_pool(&h->nodes);
+    free(h);
+}
@@ -0,0 +1,95 @@
+#ifndef RADIX_HEAP_H
+#define RADIX_HEAP_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "heap_pool.h"
+
+// Monotone radix heap for unsigned integer keys. It only accepts keys no smaller than the
+// last extracted minimum ('last'), which is the pattern of Dijkstra-style shortest paths
+// and event simulations. In exchange every operation is O(1) except extract_min, which is
+// O(log C) amortized for keys spanning a range of C: an element only ever moves to
+// buckets with a smaller index.
+//
+// Bucket 0 holds keys equal to 'last'; bucket i > 0 holds keys whose highest bit that
+// differs from 'last' is bit i-1. When bucket 0 runs empty, extract_min takes the lowest
+// non-empty bucket, makes its minimum the new 'last' and spreads its elements over the
+// lower buckets. A bitmap of non-empty buckets finds that bucket with one bit scan.
+//
+// Elements sit in intrusive doubly-linked bucket lists. Nodes come from a pool and never
+// move, so they serve as handles for decrease_key and delete.
+
+#define RADIX_HEAP_BUCKETS 65
+
+typedef struct Radix_Heap_Node {
+    uint64_t key;
+    void *payload;                 // Optional opaque data attached by the caller
+    struct Radix_Heap_Node *prev;  // Neighbours in the node's bucket list
+    struct Radix_Heap_Node *next;
+    unsigned bucket;
+} Radix_Heap_Node;
+
+typedef struct Radix_Heap {
+    Radix_Heap_Node *buckets[RADIX_HEAP_BUCKETS];
+    uint64_t occupied[2];  // Bit i set while buckets[i] is not empty
+    uint64_t last;         // Last extracted minimum; no key below it is accepted
+    uint64_t max_key;      // Largest key the heap accepts (UINT32_MAX or UINT64_MAX)
+    unsigned key_bits;     // 32 or 64
+    size_t n;
+    Radix_Heap_Node *min;  // Cached minimum, or NULL when it is not known
+    Heap_Pool nodes;
+    // Called on payloads the heap drops on its own (extract_min_many_radix_heap and
+    // destroy_radix_heap). NULL by default: payloads are left alone.
+    void (*free_payload)(void *payload);
+} Radix_Heap;
+
+// Creates an empty heap for keys of 'key_bits' bits (32 or 64). Returns NULL if key_bits
+// is neither or allocation failed.
+Radix_Heap *create_radix_heap(unsigned key_bits);
+
+// Returns true if 'key' may enter the heap now: last <= key <= max_key. Every operation
+// that stores a key (insert, insert_many, decrease_key, change_key) fails on other keys.
+bool accepts_key_radix_heap(const Radix_Heap *h, uint64_t key);
+
+// Inserts 'key' with an optional 'payload'. Returns the new node, or NULL if the key is
+// not accepted or allocation failed.
+Radix_Heap_Node *insert_radix_heap(Radix_Heap *h, uint64_t key, void *payload);
+
+// Inserts 'count' keys (with NULL payloads). All or nothing: returns false if any key is
+// not accepted or allocation failed.
+bool insert_many_radix_heap(Radix_Heap *h, const uint64_t *keys, size_t count);
+
+// Finding the minimum may scan one bucket; the result is cached until it is removed.
+bool get_min_radix_heap(Radix_Heap *h, uint64_t *key_out, void **payload_out);
+
+// Removes the minimum and raises 'last' to its key.
+bool extract_min_radix_heap(Radix_Heap *h, uint64_t *key_out, void **payload_out);
+
+// Removes up to k minimum elements, writing their keys in ascending order to keys_out[0..].
+// Payloads go to payloads_out if it is not NULL and are otherwise passed to
+// h->free_payload (if set). Returns how many elements were removed.
+size_t extract_min_many_radix_heap(Radix_Heap *h, uint64_t *keys_out, void **payloads_out, size_t k);
+
+// Returns false if new_key is greater than the node's key or not accepted.
+bool decrease_key_radix_heap(Radix_Heap *h, Radix_Heap_Node *node, uint64_t new_key);
+
+// Moves the node to new_key in either direction. Returns false if new_key is not accepted.
+bool change_key_radix_heap(Radix_Heap *h, Radix_Heap_Node *node, uint64_t new_key);
+
+bool delete_node_radix_heap(Radix_Heap *h, Radix_Heap_Node *node, uint64_t *key_out, void **payload_out);
+
+// Returns a node holding 'key', or NULL. Only the one bucket 'key' would be in is searched.
+Radix_Heap_Node *find_node_radix_heap_key(const Radix_Heap *h, uint64_t key);
+
+// Returns true if meld_radix_heap(dst, src) would succeed: same key width, dst != src and
+// no key of src below dst->last.
+bool can_meld_radix_heap(Radix_Heap *dst, Radix_Heap *src);
+
+// Moves every element of 'src' into 'dst' in O(src->n) and leaves 'src' empty; nodes stay
+// valid. Returns false (changing nothing) if can_meld_radix_heap does.
+bool meld_radix_heap(Radix_Heap *dst, Radix_Heap *src);
+
+void destroy_radix_heap(Radix_Heap *h);
+
+#endif // RADIX_HEAP_H
@@ -4,7 +4,17 @@ fibheap_module = Extension(
     'fibheap',  # Name of the module as it will be imported in Python (e.g., import fibheap)
     sources=[
         'fibheap_wrapper.c',
-        'fibonacci_heap.c'
+        'fibonacci_heap.c',
+        'fibonacci_index.c',
+        'heap_pool.c',
+        'dary_heap.c',
+        'pairing_heap.c',
+        'radix_heap.c',
+        'bucket_queue.c',
+        'multi_queue.c',
+        'fibonacci_parallel.c',
+        'fibonacci_graph.c',
+        'heap_select.c'
     ],
     # include_dirs=[], # Add any include directories if necessary (e.g., if fibonacci_heap.h was in a subfolder)
     # library_dirs=[],   # Add library directories if necessary
@@ -16,6 +26,7 @@ setup(
     version='0.1.0',
     description='A Python C extension for a Fibonacci Heap.',
     ext_modules=[fibheap_module],
+    python_requires='>=3.11', # PyType_GetModuleByDef
     author='AI Assistant', # Replace with actual author if desired
     # author_email='',
     # long_description='''...''' # Optional long description
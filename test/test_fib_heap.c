@@ -1,7 +1,18 @@
 #include <check.h>
+#include <pthread.h>
 #include <stdlib.h>
 #include <stdio.h>
+#include <string.h>
 #include "../fibonacci_heap.h" // Already included
+#include "../fibonacci_compact.h"
+#include "../dary_heap.h"
+#include "../pairing_heap.h"
+#include "../radix_heap.h"
+#include "../bucket_queue.h"
+#include "../multi_queue.h"
+#include "../fibonacci_parallel.h"
+#include "../fibonacci_graph.h"
+#include "../heap_select.h"
 
 // Helper to create an int pointer
 static int* create_int_ptr(int value) {
@@ -270,13 +281,13 @@ START_TEST(test_decrease_key)
     int *key_ptr2 = create_int_ptr(20);
     insert_fib_heap(heap, key_ptr2); // Heap: 10(min), 20
     ck_assert_int_eq(heap->n, 2);
-    ck_assert_ptr_eq(heap->min->key, key_ptr); // Min is 10
+    ck_assert_ptr_eq(heap->min->payload, key_ptr); // Min is 10
 
     node_to_decrease = heap->min; // Node with key 10
     new_key_ptr = create_int_ptr(5);
     result = decrease_key_fib_heap(heap, node_to_decrease, new_key_ptr);
     ck_assert(result);
-    ck_assert_int_eq(*(int*)heap->min->key, 5);
+    ck_assert_int_eq(*(int*)heap->min->payload, 5);
     ck_assert_ptr_eq(heap->min, node_to_decrease); // Node itself should be the same
     ck_assert_int_eq(heap->n, 2);
     // free(new_key_ptr); // new_key_ptr is now owned by the node
@@ -292,23 +303,23 @@ START_TEST(test_decrease_key)
     // We should free the orphaned key_ptr here.
     free(key_ptr); 
     // Clean up remaining keys for next scenario
-    free(heap->min->key); // this is new_key_ptr (5)
+    free(heap->min->payload); // this is new_key_ptr (5)
     Fibonacci_Node* temp_node_for_free = heap->root_list; // find the other node
     if (temp_node_for_free == heap->min) temp_node_for_free = temp_node_for_free->right;
-    if (temp_node_for_free != heap->min) free(temp_node_for_free->key); // this is key_ptr2 (20)
+    if (temp_node_for_free != heap->min) free(temp_node_for_free->payload); // this is key_ptr2 (20)
     // free(heap); // commented out per style
 
     // Scenario 2: Attempt to decrease key to a larger value
     heap = create_fib_heap();
     key_ptr = create_int_ptr(10);
     insert_fib_heap(heap, key_ptr);
-    ck_assert_int_eq(*(int*)heap->min->key, 10);
+    ck_assert_int_eq(*(int*)heap->min->payload, 10);
 
     node_to_decrease = heap->min;
     new_key_ptr = create_int_ptr(15);
     result = decrease_key_fib_heap(heap, node_to_decrease, new_key_ptr);
     ck_assert(!result); // Should fail
-    ck_assert_int_eq(*(int*)heap->min->key, 10); // Key should remain 10
+    ck_assert_int_eq(*(int*)heap->min->payload, 10); // Key should remain 10
     ck_assert_int_eq(heap->n, 1);
     free(new_key_ptr); // new_key_ptr was not used by the heap
     free(key_ptr); // key_ptr is still in the heap, free it at end of this test block
@@ -329,7 +340,7 @@ START_TEST(test_decrease_key)
     result = decrease_key_fib_heap(heap, node_to_decrease, NULL);
     ck_assert(!result);
     free(key_ptr); // Not used by heap in these calls
-    free(heap->min->key); // Free the 100
+    free(heap->min->payload); // Free the 100
     // free(heap);
 
 
@@ -341,7 +352,7 @@ START_TEST(test_decrease_key)
     int *k10 = create_int_ptr(10); insert_fib_heap(heap, k10); // N10
     int *k20 = create_int_ptr(20); insert_fib_heap(heap, k20); // N20
     int *k5 = create_int_ptr(5);   insert_fib_heap(heap, k5);  // N5
-    ck_assert_int_eq(*(int*)heap->min->key, 5);
+    ck_assert_int_eq(*(int*)heap->min->payload, 5);
     ck_assert_int_eq(heap->n, 3);
 
     void* extracted_val = extract_min_fib_heap(heap); // Extract 5 (k5)
@@ -353,14 +364,14 @@ START_TEST(test_decrease_key)
     // Expected: 10 is min, 20 is child of 10. (Or vice-versa if keys are same and degrees differ)
     // Let's check current min. It should be 10.
     ck_assert_ptr_nonnull(heap->min);
-    ck_assert_int_eq(*(int*)heap->min->key, 10); // N10 is min
+    ck_assert_int_eq(*(int*)heap->min->payload, 10); // N10 is min
     
     // Check if N10 has a child. This child should be N20.
     Fibonacci_Node *parent_node = heap->min; // This is N10
     ck_assert_ptr_nonnull(parent_node->child); // N10 should have a child
     Fibonacci_Node *child_node_to_decrease = parent_node->child; // This should be N20
     ck_assert_ptr_nonnull(child_node_to_decrease);
-    ck_assert_int_eq(*(int*)child_node_to_decrease->key, 20); // Verify it's N20
+    ck_assert_int_eq(*(int*)child_node_to_decrease->payload, 20); // Verify it's N20
     ck_assert_ptr_eq(child_node_to_decrease->parent, parent_node); // Verify parent pointer
     ck_assert_int_eq(parent_node->degree, 1); // N10 should have degree 1
 
@@ -372,7 +383,7 @@ START_TEST(test_decrease_key)
 
     // child_node_to_decrease (now with key 2) should be the new minimum and a root.
     ck_assert_ptr_nonnull(heap->min);
-    ck_assert_int_eq(*(int*)heap->min->key, 2);
+    ck_assert_int_eq(*(int*)heap->min->payload, 2);
     ck_assert_ptr_eq(heap->min, child_node_to_decrease); // The decreased node is min
     ck_assert_ptr_null(child_node_to_decrease->parent); // It's a root now
     ck_assert_int_eq(child_node_to_decrease->marked, false); // Cut makes it unmarked
@@ -386,19 +397,19 @@ START_TEST(test_decrease_key)
     // k2 is now in child_node_to_decrease (which is heap->min)
     // k10 is in parent_node (which is some other root node)
     // Clean up:
-    free(heap->min->key); // This is k2
+    free(heap->min->payload); // This is k2
     // Find the other node (original parent_node, N10) and free its key
     Fibonacci_Node* other_node = heap->root_list;
     if (other_node == heap->min) other_node = other_node->right;
     // It's possible after cut and fh->min update, that heap->min is the only node if list was small
     if (other_node != heap->min && other_node != NULL) { // Check other_node is not same as min and not null
-         ck_assert_int_eq(*(int*)other_node->key, 10); // Should be N10
-         free(other_node->key); // This is k10
+         ck_assert_int_eq(*(int*)other_node->payload, 10); // Should be N10
+         free(other_node->payload); // This is k10
     } else if (parent_node != heap->min) { // If parent_node itself is not the new min (which it shouldn't be)
         // This case if heap->root_list traversal didn't find it simply.
         // This means parent_node is the other node.
-         ck_assert_int_eq(*(int*)parent_node->key, 10);
-         free(parent_node->key);
+         ck_assert_int_eq(*(int*)parent_node->payload, 10);
+         free(parent_node->payload);
     }
     // free(heap);
 
@@ -430,13 +441,13 @@ START_TEST(test_delete_node)
     // However, delete_node_fib_heap doesn't validate if node is in fh.
     // The more direct test is with NULL node.
     Fibonacci_Node dummy_node; 
-    dummy_node.key = create_int_ptr(1000); // give it some key
+    dummy_node.payload = create_int_ptr(1000); // give it some key
 
     result = delete_node_fib_heap(NULL, &dummy_node);
     ck_assert(!result);
     result = delete_node_fib_heap(heap, NULL);
     ck_assert(!result);
-    free(dummy_node.key);
+    free(dummy_node.payload);
     // free(heap); // Per style
 
     // Scenario 2: Delete the only node in a heap
@@ -470,7 +481,7 @@ START_TEST(test_delete_node)
     ck_assert_int_eq(*(int*)get_min(heap), 5);
     
     node_to_delete = heap->min; // Node with key 5
-    original_key_ptr = node_to_delete->key; // Save pointer to k5
+    original_key_ptr = node_to_delete->payload; // Save pointer to k5
     
     result = delete_node_fib_heap(heap, node_to_delete);
     ck_assert(result);
@@ -489,7 +500,7 @@ START_TEST(test_delete_node)
     k10 = create_int_ptr(10); insert_fib_heap(heap, k10); // Root
     k20 = create_int_ptr(20); insert_fib_heap(heap, k20); // Root
     ck_assert_int_eq(heap->n, 3);
-    ck_assert_int_eq(*(int*)heap->min->key, 5);
+    ck_assert_int_eq(*(int*)heap->min->payload, 5);
 
     // Try to find N10. It could be fh->min->right or fh->min->left,
     // as long as it's not fh->min itself.
@@ -512,7 +523,7 @@ START_TEST(test_delete_node)
     ck_assert_ptr_ne(node_to_delete, heap->min); // Ensure it's not the min node
     ck_assert_ptr_null(node_to_delete->parent); // Ensure it's a root
 
-    original_key_ptr = node_to_delete->key; // Save its key (e.g. 10 or 20)
+    original_key_ptr = node_to_delete->payload; // Save its key (e.g. 10 or 20)
     int original_key_value = *(int*)original_key_ptr;
 
     result = delete_node_fib_heap(heap, node_to_delete);
@@ -521,13 +532,15 @@ START_TEST(test_delete_node)
     ck_assert_ptr_nonnull(get_min(heap));
     ck_assert_int_eq(*(int*)get_min(heap), 5); // Min should still be 5
     
-    // Verify the other non-min node is still present
+    // Verify the other non-min node is still present.
+    // The delete consolidates the heap, so it may now be a child of the min root.
     bool other_node_found = false;
     int expected_other_key = (original_key_value == 10) ? 20 : 10;
     Fibonacci_Node *current = heap->root_list;
     if (current != NULL) {
         do {
-            if (*(int*)current->key == expected_other_key) {
+            if (*(int*)current->payload == expected_other_key ||
+                (current->child != NULL && *(int*)current->child->payload == expected_other_key)) {
                 other_node_found = true;
                 break;
             }
@@ -547,7 +560,7 @@ START_TEST(test_delete_node)
     k10 = create_int_ptr(10); insert_fib_heap(heap, k10);
     k20 = create_int_ptr(20); insert_fib_heap(heap, k20);
     k5 = create_int_ptr(5);   insert_fib_heap(heap, k5);
-    ck_assert_int_eq(*(int*)heap->min->key, 5);
+    ck_assert_int_eq(*(int*)heap->min->payload, 5);
     
     void* extracted_val = extract_min_fib_heap(heap); // Extract 5 (k5)
     free(extracted_val); // k5 is freed by test
@@ -555,13 +568,13 @@ START_TEST(test_delete_node)
     // Consolidation should make one child of other. Assume 10 is min, 20 is child.
     Fibonacci_Node *parent_node_s5 = heap->min; // Should be N10
     ck_assert_ptr_nonnull(parent_node_s5);
-    ck_assert_int_eq(*(int*)parent_node_s5->key, 10);
+    ck_assert_int_eq(*(int*)parent_node_s5->payload, 10);
     ck_assert_ptr_nonnull(parent_node_s5->child); // N10 should have a child
     Fibonacci_Node *child_to_delete = parent_node_s5->child; // Should be N20
     ck_assert_ptr_nonnull(child_to_delete);
-    ck_assert_int_eq(*(int*)child_to_delete->key, 20);
+    ck_assert_int_eq(*(int*)child_to_delete->payload, 20);
 
-    original_key_ptr = child_to_delete->key; // This is k20
+    original_key_ptr = child_to_delete->payload; // This is k20
 
     result = delete_node_fib_heap(heap, child_to_delete);
     ck_assert(result);
@@ -578,6 +591,2034 @@ START_TEST(test_delete_node)
 }
 END_TEST
 
+// Test case for the by-value key API
+START_TEST(test_key_api)
+{
+    Fibonacci_Heap *heap = create_fib_heap();
+    ck_assert_ptr_nonnull(heap);
+    Fibonacci_Key key;
+    void *payload;
+    int tag_a = 0, tag_b = 0;
+
+    // Keys wider than int are stored as-is
+    Fibonacci_Node *big = insert_fib_heap_key(heap, (Fibonacci_Key)1 << 40, &tag_a);
+    ck_assert_ptr_nonnull(big);
+    ck_assert_ptr_nonnull(insert_fib_heap_key(heap, -7, &tag_b));
+    ck_assert_ptr_nonnull(insert_fib_heap_key(heap, 3, NULL));
+    ck_assert_int_eq(heap->n, 3);
+
+    ck_assert(get_min_fib_heap_key(heap, &key, &payload));
+    ck_assert(key == -7);
+    ck_assert_ptr_eq(payload, &tag_b);
+
+    // Deleting by node hands back the original key and payload
+    ck_assert(delete_node_fib_heap_key(heap, big, &key, &payload));
+    ck_assert(key == (Fibonacci_Key)1 << 40);
+    ck_assert_ptr_eq(payload, &tag_a);
+    ck_assert_int_eq(heap->n, 2);
+
+    // Value-based update keeps the payload and the node itself
+    Fibonacci_Node *moved = heap->min;
+    ck_assert(change_fib_node_key(heap, -7, 10));
+    ck_assert(moved->key == 10);
+    ck_assert_ptr_eq(moved->payload, &tag_b);
+    ck_assert(!change_fib_node_key(heap, -7, 10));
+    ck_assert(get_min_fib_heap_key(heap, &key, NULL));
+    ck_assert(key == 3);
+
+    ck_assert(!delete_fib_node_key(heap, 42, NULL));
+    ck_assert(delete_fib_node_key(heap, 3, &payload));
+    ck_assert_ptr_null(payload);
+
+    ck_assert(extract_min_fib_heap_key(heap, &key, &payload));
+    ck_assert(key == 10);
+    ck_assert_ptr_eq(payload, &tag_b);
+    ck_assert(!extract_min_fib_heap_key(heap, &key, &payload));
+    ck_assert_int_eq(heap->n, 0);
+
+    destroy_fib_heap(heap);
+}
+END_TEST
+
+static int freed_payloads;
+
+static void count_free_payload(void *payload)
+{
+    freed_payloads++;
+    free(payload);
+}
+
+// Test case for the payload destructor hook
+START_TEST(test_free_payload)
+{
+    Fibonacci_Heap *heap = create_fib_heap();
+    ck_assert_ptr_nonnull(heap);
+    heap->free_payload = count_free_payload;
+    freed_payloads = 0;
+
+    for (int i = 0; i < 5; i++) {
+        ck_assert(insert_fib_heap(heap, create_int_ptr(i)));
+    }
+    int five = 5, four = 4, three = 3;
+    ck_assert(!delete_fib_node(heap, &five));
+    ck_assert(delete_fib_node(heap, &three));
+    ck_assert_int_eq(freed_payloads, 1);
+
+    // The replaced box is dropped, the new one is adopted
+    int *adopted = create_int_ptr(-1);
+    ck_assert(change_fib_node_value(heap, &four, adopted));
+    ck_assert_int_eq(freed_payloads, 2);
+    ck_assert_ptr_eq(get_min(heap), adopted);
+
+    destroy_fib_heap(heap);
+    ck_assert_int_eq(freed_payloads, 6);
+}
+END_TEST
+
+// Test case for node recycling through the pool
+START_TEST(test_node_pool)
+{
+    Fibonacci_Heap *heap = create_fib_heap();
+    ck_assert_ptr_nonnull(heap);
+
+    // Nodes come from one chunk until it is full
+    Fibonacci_Node *first = insert_fib_heap_key(heap, 1, NULL);
+    Fibonacci_Node *second = insert_fib_heap_key(heap, 2, NULL);
+    ck_assert_ptr_nonnull(first);
+    ck_assert_ptr_eq(second, first + 1);
+    ck_assert_ptr_null(heap->pool.chunks->next);
+
+    // An extracted node is handed out again by the next insert
+    ck_assert(extract_min_fib_heap_key(heap, NULL, NULL));
+    ck_assert_ptr_eq(insert_fib_heap_key(heap, 3, NULL), first);
+
+    // Filling past the first chunk adds a bigger one
+    for (int i = 0; i < FIB_POOL_MIN_CHUNK; i++) {
+        ck_assert_ptr_nonnull(insert_fib_heap_key(heap, i, NULL));
+    }
+    ck_assert_ptr_nonnull(heap->pool.chunks->next);
+    ck_assert_uint_eq(heap->pool.chunks->capacity, 2 * FIB_POOL_MIN_CHUNK);
+
+    Fibonacci_Key key, expected = 0;
+    while (extract_min_fib_heap_key(heap, &key, NULL)) {
+        ck_assert(key >= expected);
+        expected = key;
+    }
+    ck_assert_int_eq(heap->n, 0);
+    destroy_fib_heap(heap);
+}
+END_TEST
+
+static int compare_doubles(const void *a, const void *b)
+{
+    double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+// Composite key wider than Fibonacci_Key, stored after the node
+typedef struct {
+    int64_t timestamp;
+    int32_t priority;
+    char tag[12];
+} Event_Key;
+
+static int compare_events(const void *a, const void *b)
+{
+    const Event_Key *x = a, *y = b;
+    if (x->priority != y->priority) {
+        return (x->priority > y->priority) - (x->priority < y->priority);
+    }
+    return (x->timestamp > y->timestamp) - (x->timestamp < y->timestamp);
+}
+
+// Test case for heaps with a custom comparator
+START_TEST(test_custom_compare)
+{
+    ck_assert_ptr_null(create_fib_heap_ex(NULL, sizeof(int)));
+    ck_assert_ptr_null(create_fib_heap_ex(compare_doubles, 0));
+
+    // Doubles fit in the inline key slot
+    Fibonacci_Heap *heap = create_fib_heap_ex(compare_doubles, sizeof(double));
+    ck_assert_ptr_nonnull(heap);
+    double values[] = {2.5, -0.25, 1e300, 0.125};
+    Fibonacci_Node *nodes[4];
+    for (int i = 0; i < 4; i++) {
+        nodes[i] = insert_fib_heap_ex(heap, &values[i], NULL);
+        ck_assert_ptr_nonnull(nodes[i]);
+    }
+    // The Fibonacci_Key API refuses heaps with another key type
+    ck_assert_ptr_null(insert_fib_heap_key(heap, 1, NULL));
+    ck_assert(!extract_min_fib_heap_key(heap, NULL, NULL));
+
+    double lower = -1.5, higher = 3.0, out;
+    ck_assert(!decrease_key_fib_heap_ex(heap, nodes[1], &higher));
+    ck_assert(decrease_key_fib_heap_ex(heap, nodes[2], &lower));
+    ck_assert(get_min_fib_heap_ex(heap, &out, NULL));
+    ck_assert(out == -1.5);
+    ck_assert(delete_node_fib_heap_ex(heap, nodes[0], &out, NULL));
+    ck_assert(out == 2.5);
+
+    double expected[] = {-1.5, -0.25, 0.125};
+    for (int i = 0; i < 3; i++) {
+        ck_assert(extract_min_fib_heap_ex(heap, &out, NULL));
+        ck_assert(out == expected[i]);
+    }
+    ck_assert(!extract_min_fib_heap_ex(heap, &out, NULL));
+    destroy_fib_heap(heap);
+
+    // Composite keys are stored out of line
+    heap = create_fib_heap_ex(compare_events, sizeof(Event_Key));
+    ck_assert_ptr_nonnull(heap);
+    ck_assert_uint_eq(heap->pool.node_size, sizeof(Fibonacci_Node) + sizeof(Event_Key));
+    Event_Key events[] = {
+        {300, 1, "late"}, {100, 2, "low"}, {200, 1, "early"}, {50, 3, "lowest"},
+    };
+    Fibonacci_Node *low = NULL;
+    for (int i = 0; i < 4; i++) {
+        Fibonacci_Node *node = insert_fib_heap_ex(heap, &events[i], &events[i]);
+        ck_assert_ptr_nonnull(node);
+        if (i == 1) low = node;
+    }
+    ck_assert(memcmp(get_key_fib_node(heap, low), &events[1], sizeof(Event_Key)) == 0);
+    Event_Key promoted = {100, 0, "promoted"};
+    ck_assert(decrease_key_fib_heap_ex(heap, low, &promoted));
+
+    const char *order[] = {"promoted", "early", "late", "lowest"};
+    Event_Key event;
+    void *payload;
+    for (int i = 0; i < 4; i++) {
+        ck_assert(extract_min_fib_heap_ex(heap, &event, &payload));
+        ck_assert_int_eq(strcmp(event.tag, order[i]), 0);
+    }
+    ck_assert_ptr_eq(payload, &events[3]);
+    destroy_fib_heap(heap);
+}
+END_TEST
+
+// Test case for deleting a node while other nodes hold the smallest possible key
+START_TEST(test_delete_without_sentinel)
+{
+    Fibonacci_Heap *heap = create_fib_heap();
+    ck_assert_ptr_nonnull(heap);
+    for (int i = 0; i < 10; i++) {
+        insert_fib_heap_key(heap, i, NULL);
+    }
+    ck_assert(extract_min_fib_heap_key(heap, NULL, NULL)); // Removes 0 and builds trees
+    int tag = 0;
+    insert_fib_heap_key(heap, INT64_MIN, &tag);
+    insert_fib_heap_key(heap, INT64_MIN, &tag);
+
+    // Pick a node that is a child, so the delete has to cut it first
+    Fibonacci_Node *root = heap->root_list, *child = NULL;
+    do {
+        if (root->child != NULL) child = root->child;
+        root = root->right;
+    } while (child == NULL && root != heap->root_list);
+    ck_assert_ptr_nonnull(child);
+
+    Fibonacci_Key deleted, key;
+    ck_assert(delete_node_fib_heap_key(heap, child, &deleted, NULL));
+    ck_assert(deleted > 0 && deleted < 10);
+    ck_assert_int_eq(heap->n, 10);
+
+    // Both INT64_MIN keys survive and every other key comes out in order
+    void *payload;
+    for (int i = 0; i < 2; i++) {
+        ck_assert(extract_min_fib_heap_key(heap, &key, &payload));
+        ck_assert(key == INT64_MIN);
+        ck_assert_ptr_eq(payload, &tag);
+    }
+    for (Fibonacci_Key expected = 1; expected < 10; expected++) {
+        if (expected == deleted) continue;
+        ck_assert(extract_min_fib_heap_key(heap, &key, NULL));
+        ck_assert(key == expected);
+    }
+    ck_assert_int_eq(heap->n, 0);
+    destroy_fib_heap(heap);
+}
+END_TEST
+
+START_TEST(test_key_index)
+{
+    Fibonacci_Heap *heap = create_fib_heap();
+    ck_assert_ptr_nonnull(heap);
+    Fibonacci_Node *nodes[100];
+    for (int i = 0; i < 100; i++) {
+        nodes[i] = insert_fib_heap_key(heap, i % 50, NULL); // Every key twice
+    }
+    ck_assert(extract_min_fib_heap_key(heap, NULL, NULL)); // Removes one 0 and builds trees
+
+    // Enabling on a populated heap indexes what is already there
+    ck_assert(enable_index_fib_heap(heap));
+    ck_assert_ptr_nonnull(heap->index);
+    ck_assert_uint_eq(heap->index->count, 99);
+    Fibonacci_Node *found = find_node_fib_heap_key(heap, 7);
+    ck_assert(found == nodes[7] || found == nodes[57]);
+    ck_assert_ptr_null(find_node_fib_heap_key(heap, 50));
+
+    // Duplicates: deleting by value removes one node at a time
+    ck_assert(delete_fib_node_key(heap, 7, NULL));
+    ck_assert_ptr_nonnull(find_node_fib_heap_key(heap, 7));
+    ck_assert(delete_fib_node_key(heap, 7, NULL));
+    ck_assert_ptr_null(find_node_fib_heap_key(heap, 7));
+    ck_assert(!delete_fib_node_key(heap, 7, NULL));
+
+    // Key changes move the index entry with the node
+    ck_assert(decrease_key_fib_heap_key(heap, nodes[20], -5));
+    ck_assert_ptr_eq(find_node_fib_heap_key(heap, -5), nodes[20]);
+    ck_assert(change_fib_node_key(heap, -5, 500));
+    ck_assert_ptr_eq(find_node_fib_heap_key(heap, 500), nodes[20]);
+    ck_assert_ptr_null(find_node_fib_heap_key(heap, -5));
+
+    // New inserts are indexed, extracted nodes are dropped
+    Fibonacci_Node *fresh = insert_fib_heap_key(heap, 1000, NULL);
+    ck_assert_ptr_eq(find_node_fib_heap_key(heap, 1000), fresh);
+    Fibonacci_Key key;
+    ck_assert(extract_min_fib_heap_key(heap, &key, NULL));
+    ck_assert(key == 0);
+    ck_assert_ptr_null(find_node_fib_heap_key(heap, 0));
+    ck_assert_uint_eq(heap->index->count, (size_t)heap->n);
+
+    // Without the index the same lookups fall back to scanning the pool
+    disable_index_fib_heap(heap);
+    ck_assert_ptr_null(heap->index);
+    ck_assert_ptr_eq(find_node_fib_heap_key(heap, 500), nodes[20]);
+    ck_assert_ptr_null(find_node_fib_heap_key(heap, 7));
+    destroy_fib_heap(heap);
+
+    // Heaps with a custom comparator cannot be indexed
+    heap = create_fib_heap_ex(compare_doubles, sizeof(double));
+    ck_assert(!enable_index_fib_heap(heap));
+    destroy_fib_heap(heap);
+}
+END_TEST
+
+START_TEST(test_meld)
+{
+    Fibonacci_Heap *a = create_fib_heap();
+    Fibonacci_Heap *b = create_fib_heap();
+    ck_assert_ptr_nonnull(a);
+    ck_assert_ptr_nonnull(b);
+    Fibonacci_Node *b_nodes[300];
+    for (int i = 0; i < 300; i++) {
+        insert_fib_heap_key(a, 2 * i, NULL);
+        b_nodes[i] = insert_fib_heap_key(b, 2 * i + 1, NULL);
+    }
+    ck_assert(extract_min_fib_heap_key(b, NULL, NULL)); // Removes 1 and leaves a recycled slot
+    ck_assert(enable_index_fib_heap(a));
+
+    ck_assert(!meld_fib_heap(a, a));
+    ck_assert(meld_fib_heap(a, b));
+    ck_assert_int_eq(a->n, 599);
+    ck_assert_int_eq(b->n, 0);
+    ck_assert_ptr_null(b->min);
+    ck_assert_ptr_null(b->pool.chunks);
+
+    // b's nodes now belong to a: the index finds them and handles still work
+    ck_assert_ptr_eq(find_node_fib_heap_key(a, 7), b_nodes[3]);
+    ck_assert(decrease_key_fib_heap_key(a, b_nodes[3], -1));
+    Fibonacci_Key key;
+    ck_assert(get_min_fib_heap_key(a, &key, NULL));
+    ck_assert(key == -1);
+
+    // b stays usable, and melding an empty heap changes nothing
+    insert_fib_heap_key(b, -10, NULL);
+    ck_assert(get_min_fib_heap_key(b, &key, NULL));
+    ck_assert(key == -10);
+    ck_assert(meld_fib_heap(a, b));
+    ck_assert(meld_fib_heap(a, b));
+    ck_assert_int_eq(a->n, 600);
+
+    // Everything comes out in order, reusing the recycled slot b handed over
+    Fibonacci_Key expected[] = {-10, -1, 0, 2, 3};
+    for (int i = 0; i < 5; i++) {
+        ck_assert(extract_min_fib_heap_key(a, &key, NULL));
+        ck_assert(key == expected[i]);
+    }
+    Fibonacci_Key previous = key;
+    while (extract_min_fib_heap_key(a, &key, NULL)) {
+        ck_assert(key > previous);
+        previous = key;
+    }
+    ck_assert(previous == 599);
+    destroy_fib_heap(b);
+    destroy_fib_heap(a);
+
+    // With both heaps indexed, the larger table ends up in dst
+    a = create_fib_heap();
+    b = create_fib_heap();
+    insert_fib_heap_key(a, 1, NULL);
+    for (int i = 2; i < 100; i++) {
+        insert_fib_heap_key(b, i, NULL);
+    }
+    ck_assert(enable_index_fib_heap(a));
+    ck_assert(enable_index_fib_heap(b));
+    ck_assert(meld_fib_heap(a, b));
+    ck_assert_uint_eq(a->index->count, 99);
+    ck_assert_uint_eq(b->index->count, 0);
+    for (Fibonacci_Key k = 1; k < 100; k++) {
+        ck_assert_ptr_nonnull(find_node_fib_heap_key(a, k));
+    }
+    ck_assert_ptr_null(find_node_fib_heap_key(b, 50));
+    destroy_fib_heap(a);
+    destroy_fib_heap(b);
+
+    // Heaps ordered differently cannot be melded
+    a = create_fib_heap();
+    b = create_fib_heap_ex(compare_doubles, sizeof(double));
+    ck_assert(!meld_fib_heap(a, b));
+    destroy_fib_heap(a);
+    destroy_fib_heap(b);
+}
+END_TEST
+
+START_TEST(test_insert_many)
+{
+    Fibonacci_Heap *heap = create_fib_heap();
+    ck_assert_ptr_nonnull(heap);
+    ck_assert(enable_index_fib_heap(heap));
+    insert_fib_heap_key(heap, 500, NULL);
+
+    // A run that fits the newest chunk, then one that needs a chunk of its own
+    Fibonacci_Key small[] = {40, -3, 12};
+    ck_assert(insert_many_fib_heap(heap, small, 3));
+    size_t count = 3 * FIB_POOL_MAX_CHUNK / 2;
+    Fibonacci_Key *keys = malloc(count * sizeof(Fibonacci_Key));
+    ck_assert_ptr_nonnull(keys);
+    for (size_t i = 0; i < count; i++) {
+        keys[i] = (Fibonacci_Key)(count - i) + 1000;
+    }
+    ck_assert(insert_many_fib_heap(heap, keys, count));
+    free(keys);
+    ck_assert(insert_many_fib_heap(heap, NULL, 0));
+    ck_assert_int_eq(heap->n, (int)count + 4);
+    ck_assert_uint_eq(heap->index->count, count + 4);
+
+    // The bulk-loaded nodes behave like any other
+    Fibonacci_Node *node = find_node_fib_heap_key(heap, 1001);
+    ck_assert_ptr_nonnull(node);
+    ck_assert_ptr_null(node->payload);
+    ck_assert(decrease_key_fib_heap_key(heap, node, -10));
+    Fibonacci_Key expected[] = {-10, -3, 12, 40, 500, 1002, 1003};
+    Fibonacci_Key key;
+    for (int i = 0; i < 7; i++) {
+        ck_assert(extract_min_fib_heap_key(heap, &key, NULL));
+        ck_assert(key == expected[i]);
+    }
+    insert_fib_heap_key(heap, 0, NULL); // Still served by the pool after the bulk runs
+    ck_assert(get_min_fib_heap_key(heap, &key, NULL));
+    ck_assert(key == 0);
+    destroy_fib_heap(heap);
+
+    heap = create_fib_heap_ex(compare_doubles, sizeof(double));
+    ck_assert(!insert_many_fib_heap(heap, small, 3));
+    destroy_fib_heap(heap);
+}
+END_TEST
+
+START_TEST(test_extract_min_many)
+{
+    Fibonacci_Heap *heap = create_fib_heap();
+    ck_assert_ptr_nonnull(heap);
+    heap->free_payload = count_free_payload;
+    freed_payloads = 0;
+    int *tags[3];
+    Fibonacci_Key keys[] = {8, 3, 6, 1, 9};
+    ck_assert(insert_many_fib_heap(heap, keys, 5));
+    for (int i = 0; i < 3; i++) {
+        tags[i] = malloc(sizeof(int));
+        insert_fib_heap_key(heap, 2 * i, tags[i]); // 0, 2, 4
+    }
+
+    // With payloads_out, payloads are handed back in key order
+    Fibonacci_Key out[8];
+    void *payloads[8];
+    ck_assert_uint_eq(extract_min_many_fib_heap(heap, out, payloads, 3), 3);
+    ck_assert(out[0] == 0 && out[1] == 1 && out[2] == 2);
+    ck_assert_ptr_eq(payloads[0], tags[0]);
+    ck_assert_ptr_null(payloads[1]);
+    ck_assert_ptr_eq(payloads[2], tags[1]);
+    free(tags[0]);
+    free(tags[1]);
+    ck_assert_int_eq(freed_payloads, 0);
+
+    // Without it they go to free_payload; asking for more than is left stops early
+    ck_assert_uint_eq(extract_min_many_fib_heap(heap, out, NULL, 8), 5);
+    Fibonacci_Key expected[] = {3, 4, 6, 8, 9};
+    for (int i = 0; i < 5; i++) {
+        ck_assert(out[i] == expected[i]);
+    }
+    ck_assert_int_eq(freed_payloads, 1);
+    ck_assert_int_eq(heap->n, 0);
+    ck_assert_uint_eq(extract_min_many_fib_heap(heap, out, NULL, 8), 0);
+    destroy_fib_heap(heap);
+}
+END_TEST
+
+START_TEST(test_degree_table)
+{
+    Fibonacci_Heap *heap = create_fib_heap();
+    ck_assert_ptr_nonnull(heap);
+    ck_assert_ptr_null(heap->degree_table);
+
+    // The table follows n: F(k+2) <= n allows degree k, plus one spare slot
+    insert_fib_heap_key(heap, 0, NULL);
+    ck_assert_int_eq(heap->degree_table_size, 2);
+    ck_assert_int_eq(heap->degree_table_max_n, 1);
+    Fibonacci_Key keys[999];
+    for (int i = 0; i < 999; i++) {
+        keys[i] = (i * 7919) % 1000 + 1;
+    }
+    ck_assert(insert_many_fib_heap(heap, keys, 999));
+    ck_assert_int_eq(heap->degree_table_size, 16);  // F(16) = 987 <= 1000 < F(17) = 1597
+    ck_assert_int_eq(heap->degree_table_max_n, 1596);
+
+    // Mixed extractions and decreases keep every tree within the bound
+    int removed = 0;
+    for (int round = 0; round < 200; round++) {
+        Fibonacci_Key key;
+        ck_assert(extract_min_fib_heap_key(heap, &key, NULL));
+        removed++;
+        Fibonacci_Node *node = find_node_fib_heap_key(heap, 1000 - round);
+        if (node != NULL) {
+            ck_assert(decrease_key_fib_heap_key(heap, node, key));
+        }
+        for (Fibonacci_Node *root = heap->root_list->right;; root = root->right) {
+            ck_assert_int_lt(root->degree, heap->degree_table_size - 1);
+            ck_assert_ptr_null(root->parent);
+            if (root == heap->root_list) break;
+        }
+    }
+    ck_assert_int_eq(heap->n, 1000 - removed);
+    for (int d = 0; d < heap->degree_table_size; d++) {
+        ck_assert_ptr_null(heap->degree_table[d]); // Left clean between calls
+    }
+
+    // Everything left still comes out in order
+    Fibonacci_Key previous = INT64_MIN, key;
+    while (extract_min_fib_heap_key(heap, &key, NULL)) {
+        ck_assert(key >= previous);
+        previous = key;
+    }
+    ck_assert_int_eq(heap->n, 0);
+    destroy_fib_heap(heap);
+}
+END_TEST
+
+// Helper to count the roots of a heap
+static int count_roots(const Fibonacci_Heap *heap) {
+    int roots = 0;
+    Fibonacci_Node *root = heap->root_list;
+    if (root != NULL) {
+        do {
+            roots++;
+            root = root->right;
+        } while (root != heap->root_list);
+    }
+    return roots;
+}
+
+START_TEST(test_consolidate_budget)
+{
+    Fibonacci_Heap *heap = create_fib_heap();
+    ck_assert_ptr_nonnull(heap);
+    ck_assert(!set_consolidate_budget_fib_heap(heap, -1));
+    ck_assert(set_consolidate_budget_fib_heap(heap, 4));
+
+    // A burst of inserts is filed as it arrives: the root list never grows past O(log n)
+    enum { N = 20000 };
+    for (int i = 0; i < N; i++) {
+        ck_assert_ptr_nonnull(insert_fib_heap_key(heap, (i * 7919) % N, NULL));
+        ck_assert_int_le(count_roots(heap), 2 * heap->degree_table_size);
+    }
+    Fibonacci_Key key;
+    ck_assert(get_min_fib_heap_key(heap, &key, NULL));
+    ck_assert(key == 0);
+
+    // Extractions, decreases and bulk inserts keep both the bound and the order
+    Fibonacci_Key more[500];
+    for (int i = 0; i < 500; i++) {
+        more[i] = N + i;
+    }
+    ck_assert(insert_many_fib_heap(heap, more, 500));
+    for (int i = 0; i < 1000; i++) {
+        ck_assert(extract_min_fib_heap_key(heap, &key, NULL));
+        ck_assert(key == i);
+        ck_assert_int_le(count_roots(heap), 2 * heap->degree_table_size);
+        Fibonacci_Node *node = find_node_fib_heap_key(heap, N - 1 - i);
+        ck_assert(decrease_key_fib_heap_key(heap, node, N / 2 + i)); // Stays above the keys still to come
+    }
+
+    // Turning the budget on consolidates a lazy heap once; turning it off empties the table
+    Fibonacci_Heap *lazy = create_fib_heap();
+    ck_assert_ptr_nonnull(lazy);
+    for (int i = 0; i < 1000; i++) {
+        insert_fib_heap_key(lazy, -i, NULL);
+    }
+    ck_assert_int_eq(count_roots(lazy), 1000);
+    ck_assert(set_consolidate_budget_fib_heap(lazy, 1));
+    ck_assert_int_le(count_roots(lazy), lazy->degree_table_size);
+    ck_assert(meld_fib_heap(heap, lazy));
+    ck_assert_int_eq(lazy->n, 0);
+    for (int d = 0; d < lazy->degree_table_size; d++) {
+        ck_assert_ptr_null(lazy->degree_table[d]);
+    }
+    ck_assert(set_consolidate_budget_fib_heap(heap, 0));
+    for (int d = 0; d < heap->degree_table_size; d++) {
+        ck_assert_ptr_null(heap->degree_table[d]);
+    }
+
+    Fibonacci_Key previous = INT64_MIN;
+    int left = heap->n;
+    while (extract_min_fib_heap_key(heap, &key, NULL)) {
+        ck_assert(key >= previous);
+        previous = key;
+        left--;
+    }
+    ck_assert_int_eq(left, 0);
+    destroy_fib_heap(lazy);
+    destroy_fib_heap(heap);
+}
+END_TEST
+
+START_TEST(test_consolidate_budget_matches_lazy_heap)
+{
+    // Drive heaps with different budgets and a lazy heap through the same random operations
+    static const int budgets[] = {1, 3, 16};
+    for (size_t b = 0; b < sizeof(budgets) / sizeof(budgets[0]); b++) {
+        Fibonacci_Heap *reference = create_fib_heap();
+        Fibonacci_Heap *heap = create_fib_heap();
+        ck_assert_ptr_nonnull(reference);
+        ck_assert_ptr_nonnull(heap);
+        ck_assert(set_consolidate_budget_fib_heap(heap, budgets[b]));
+
+        enum { N = 6000 };
+        static Fibonacci_Node *ref_nodes[N];
+        static Fibonacci_Node *nodes[N];
+        static bool live[N];
+        uint64_t state = 88172645463325252ULL + b;
+        int inserted = 0;
+        int64_t serial = 0; // Low bits that keep every key unique, so both heaps extract the same element
+        for (int step = 0; step < 20000; step++) {
+            state ^= state << 13;
+            state ^= state >> 7;
+            state ^= state << 17;
+            int op = (int)(state % 8);
+            int64_t value = ((int64_t)((state >> 20) % 1000) - 500) * 16384 + serial;
+            int pick = inserted > 0 ? (int)((state >> 40) % (uint64_t)inserted) : 0;
+
+            if (op < 3 && inserted < N) {
+                serial++;
+                // The payload records which element this is, so extractions can be tracked
+                void *tag = (void *)(intptr_t)(inserted + 1);
+                ref_nodes[inserted] = insert_fib_heap_key(reference, value, tag);
+                nodes[inserted] = insert_fib_heap_key(heap, value, tag);
+                live[inserted++] = true;
+            } else if (op == 3) {
+                Fibonacci_Key expected, key;
+                void *expected_tag, *tag;
+                bool had = extract_min_fib_heap_key(reference, &expected, &expected_tag);
+                ck_assert(had == extract_min_fib_heap_key(heap, &key, &tag));
+                if (had) {
+                    ck_assert(key == expected);
+                    ck_assert_ptr_eq(tag, expected_tag);
+                    live[(intptr_t)tag - 1] = false;
+                }
+            } else if (op == 4 && inserted > 0 && live[pick]) {
+                Fibonacci_Key lower = nodes[pick]->key - 7 * 16384;
+                ck_assert(decrease_key_fib_heap_key(reference, ref_nodes[pick], lower));
+                ck_assert(decrease_key_fib_heap_key(heap, nodes[pick], lower));
+            } else if (op == 5 && inserted > 0 && live[pick]) {
+                ck_assert(delete_node_fib_heap_key(reference, ref_nodes[pick], NULL, NULL));
+                ck_assert(delete_node_fib_heap_key(heap, nodes[pick], NULL, NULL));
+                live[pick] = false;
+            } else if (op == 6 && inserted + 8 <= N) {
+                // A small meld brings in unfiled roots with children of their own
+                Fibonacci_Heap *ref_side = create_fib_heap(), *side = create_fib_heap();
+                ck_assert(set_consolidate_budget_fib_heap(side, budgets[b]));
+                for (int i = 0; i < 8; i++, serial++) {
+                    void *tag = (void *)(intptr_t)(inserted + 1);
+                    int64_t key = value + (int64_t)i * 16384 * 3 + i;
+                    ref_nodes[inserted] = insert_fib_heap_key(ref_side, key, tag);
+                    nodes[inserted] = insert_fib_heap_key(side, key, tag);
+                    live[inserted++] = true;
+                }
+                ck_assert(meld_fib_heap(reference, ref_side));
+                ck_assert(meld_fib_heap(heap, side));
+                destroy_fib_heap(ref_side);
+                destroy_fib_heap(side);
+            }
+            ck_assert_int_eq(heap->n, reference->n);
+            ck_assert_int_le(count_roots(heap), 2 * heap->degree_table_size + 8);
+            Fibonacci_Key expected, key;
+            if (get_min_fib_heap_key(reference, &expected, NULL)) {
+                ck_assert(get_min_fib_heap_key(heap, &key, NULL));
+                ck_assert(key == expected);
+            }
+        }
+        destroy_fib_heap(reference);
+        destroy_fib_heap(heap);
+    }
+}
+END_TEST
+
+START_TEST(test_insert_buffers)
+{
+    Fibonacci_Heap *heap = create_fib_heap();
+    ck_assert_ptr_nonnull(heap);
+    Fibonacci_Insert_Buffer *a = create_insert_buffer_fib_heap(heap);
+    Fibonacci_Insert_Buffer *b = create_insert_buffer_fib_heap(heap);
+    ck_assert_ptr_nonnull(a);
+    ck_assert_ptr_nonnull(b);
+
+    // Buffered keys are merged before the consumer looks at the heap
+    ck_assert(insert_fib_heap_key(heap, 50, NULL) != NULL);
+    ck_assert(insert_buffered_fib_heap(a, 30, NULL));
+    ck_assert(insert_buffered_fib_heap(b, 70, NULL));
+    ck_assert_int_eq(heap->n, 1);
+    Fibonacci_Key key;
+    ck_assert(get_min_fib_heap_key(heap, &key, NULL));
+    ck_assert(key == 30);
+    ck_assert_int_eq(heap->n, 3);
+    ck_assert(insert_buffered_fib_heap(b, 10, NULL));
+    ck_assert(delete_fib_node_key(heap, 10, NULL)); // Found through the merged part of b's chunk
+    ck_assert(extract_min_fib_heap_key(heap, &key, NULL));
+    ck_assert(key == 30);
+
+    // Enough keys to fill several chunks, with an index and a budget turned on halfway
+    enum { N = 3000 };
+    for (int i = 0; i < N; i++) {
+        ck_assert(insert_buffered_fib_heap(i % 2 ? a : b, (Fibonacci_Key)(N - i) * 10 + 1, NULL));
+        if (i == N / 2) {
+            ck_assert(enable_index_fib_heap(heap));
+            ck_assert(set_consolidate_budget_fib_heap(heap, 4));
+        }
+    }
+    ck_assert_ptr_nonnull(find_node_fib_heap_key(heap, 11));
+    ck_assert_ptr_nonnull(find_node_fib_heap_key(heap, (Fibonacci_Key)N * 10 + 1));
+    ck_assert_int_eq(heap->n, N + 2);
+    Fibonacci_Key previous = INT64_MIN;
+    for (int i = 0; i < N + 2; i++) {
+        ck_assert(extract_min_fib_heap_key(heap, &key, NULL));
+        ck_assert(key >= previous);
+        previous = key;
+    }
+    ck_assert(!extract_min_fib_heap_key(heap, &key, NULL));
+
+    // A heap with buffers cannot be melded away; buffered payloads are freed with the heap
+    Fibonacci_Heap *other = create_fib_heap();
+    ck_assert(!meld_fib_heap(other, heap));
+    ck_assert(meld_fib_heap(heap, other));
+    destroy_fib_heap(other);
+    heap->free_payload = free;
+    ck_assert(insert_buffered_fib_heap(a, 1, create_int_ptr(1)));
+    ck_assert(get_min_fib_heap_key(heap, NULL, NULL));
+    ck_assert(insert_buffered_fib_heap(a, 2, create_int_ptr(2)));
+    destroy_fib_heap(heap);
+
+    Fibonacci_Heap *doubles = create_fib_heap_ex(compare_doubles, sizeof(double));
+    ck_assert_ptr_null(create_insert_buffer_fib_heap(doubles));
+    destroy_fib_heap(doubles);
+}
+END_TEST
+
+typedef struct {
+    Fibonacci_Insert_Buffer *buffer;
+    int64_t first;
+} Insert_Buffer_Producer;
+
+// Inserts 20000 keys from 'first' on through its buffer
+static void *insert_buffer_producer(void *arg) {
+    Insert_Buffer_Producer *p = (Insert_Buffer_Producer *)arg;
+    for (int64_t i = 0; i < 20000; i++) {
+        ck_assert(insert_buffered_fib_heap(p->buffer, p->first + i, NULL));
+    }
+    return NULL;
+}
+
+START_TEST(test_insert_buffers_threads)
+{
+    enum { PRODUCERS = 4 };
+    Fibonacci_Heap *heap = create_fib_heap();
+    ck_assert_ptr_nonnull(heap);
+    pthread_t threads[PRODUCERS];
+    Insert_Buffer_Producer producers[PRODUCERS];
+    for (int t = 0; t < PRODUCERS; t++) {
+        producers[t] = (Insert_Buffer_Producer){create_insert_buffer_fib_heap(heap), (int64_t)t * 20000};
+        ck_assert_ptr_nonnull(producers[t].buffer);
+        ck_assert_int_eq(pthread_create(&threads[t], NULL, insert_buffer_producer, &producers[t]), 0);
+    }
+
+    // The consumer extracts while the producers insert
+    long extracted = 0;
+    int64_t sum = 0;
+    Fibonacci_Key key;
+    for (int i = 0; i < 20000; i++) {
+        if (extract_min_fib_heap_key(heap, &key, NULL)) {
+            extracted++;
+            sum += key;
+        }
+    }
+    for (int t = 0; t < PRODUCERS; t++) {
+        ck_assert_int_eq(pthread_join(threads[t], NULL), 0);
+    }
+
+    // Every insert happened before this point, so the rest comes out whole and in order
+    Fibonacci_Key previous = INT64_MIN;
+    while (extract_min_fib_heap_key(heap, &key, NULL)) {
+        ck_assert(key >= previous);
+        previous = key;
+        extracted++;
+        sum += key;
+    }
+    ck_assert_int_eq(extracted, PRODUCERS * 20000);
+    ck_assert(sum == (int64_t)PRODUCERS * 20000 * (PRODUCERS * 20000 - 1) / 2);
+    destroy_fib_heap(heap);
+}
+END_TEST
+
+static int compare_fib_keys(const void *a, const void *b)
+{
+    Fibonacci_Key x = *(const Fibonacci_Key *)a, y = *(const Fibonacci_Key *)b;
+    return (x > y) - (x < y);
+}
+
+START_TEST(test_build_parallel)
+{
+    ck_assert_ptr_null(build_parallel_fib_heap(NULL, 0, 0));
+    Fibonacci_Heap *empty = build_parallel_fib_heap(NULL, 0, 4);
+    ck_assert_ptr_nonnull(empty);
+    ck_assert_int_eq(empty->n, 0);
+    destroy_fib_heap(empty);
+
+    // Enough keys for several slices, with duplicates; 1 thread, an uneven split and more threads than slices
+    enum { N = 5 * FIB_PARALLEL_MIN_SLICE + 123 };
+    static Fibonacci_Key keys[N], sorted[N], out[N];
+    uint64_t state = 88172645463325252ULL;
+    for (int i = 0; i < N; i++) {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        keys[i] = (Fibonacci_Key)(state % 100000) - 50000;
+    }
+    memcpy(sorted, keys, sizeof(keys));
+    qsort(sorted, N, sizeof(Fibonacci_Key), compare_fib_keys);
+    size_t thread_counts[] = {1, 3, 64};
+    for (size_t t = 0; t < sizeof(thread_counts) / sizeof(thread_counts[0]); t++) {
+        Fibonacci_Heap *heap = build_parallel_fib_heap(keys, N, thread_counts[t]);
+        ck_assert_ptr_nonnull(heap);
+        ck_assert_int_eq(heap->n, N);
+        ck_assert_uint_eq(extract_min_many_fib_heap(heap, out, NULL, N), N);
+        ck_assert_int_eq(memcmp(out, sorted, sizeof(sorted)), 0);
+        destroy_fib_heap(heap);
+    }
+}
+END_TEST
+
+START_TEST(test_dijkstra)
+{
+    // 0 -> 1 (4), 0 -> 2 (1), 2 -> 1 (2), 1 -> 3 (5), 2 -> 3 (8); vertex 4 is unreachable
+    int64_t offsets[] = {0, 2, 3, 5, 5, 5};
+    int64_t targets[] = {1, 2, 3, 1, 3};
+    int64_t weights[] = {4, 1, 5, 2, 8};
+    Fib_Csr_Graph g = {5, 5, offsets, targets, weights};
+    int64_t dist[5], pred[5];
+    ck_assert(check_csr_graph(&g, false));
+    ck_assert(dijkstra_fib_heap(&g, 0, FIB_GRAPH_NO_TARGET, FIB_GRAPH_NO_RADIUS, dist, pred));
+    int64_t want_dist[] = {0, 3, 1, 8, FIB_GRAPH_NONE};
+    int64_t want_pred[] = {FIB_GRAPH_NONE, 2, 0, 1, FIB_GRAPH_NONE};
+    ck_assert_int_eq(memcmp(dist, want_dist, sizeof(dist)), 0);
+    ck_assert_int_eq(memcmp(pred, want_pred, sizeof(pred)), 0);
+
+    // Stopping at vertex 1 reports only what was settled by then; a radius of 3 leaves out 3
+    ck_assert(dijkstra_fib_heap(&g, 0, 1, FIB_GRAPH_NO_RADIUS, dist, pred));
+    ck_assert_int_eq(dist[1], 3);
+    ck_assert_int_eq(dist[3], FIB_GRAPH_NONE);
+    ck_assert(dijkstra_fib_heap(&g, 0, FIB_GRAPH_NO_TARGET, 3, dist, pred));
+    ck_assert_int_eq(dist[1], 3);
+    ck_assert_int_eq(dist[3], FIB_GRAPH_NONE);
+    ck_assert_int_eq(pred[3], FIB_GRAPH_NONE);
+
+    // Bad arguments and malformed graphs
+    ck_assert(!dijkstra_fib_heap(&g, 5, FIB_GRAPH_NO_TARGET, FIB_GRAPH_NO_RADIUS, dist, pred));
+    ck_assert(!dijkstra_fib_heap(&g, 0, 7, FIB_GRAPH_NO_RADIUS, dist, pred));
+    ck_assert(!dijkstra_fib_heap(&g, 0, FIB_GRAPH_NO_TARGET, -1, dist, pred));
+    weights[2] = -5;
+    ck_assert(!check_csr_graph(&g, false));
+    ck_assert(check_csr_graph(&g, true));
+    weights[2] = 5;
+    targets[0] = 5;
+    ck_assert(!check_csr_graph(&g, false));
+    targets[0] = 1;
+    offsets[2] = 1;
+    ck_assert(!check_csr_graph(&g, false));
+    offsets[2] = 3;
+
+    // A random graph against Bellman-Ford; large weights make some paths overflow int64
+    enum { N = 300, DEGREE = 6 };
+    static int64_t r_offsets[N + 1], r_targets[N * DEGREE], r_weights[N * DEGREE];
+    static int64_t r_dist[N], r_pred[N], bf[N];
+    uint64_t state = 88172645463325252ULL;
+    for (int v = 0; v <= N; v++) {
+        r_offsets[v] = (int64_t)v * DEGREE;
+    }
+    for (int e = 0; e < N * DEGREE; e++) {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        r_targets[e] = (int64_t)(state % N);
+        r_weights[e] = e % 97 == 0 ? INT64_MAX / 2 : (int64_t)(state >> 40) % 1000;
+    }
+    Fib_Csr_Graph rg = {N, N * DEGREE, r_offsets, r_targets, r_weights};
+    ck_assert(check_csr_graph(&rg, false));
+    ck_assert(dijkstra_fib_heap(&rg, 0, FIB_GRAPH_NO_TARGET, FIB_GRAPH_NO_RADIUS, r_dist, r_pred));
+    for (int v = 0; v < N; v++) {
+        bf[v] = v == 0 ? 0 : FIB_GRAPH_NONE;
+    }
+    for (bool changed = true; changed;) {
+        changed = false;
+        for (int u = 0; u < N; u++) {
+            for (int64_t e = r_offsets[u]; bf[u] != FIB_GRAPH_NONE && e < r_offsets[u + 1]; e++) {
+                int64_t v = r_targets[e];
+                if (r_weights[e] <= INT64_MAX - bf[u] && (bf[v] == FIB_GRAPH_NONE || bf[u] + r_weights[e] < bf[v])) {
+                    bf[v] = bf[u] + r_weights[e];
+                    changed = true;
+                }
+            }
+        }
+    }
+    for (int v = 0; v < N; v++) {
+        ck_assert_int_eq(r_dist[v], bf[v]);
+        if (v != 0 && r_dist[v] != FIB_GRAPH_NONE) {
+            // The predecessor lies on a shortest path
+            int64_t u = r_pred[v];
+            bool found = false;
+            for (int64_t e = r_offsets[u]; e < r_offsets[u + 1]; e++) {
+                found = found || (r_targets[e] == v && r_dist[u] + r_weights[e] == r_dist[v]);
+            }
+            ck_assert(found);
+        }
+    }
+}
+END_TEST
+
+START_TEST(test_prim)
+{
+    // Undirected: 0-1 (4), 0-2 (1), 1-2 (-2), 1-3 (5), 2-3 (8); 4-5 (7) is a second component
+    int64_t offsets[] = {0, 2, 5, 8, 10, 11, 12};
+    int64_t targets[] = {1, 2, 0, 2, 3, 0, 1, 3, 1, 2, 5, 4};
+    int64_t weights[] = {4, 1, 4, -2, 5, 1, -2, 8, 5, 8, 7, 7};
+    Fib_Csr_Graph g = {6, 12, offsets, targets, weights};
+    int64_t parent[6], weight[6];
+    ck_assert(check_csr_graph(&g, true));
+    ck_assert(prim_fib_heap(&g, 0, parent, weight));
+    int64_t want_parent[] = {FIB_GRAPH_NONE, 2, 0, 1, FIB_GRAPH_NONE, 4};
+    int64_t want_weight[] = {0, -2, 1, 5, 0, 7};
+    ck_assert_int_eq(memcmp(parent, want_parent, sizeof(parent)), 0);
+    ck_assert_int_eq(memcmp(weight, want_weight, sizeof(weight)), 0);
+    ck_assert(prim_fib_heap(&g, 5, parent, weight));
+    ck_assert_int_eq(parent[5], FIB_GRAPH_NONE);
+    ck_assert_int_eq(parent[4], 5);
+    ck_assert_int_eq(parent[0], FIB_GRAPH_NONE);
+    ck_assert(!prim_fib_heap(&g, 6, parent, weight));
+
+    // A random graph against the O(n^2) array version of Prim's algorithm
+    enum { N = 200, EDGES = 1000 };
+    static int64_t matrix[N][N], r_offsets[N + 1], r_targets[2 * EDGES], r_weights[2 * EDGES];
+    static int64_t r_parent[N], r_weight[N], best[N];
+    static int degree[N];
+    static bool spanned[N];
+    uint64_t state = 88172645463325252ULL;
+    int edge_u[EDGES], edge_v[EDGES];
+    int64_t edge_w[EDGES];
+    for (int e = 0; e < EDGES; e++) {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        edge_u[e] = (int)(state % N);
+        edge_v[e] = (int)((state >> 20) % N);
+        edge_w[e] = (int64_t)(state >> 40) % 1000 - 300;
+        degree[edge_u[e]]++;
+        degree[edge_v[e]]++;
+    }
+    for (int v = 0; v < N; v++) {
+        r_offsets[v + 1] = r_offsets[v] + degree[v];
+        degree[v] = 0;
+        for (int u = 0; u < N; u++) {
+            matrix[v][u] = INT64_MAX; // No edge
+        }
+    }
+    for (int e = 0; e < EDGES; e++) {
+        int u = edge_u[e], v = edge_v[e];
+        r_targets[r_offsets[u] + degree[u]] = v;
+        r_weights[r_offsets[u] + degree[u]++] = edge_w[e];
+        r_targets[r_offsets[v] + degree[v]] = u;
+        r_weights[r_offsets[v] + degree[v]++] = edge_w[e];
+        if (u != v && edge_w[e] < matrix[u][v]) {
+            matrix[u][v] = matrix[v][u] = edge_w[e];
+        }
+    }
+    Fib_Csr_Graph rg = {N, 2 * EDGES, r_offsets, r_targets, r_weights};
+    ck_assert(check_csr_graph(&rg, true));
+    ck_assert(prim_fib_heap(&rg, 0, r_parent, r_weight));
+    int64_t total = 0, expected = 0;
+    for (int v = 0; v < N; v++) {
+        total += r_weight[v];
+        if (r_parent[v] != FIB_GRAPH_NONE) {
+            ck_assert_int_eq(matrix[v][r_parent[v]], r_weight[v]);
+        }
+        best[v] = INT64_MAX;
+    }
+    for (int round = 0; round < N; round++) {
+        int u = -1;
+        for (int v = 0; v < N; v++) {
+            if (!spanned[v] && (u < 0 || (best[v] < best[u]))) {
+                u = v;
+            }
+        }
+        spanned[u] = true;
+        expected += best[u] == INT64_MAX ? 0 : best[u]; // A new component starts at u
+        for (int v = 0; v < N; v++) {
+            if (!spanned[v] && matrix[u][v] < best[v]) {
+                best[v] = matrix[u][v];
+            }
+        }
+    }
+    ck_assert_int_eq(total, expected);
+}
+END_TEST
+
+// Helper for test_astar: the grid as a CSR graph with the same step costs, for dijkstra_fib_heap
+static Fib_Csr_Graph grid_as_graph(const Fib_Grid *grid, int64_t *offsets, int64_t *targets, int64_t *weights) {
+    static const int steps[8][2] = {{1, 0}, {-1, 0}, {0, 1}, {0, -1}, {1, 1}, {1, -1}, {-1, 1}, {-1, -1}};
+    size_t w = grid->width, m = 0;
+    for (size_t u = 0; u < w * grid->height; u++) {
+        offsets[u] = (int64_t)m;
+        long ux = (long)(u % w), uy = (long)(u / w);
+        for (int d = 0; d < (grid->diagonal ? 8 : 4) && grid->cells[u] != 0; d++) {
+            long vx = ux + steps[d][0], vy = uy + steps[d][1];
+            if (vx < 0 || vy < 0 || vx >= (long)w || vy >= (long)grid->height || grid->cells[vy * w + vx] == 0
+                || (d >= 4 && (grid->cells[uy * w + vx] == 0 || grid->cells[vy * w + ux] == 0))) {
+                continue;
+            }
+            targets[m] = vy * (long)w + vx;
+            weights[m++] = grid->cells[vy * w + vx] * (d >= 4 ? FIB_GRID_DIAGONAL : FIB_GRID_STRAIGHT);
+        }
+    }
+    offsets[w * grid->height] = (int64_t)m;
+    Fib_Csr_Graph g = {w * grid->height, m, offsets, targets, weights};
+    return g;
+}
+
+START_TEST(test_astar)
+{
+    // 5x3, with a wall in column 2 open only at the bottom
+    const uint8_t cells[] = {
+        1, 1, 0, 1, 1,
+        1, 1, 0, 1, 1,
+        1, 1, 1, 1, 9,
+    };
+    Fib_Grid grid = {cells, 5, 3, false};
+    Fib_Grid_Path path;
+    ck_assert(astar_grid_fib_heap(&grid, 0, 4, FIB_GRID_MANHATTAN, FIB_GRID_NO_BUDGET, &path));
+    ck_assert(!path.exhausted);
+    ck_assert_uint_eq(path.length, 9);
+    ck_assert_int_eq(path.cost, 8 * FIB_GRID_STRAIGHT);
+    ck_assert_int_eq(path.cells[0], 0);
+    ck_assert_int_eq(path.cells[4], 12);
+    ck_assert_int_eq(path.cells[8], 4);
+    free(path.cells);
+
+    // Diagonally: no corner of the wall may be cut, so only the first and last steps are diagonal
+    grid.diagonal = true;
+    ck_assert(astar_grid_fib_heap(&grid, 0, 4, FIB_GRID_OCTILE, FIB_GRID_NO_BUDGET, &path));
+    int64_t want[] = {0, 6, 11, 12, 13, 8, 4};
+    ck_assert_uint_eq(path.length, 7);
+    ck_assert_int_eq(memcmp(path.cells, want, sizeof(want)), 0);
+    ck_assert_int_eq(path.cost, 2 * FIB_GRID_DIAGONAL + 4 * FIB_GRID_STRAIGHT);
+    free(path.cells);
+
+    // Start is goal; blocked goal; a budget too small; bad arguments
+    ck_assert(astar_grid_fib_heap(&grid, 6, 6, FIB_GRID_EUCLIDEAN, 1, &path));
+    ck_assert_uint_eq(path.length, 1);
+    ck_assert_int_eq(path.cost, 0);
+    free(path.cells);
+    ck_assert(astar_grid_fib_heap(&grid, 0, 2, FIB_GRID_OCTILE, FIB_GRID_NO_BUDGET, &path));
+    ck_assert_ptr_null(path.cells);
+    ck_assert_int_eq(path.cost, FIB_GRAPH_NONE);
+    ck_assert(astar_grid_fib_heap(&grid, 0, 4, FIB_GRID_OCTILE, 3, &path));
+    ck_assert(path.exhausted);
+    ck_assert_ptr_null(path.cells);
+    ck_assert_uint_eq(path.expanded, 3);
+    ck_assert(!astar_grid_fib_heap(&grid, 0, 15, FIB_GRID_OCTILE, FIB_GRID_NO_BUDGET, &path));
+    ck_assert(!astar_grid_fib_heap(&grid, 0, 4, 3, FIB_GRID_NO_BUDGET, &path));
+
+    // Random grids: every admissible heuristic finds a path as cheap as Dijkstra's, and
+    // Euclidean never expands fewer cells than octile
+    enum { W = 60, H = 40 };
+    static uint8_t r_cells[W * H];
+    static int64_t offsets[W * H + 1], targets[8 * W * H], weights[8 * W * H], dist[W * H], pred[W * H];
+    uint64_t state = 88172645463325252ULL;
+    for (int round = 0; round < 4; round++) {
+        for (int c = 0; c < W * H; c++) {
+            state ^= state << 13;
+            state ^= state >> 7;
+            state ^= state << 17;
+            r_cells[c] = state % 4 == 0 ? 0 : (uint8_t)(1 + (state >> 32) % (round < 2 ? 1 : 20));
+        }
+        r_cells[0] = r_cells[W * H - 1] = 1;
+        Fib_Grid r_grid = {r_cells, W, H, round % 2 == 1};
+        Fib_Csr_Graph g = grid_as_graph(&r_grid, offsets, targets, weights);
+        ck_assert(dijkstra_fib_heap(&g, 0, FIB_GRAPH_NO_TARGET, FIB_GRAPH_NO_RADIUS, dist, pred));
+        int heuristics[] = {r_grid.diagonal ? FIB_GRID_OCTILE : FIB_GRID_MANHATTAN, FIB_GRID_EUCLIDEAN};
+        size_t expanded[2];
+        for (int h = 0; h < 2; h++) {
+            ck_assert(astar_grid_fib_heap(&r_grid, 0, W * H - 1, heuristics[h], FIB_GRID_NO_BUDGET, &path));
+            ck_assert_int_eq(path.cost, dist[W * H - 1]);
+            expanded[h] = path.expanded;
+            free(path.cells);
+        }
+        ck_assert_uint_le(expanded[0], expanded[1]);
+    }
+}
+END_TEST
+
+START_TEST(test_heap_select)
+{
+    ck_assert_ptr_null(create_heap_select(0, true));
+    Heap_Select *s = create_heap_select(3, true);
+    ck_assert_ptr_nonnull(s);
+    int64_t key, out[8];
+    ck_assert(!get_threshold_heap_select(s, &key));
+    ck_assert(insert_heap_select(s, 5, NULL));
+    ck_assert(insert_heap_select(s, 1, NULL));
+    ck_assert(!get_threshold_heap_select(s, &key)); // Not full yet
+    ck_assert(insert_heap_select(s, 3, NULL));
+    ck_assert(get_threshold_heap_select(s, &key));
+    ck_assert(key == 1);
+    ck_assert(!insert_heap_select(s, 0, NULL));
+    ck_assert(!insert_heap_select(s, 1, NULL)); // Ties with the k-th best are rejected
+    ck_assert(insert_heap_select(s, 4, NULL));
+    ck_assert(get_threshold_heap_select(s, &key));
+    ck_assert(key == 3);
+    ck_assert_uint_eq(sorted_heap_select(s, out, NULL), 3);
+    ck_assert(out[0] == 5 && out[1] == 4 && out[2] == 3);
+    ck_assert_uint_eq(s->n, 3); // Listing leaves the selector as it was
+    clear_heap_select(s);
+    ck_assert_uint_eq(s->n, 0);
+    destroy_heap_select(s);
+
+    // Bottom-k, down to INT64_MIN
+    s = create_heap_select(2, false);
+    int64_t extremes[] = {INT64_MAX, 0, INT64_MIN, -1, INT64_MAX};
+    ck_assert_uint_eq(insert_many_heap_select(s, extremes, 5), 4);
+    ck_assert_uint_eq(sorted_heap_select(s, out, NULL), 2);
+    ck_assert(out[0] == INT64_MIN && out[1] == -1);
+    ck_assert(get_threshold_heap_select(s, &key));
+    ck_assert(key == -1);
+    destroy_heap_select(s);
+
+    // Evicted and remaining payloads go to free_payload; rejected ones stay with the caller
+    s = create_heap_select(2, true);
+    s->free_payload = count_free_payload;
+    freed_payloads = 0;
+    for (int i = 0; i < 5; i++) {
+        ck_assert(insert_heap_select(s, i, create_int_ptr(i)));
+    }
+    ck_assert_int_eq(freed_payloads, 3);
+    int *rejected = create_int_ptr(-1);
+    ck_assert(!insert_heap_select(s, -1, rejected));
+    free(rejected);
+    void *payloads[2];
+    ck_assert_uint_eq(sorted_heap_select(s, out, payloads), 2);
+    ck_assert(out[0] == 4 && *(int *)payloads[0] == 4 && *(int *)payloads[1] == 3);
+    destroy_heap_select(s);
+    ck_assert_int_eq(freed_payloads, 5);
+
+    // Random streams in chunks against a sort, both ways, for k below and above the length
+    enum { N = 5000 };
+    static int64_t keys[N], sorted[N], got[N];
+    uint64_t state = 88172645463325252ULL;
+    for (int i = 0; i < N; i++) {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        keys[i] = (int64_t)(state % 2000) - 1000; // Plenty of duplicates
+    }
+    memcpy(sorted, keys, sizeof(keys));
+    qsort(sorted, N, sizeof(int64_t), compare_fib_keys);
+    size_t ks[] = {1, 7, 100, N, N + 10};
+    for (int largest = 0; largest < 2; largest++) {
+        for (size_t t = 0; t < sizeof(ks) / sizeof(ks[0]); t++) {
+            s = create_heap_select(ks[t], largest);
+            for (size_t start = 0; start < N; start += 333) {
+                insert_many_heap_select(s, keys + start, N - start < 333 ? N - start : 333);
+            }
+            size_t n = sorted_heap_select(s, got, NULL);
+            ck_assert_uint_eq(n, ks[t] < N ? ks[t] : N);
+            for (size_t i = 0; i < n; i++) {
+                ck_assert(got[i] == (largest ? sorted[N - 1 - i] : sorted[i]));
+            }
+            destroy_heap_select(s);
+        }
+    }
+}
+END_TEST
+
+START_TEST(test_compact_heap)
+{
+    ck_assert_uint_eq(sizeof(Fibonacci_Compact_Node) + sizeof(Fibonacci_Key), sizeof(Fibonacci_Node) / 2);
+
+    Fibonacci_Compact_Heap *heap = create_fib_compact_heap(0);
+    ck_assert_ptr_nonnull(heap);
+    ck_assert_ptr_null(heap->payloads);
+    Fibonacci_Key key;
+    ck_assert(!get_min_fib_compact_heap(heap, &key, NULL));
+
+    // Same operations as the pointer-based heap
+    Fibonacci_Compact_Id ten = insert_fib_compact_heap(heap, 10, NULL);
+    Fibonacci_Compact_Id twenty = insert_fib_compact_heap(heap, 20, NULL);
+    ck_assert_ptr_null(heap->payloads);
+    int tag = 0;
+    insert_fib_compact_heap(heap, 5, &tag);
+    ck_assert_ptr_nonnull(heap->payloads); // Created on the first payload
+    Fibonacci_Key more[] = {30, 1, 15};
+    ck_assert(insert_many_fib_compact_heap(heap, more, 3));
+    ck_assert_uint_eq(heap->n, 6);
+
+    void *payload;
+    ck_assert(extract_min_fib_compact_heap(heap, &key, &payload));
+    ck_assert(key == 1);
+    ck_assert_ptr_null(payload);
+    ck_assert(get_min_fib_compact_heap(heap, &key, &payload));
+    ck_assert(key == 5);
+    ck_assert_ptr_eq(payload, &tag);
+    ck_assert(decrease_key_fib_compact_heap(heap, twenty, 2));
+    ck_assert(!decrease_key_fib_compact_heap(heap, twenty, 3));
+    ck_assert(delete_node_fib_compact_heap(heap, ten, &key, NULL));
+    ck_assert(key == 10);
+    ck_assert(!delete_node_fib_compact_heap(heap, ten, NULL, NULL)); // Already gone
+    ck_assert(change_fib_compact_node_key(heap, 2, 40));
+    ck_assert(get_key_fib_compact_node(heap, twenty) == 40); // Same id after an increase
+    ck_assert(delete_fib_compact_node_key(heap, 15, NULL));
+    ck_assert(!delete_fib_compact_node_key(heap, 15, NULL));
+
+    Fibonacci_Key out[8];
+    ck_assert_uint_eq(extract_min_many_fib_compact_heap(heap, out, NULL, 8), 3);
+    ck_assert(out[0] == 5 && out[1] == 30 && out[2] == 40);
+    ck_assert_uint_eq(heap->n, 0);
+    destroy_fib_compact_heap(heap);
+}
+END_TEST
+
+// --- Differential driver for the *_matches_pointer_heap tests ---
+// Drives an engine and a Fibonacci heap through the same random operations and checks that
+// they agree on the size and the minimum after every step, then drains both. Element i is
+// inserted with payload i + 1, so an extraction from the engine names the element the
+// reference has to drop; equal keys may then come out in either order.
+
+enum { DIFF_N = 5000, DIFF_STEPS = 20000 };
+
+typedef struct Diff_Run Diff_Run;
+
+// One engine's operations on 'heap'. Elements are whatever the engine hands out per insert.
+typedef struct Diff_Binding {
+    void *heap;
+    size_t (*size)(const void *heap);
+    int64_t (*new_key)(const void *heap, uint64_t random, int64_t serial); // Accepted right now
+    int64_t (*lower_key)(const void *heap, int64_t key, uint64_t random);  // At most key
+    void *(*insert)(void *heap, int64_t key, void *payload);
+    bool (*get_min)(void *heap, int64_t *key_out);
+    bool (*extract_min)(void *heap, int64_t *key_out, void **payload_out);
+    int64_t (*get_key)(const void *heap, const void *element);
+    bool (*decrease_key)(void *heap, void *element, int64_t new_key);
+    bool (*delete_element)(void *heap, void *element);
+    // Optional: an engine-specific operation, run for one op in eight with a fresh key
+    void (*extra)(Diff_Run *run, int pick, int64_t key);
+} Diff_Binding;
+
+struct Diff_Run {
+    const Diff_Binding *b;
+    Fibonacci_Heap *reference;
+    Fibonacci_Node *ref_nodes[DIFF_N];
+    void *elements[DIFF_N];
+    bool live[DIFF_N];
+    int inserted;
+};
+
+// Helper for run_differential: takes the engine's minimum out of both heaps. A payload of
+// NULL is an element the extra operation added untracked; keys are unique then.
+static bool extract_differential(Diff_Run *run) {
+    Fibonacci_Key expected;
+    int64_t key;
+    void *tag;
+    bool had = get_min_fib_heap_key(run->reference, &expected, NULL);
+    ck_assert(had == run->b->extract_min(run->b->heap, &key, &tag));
+    if (had) {
+        ck_assert(key == expected);
+        if (tag != NULL) {
+            int i = (int)(intptr_t)tag - 1;
+            ck_assert(delete_node_fib_heap_key(run->reference, run->ref_nodes[i], NULL, NULL));
+            run->live[i] = false;
+        } else {
+            ck_assert(extract_min_fib_heap_key(run->reference, NULL, NULL));
+        }
+    }
+    return had;
+}
+
+static void run_differential(const Diff_Binding *b, uint64_t seed) {
+    static Diff_Run run;
+    run.b = b;
+    run.reference = create_fib_heap();
+    run.inserted = 0;
+    ck_assert_ptr_nonnull(run.reference);
+
+    uint64_t state = 88172645463325252ULL + seed;
+    int64_t serial = 0; // Low bits some engines use to keep every key unique
+    for (int step = 0; step < DIFF_STEPS; step++) {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        int op = (int)(state % 8);
+        int pick = run.inserted > 0 ? (int)((state >> 40) % (uint64_t)run.inserted) : 0;
+        bool live = run.inserted > 0 && run.live[pick];
+
+        if (op < 3 && run.inserted < DIFF_N) {
+            int64_t value = b->new_key(b->heap, state, serial++);
+            void *tag = (void *)(intptr_t)(run.inserted + 1);
+            run.ref_nodes[run.inserted] = insert_fib_heap_key(run.reference, value, tag);
+            run.elements[run.inserted] = b->insert(b->heap, value, tag);
+            ck_assert_ptr_nonnull(run.elements[run.inserted]);
+            run.live[run.inserted++] = true;
+        } else if (op == 3 || op == 4) {
+            extract_differential(&run);
+        } else if (op == 5 && live) {
+            int64_t lower = b->lower_key(b->heap, b->get_key(b->heap, run.elements[pick]), state);
+            ck_assert(decrease_key_fib_heap_key(run.reference, run.ref_nodes[pick], lower));
+            ck_assert(b->decrease_key(b->heap, run.elements[pick], lower));
+        } else if (op == 6 && live) {
+            ck_assert(delete_node_fib_heap_key(run.reference, run.ref_nodes[pick], NULL, NULL));
+            ck_assert(b->delete_element(b->heap, run.elements[pick]));
+            run.live[pick] = false;
+        } else if (op == 7 && b->extra != NULL) {
+            b->extra(&run, pick, b->new_key(b->heap, state, serial++));
+        }
+        ck_assert_uint_eq(b->size(b->heap), (size_t)run.reference->n);
+        Fibonacci_Key expected;
+        int64_t key;
+        if (get_min_fib_heap_key(run.reference, &expected, NULL)) {
+            ck_assert(b->get_min(b->heap, &key));
+            ck_assert(key == expected);
+        }
+    }
+
+    // Drain both; the key sequences must be identical
+    while (extract_differential(&run)) {
+    }
+    ck_assert_uint_eq(b->size(b->heap), 0);
+    destroy_fib_heap(run.reference);
+}
+
+// Keys for engines that take any int64: random, with the serial in the low bits so every
+// key stays unique, and decreases in steps that keep those bits
+static int64_t unique_new_key(const void *heap, uint64_t random, int64_t serial) {
+    (void)heap;
+    return ((int64_t)((random >> 20) % 1000) - 500) * 16384 + serial;
+}
+
+static int64_t unique_lower_key(const void *heap, int64_t key, uint64_t random) {
+    (void)heap;
+    return key - (int64_t)(1 + random % 8) * 16384;
+}
+
+// Compact heap binding: an element is its id + 1, so that id 0 is not NULL
+static size_t compact_size(const void *heap) {
+    return ((const Fibonacci_Compact_Heap *)heap)->n;
+}
+
+static void *compact_insert(void *heap, int64_t key, void *payload) {
+    return (void *)(uintptr_t)(insert_fib_compact_heap(heap, key, payload) + 1);
+}
+
+static bool compact_get_min(void *heap, int64_t *key_out) {
+    return get_min_fib_compact_heap(heap, key_out, NULL);
+}
+
+static bool compact_extract_min(void *heap, int64_t *key_out, void **payload_out) {
+    return extract_min_fib_compact_heap(heap, key_out, payload_out);
+}
+
+static int64_t compact_get_key(const void *heap, const void *element) {
+    return get_key_fib_compact_node(heap, (Fibonacci_Compact_Id)((uintptr_t)element - 1));
+}
+
+static bool compact_decrease_key(void *heap, void *element, int64_t new_key) {
+    return decrease_key_fib_compact_heap(heap, (Fibonacci_Compact_Id)((uintptr_t)element - 1), new_key);
+}
+
+static bool compact_delete(void *heap, void *element) {
+    return delete_node_fib_compact_heap(heap, (Fibonacci_Compact_Id)((uintptr_t)element - 1), NULL, NULL);
+}
+
+static Fibonacci_Compact_Heap *compact_other;
+static Fibonacci_Heap *compact_reference_other;
+
+// Untracked keys go into a second pair of heaps, melded in every 32 keys: the ids of the
+// other heap move up, those already in this one must stay
+static void compact_extra(Diff_Run *run, int pick, int64_t key) {
+    (void)pick;
+    insert_fib_compact_heap(compact_other, key, NULL);
+    insert_fib_heap_key(compact_reference_other, key, NULL);
+    if (compact_other->n == 32) {
+        Fibonacci_Compact_Heap *compact = run->b->heap;
+        uint32_t used = compact->used, offset;
+        ck_assert(meld_fib_compact_heap(compact, compact_other, &offset));
+        ck_assert(meld_fib_heap(run->reference, compact_reference_other));
+        ck_assert_uint_eq(offset, used);
+        ck_assert_uint_eq(compact_other->n, 0);
+    }
+}
+
+START_TEST(test_compact_heap_matches_pointer_heap)
+{
+    // Both layouts must agree on every minimum, across melds too
+    Fibonacci_Compact_Heap *compact = create_fib_compact_heap(0);
+    compact_other = create_fib_compact_heap(0);
+    compact_reference_other = create_fib_heap();
+    ck_assert_ptr_nonnull(compact);
+    ck_assert_ptr_nonnull(compact_other);
+    ck_assert_ptr_nonnull(compact_reference_other);
+    Diff_Binding b = {compact, compact_size, unique_new_key, unique_lower_key, compact_insert,
+                      compact_get_min, compact_extract_min, compact_get_key, compact_decrease_key,
+                      compact_delete, compact_extra};
+    run_differential(&b, 0);
+    destroy_fib_heap(compact_reference_other);
+    destroy_fib_compact_heap(compact_other);
+    destroy_fib_compact_heap(compact);
+}
+END_TEST
+
+START_TEST(test_dary_heap)
+{
+    ck_assert_ptr_null(create_dary_heap(1));
+    ck_assert_ptr_null(create_dary_heap(DARY_HEAP_MAX_ARITY + 1));
+
+    Dary_Heap *heap = create_dary_heap(4);
+    ck_assert_ptr_nonnull(heap);
+    int64_t key;
+    ck_assert(!get_min_dary_heap(heap, &key, NULL));
+
+    // Same operations as the Fibonacci heap, with slots as handles
+    Dary_Heap_Slot *ten = insert_dary_heap(heap, 10, NULL);
+    Dary_Heap_Slot *twenty = insert_dary_heap(heap, 20, NULL);
+    int tag = 0;
+    insert_dary_heap(heap, 5, &tag);
+    int64_t more[] = {30, 1, 15};
+    ck_assert(insert_many_dary_heap(heap, more, 3));
+    ck_assert_uint_eq(heap->n, 6);
+
+    void *payload;
+    ck_assert(extract_min_dary_heap(heap, &key, &payload));
+    ck_assert(key == 1);
+    ck_assert_ptr_null(payload);
+    ck_assert(get_min_dary_heap(heap, &key, &payload));
+    ck_assert(key == 5);
+    ck_assert_ptr_eq(payload, &tag);
+    ck_assert(decrease_key_dary_heap(heap, twenty, 2));
+    ck_assert(!decrease_key_dary_heap(heap, twenty, 3));
+    ck_assert(get_key_dary_heap_slot(heap, twenty) == 2);
+    ck_assert(delete_node_dary_heap(heap, ten, &key, NULL));
+    ck_assert(key == 10);
+    change_key_dary_heap(heap, twenty, 40);
+    ck_assert(get_key_dary_heap_slot(heap, twenty) == 40); // Same slot after an increase
+    ck_assert_ptr_eq(find_slot_dary_heap_key(heap, 40), twenty);
+    ck_assert_ptr_null(find_slot_dary_heap_key(heap, 10));
+
+    // Meld moves the slots along; the source stays usable
+    Dary_Heap *other = create_dary_heap(2);
+    ck_assert_ptr_nonnull(other);
+    Dary_Heap_Slot *three = insert_dary_heap(other, 3, NULL);
+    insert_dary_heap(other, 50, NULL);
+    ck_assert(!meld_dary_heap(heap, heap));
+    ck_assert(meld_dary_heap(heap, other));
+    ck_assert_uint_eq(other->n, 0);
+    ck_assert_uint_eq(heap->n, 6);
+    ck_assert(decrease_key_dary_heap(heap, three, -1));
+    insert_dary_heap(other, 7, NULL);
+    ck_assert_uint_eq(other->n, 1);
+    destroy_dary_heap(other);
+
+    int64_t out[8];
+    ck_assert_uint_eq(extract_min_many_dary_heap(heap, out, NULL, 8), 6);
+    ck_assert(out[0] == -1 && out[1] == 5 && out[2] == 15 && out[3] == 30 && out[4] == 40 && out[5] == 50);
+    ck_assert_uint_eq(heap->n, 0);
+    destroy_dary_heap(heap);
+}
+END_TEST
+
+// D-ary heap binding
+static size_t dary_size(const void *heap) {
+    return ((const Dary_Heap *)heap)->n;
+}
+
+static void *dary_insert(void *heap, int64_t key, void *payload) {
+    return insert_dary_heap(heap, key, payload);
+}
+
+static bool dary_get_min(void *heap, int64_t *key_out) {
+    return get_min_dary_heap(heap, key_out, NULL);
+}
+
+static bool dary_extract_min(void *heap, int64_t *key_out, void **payload_out) {
+    return extract_min_dary_heap(heap, key_out, payload_out);
+}
+
+static int64_t dary_get_key(const void *heap, const void *element) {
+    return get_key_dary_heap_slot(heap, element);
+}
+
+static bool dary_decrease_key(void *heap, void *element, int64_t new_key) {
+    return decrease_key_dary_heap(heap, element, new_key);
+}
+
+static bool dary_delete(void *heap, void *element) {
+    return delete_node_dary_heap(heap, element, NULL, NULL);
+}
+
+START_TEST(test_dary_heap_matches_pointer_heap)
+{
+    static const unsigned arities[] = {2, 4, 8, 64};
+    for (size_t a = 0; a < sizeof(arities) / sizeof(arities[0]); a++) {
+        Dary_Heap *heap = create_dary_heap(arities[a]);
+        ck_assert_ptr_nonnull(heap);
+        Diff_Binding b = {heap, dary_size, unique_new_key, unique_lower_key, dary_insert, dary_get_min,
+                          dary_extract_min, dary_get_key, dary_decrease_key, dary_delete, NULL};
+        run_differential(&b, a);
+        destroy_dary_heap(heap);
+    }
+}
+END_TEST
+
+START_TEST(test_pairing_heap)
+{
+    Pairing_Heap *heap = create_pairing_heap();
+    ck_assert_ptr_nonnull(heap);
+    int64_t key;
+    ck_assert(!get_min_pairing_heap(heap, &key, NULL));
+
+    Pairing_Node *ten = insert_pairing_heap(heap, 10, NULL);
+    Pairing_Node *twenty = insert_pairing_heap(heap, 20, NULL);
+    int tag = 0;
+    insert_pairing_heap(heap, 5, &tag);
+    int64_t more[] = {30, 1, 15};
+    ck_assert(insert_many_pairing_heap(heap, more, 3));
+    ck_assert_uint_eq(heap->n, 6);
+
+    void *payload;
+    ck_assert(extract_min_pairing_heap(heap, &key, &payload));
+    ck_assert(key == 1);
+    ck_assert_ptr_null(payload);
+    ck_assert(get_min_pairing_heap(heap, &key, &payload));
+    ck_assert(key == 5);
+    ck_assert_ptr_eq(payload, &tag);
+    ck_assert(decrease_key_pairing_heap(heap, twenty, 2));
+    ck_assert(!decrease_key_pairing_heap(heap, twenty, 3));
+    ck_assert(delete_node_pairing_heap(heap, ten, &key, NULL));
+    ck_assert(key == 10);
+    change_key_pairing_heap(heap, twenty, 40); // The root, which has children
+    ck_assert(twenty->key == 40);
+    ck_assert(get_min_pairing_heap(heap, &key, NULL));
+    ck_assert(key == 5);
+    ck_assert_ptr_eq(find_node_pairing_heap_key(heap, 40), twenty);
+    ck_assert_ptr_null(find_node_pairing_heap_key(heap, 10));
+
+    // Meld links the roots and hands over the pool; the source stays usable
+    Pairing_Heap *other = create_pairing_heap();
+    ck_assert_ptr_nonnull(other);
+    Pairing_Node *three = insert_pairing_heap(other, 3, NULL);
+    insert_pairing_heap(other, 50, NULL);
+    ck_assert(!meld_pairing_heap(heap, heap));
+    ck_assert(meld_pairing_heap(heap, other));
+    ck_assert_uint_eq(other->n, 0);
+    ck_assert_uint_eq(heap->n, 6);
+    ck_assert(decrease_key_pairing_heap(heap, three, -1));
+    insert_pairing_heap(other, 7, NULL);
+    ck_assert_uint_eq(other->n, 1);
+    destroy_pairing_heap(other);
+
+    int64_t out[8];
+    ck_assert_uint_eq(extract_min_many_pairing_heap(heap, out, NULL, 8), 6);
+    ck_assert(out[0] == -1 && out[1] == 5 && out[2] == 15 && out[3] == 30 && out[4] == 40 && out[5] == 50);
+    ck_assert_ptr_null(heap->root);
+    destroy_pairing_heap(heap);
+}
+END_TEST
+
+// Pairing heap binding
+static size_t pairing_size(const void *heap) {
+    return ((const Pairing_Heap *)heap)->n;
+}
+
+static void *pairing_insert(void *heap, int64_t key, void *payload) {
+    return insert_pairing_heap(heap, key, payload);
+}
+
+static bool pairing_get_min(void *heap, int64_t *key_out) {
+    return get_min_pairing_heap(heap, key_out, NULL);
+}
+
+static bool pairing_extract_min(void *heap, int64_t *key_out, void **payload_out) {
+    return extract_min_pairing_heap(heap, key_out, payload_out);
+}
+
+static int64_t pairing_get_key(const void *heap, const void *element) {
+    (void)heap;
+    return ((const Pairing_Node *)element)->key;
+}
+
+static bool pairing_decrease_key(void *heap, void *element, int64_t new_key) {
+    return decrease_key_pairing_heap(heap, element, new_key);
+}
+
+static bool pairing_delete(void *heap, void *element) {
+    return delete_node_pairing_heap(heap, element, NULL, NULL);
+}
+
+// Increases a key: by deleting and reinserting in the reference, in place in the pairing heap
+static void pairing_extra(Diff_Run *run, int pick, int64_t key) {
+    (void)key;
+    if (run->inserted == 0 || !run->live[pick]) {
+        return;
+    }
+    Pairing_Node *node = run->elements[pick];
+    int64_t higher = node->key + 5 * 16384;
+    void *tag;
+    ck_assert(delete_node_fib_heap_key(run->reference, run->ref_nodes[pick], NULL, &tag));
+    run->ref_nodes[pick] = insert_fib_heap_key(run->reference, higher, tag);
+    change_key_pairing_heap(run->b->heap, node, higher);
+}
+
+START_TEST(test_pairing_heap_matches_pointer_heap)
+{
+    Pairing_Heap *heap = create_pairing_heap();
+    ck_assert_ptr_nonnull(heap);
+    Diff_Binding b = {heap, pairing_size, unique_new_key, unique_lower_key, pairing_insert, pairing_get_min,
+                      pairing_extract_min, pairing_get_key, pairing_decrease_key, pairing_delete, pairing_extra};
+    run_differential(&b, 0);
+    destroy_pairing_heap(heap);
+}
+END_TEST
+
+START_TEST(test_radix_heap)
+{
+    ck_assert_ptr_null(create_radix_heap(16));
+
+    Radix_Heap *heap = create_radix_heap(64);
+    ck_assert_ptr_nonnull(heap);
+    uint64_t key;
+    ck_assert(!get_min_radix_heap(heap, &key, NULL));
+
+    Radix_Heap_Node *ten = insert_radix_heap(heap, 10, NULL);
+    Radix_Heap_Node *twenty = insert_radix_heap(heap, 20, NULL);
+    int tag = 0;
+    insert_radix_heap(heap, 5, &tag);
+    uint64_t more[] = {30, UINT64_MAX, 15};
+    ck_assert(insert_many_radix_heap(heap, more, 3));
+    ck_assert_uint_eq(heap->n, 6);
+
+    void *payload;
+    ck_assert(get_min_radix_heap(heap, &key, &payload));
+    ck_assert(key == 5);
+    ck_assert_ptr_eq(payload, &tag);
+    ck_assert(extract_min_radix_heap(heap, &key, &payload));
+    ck_assert(key == 5);
+    ck_assert_uint_eq(heap->last, 5);
+
+    // Keys below the last extracted minimum are rejected everywhere
+    ck_assert(!accepts_key_radix_heap(heap, 4));
+    ck_assert_ptr_null(insert_radix_heap(heap, 4, NULL));
+    uint64_t low[] = {6, 3};
+    ck_assert(!insert_many_radix_heap(heap, low, 2));
+    ck_assert_uint_eq(heap->n, 5); // Nothing of the batch went in
+    ck_assert(!decrease_key_radix_heap(heap, twenty, 4));
+    ck_assert(!decrease_key_radix_heap(heap, twenty, 21));
+    ck_assert(decrease_key_radix_heap(heap, twenty, 5)); // Equal to last is fine
+    ck_assert(delete_node_radix_heap(heap, ten, &key, NULL));
+    ck_assert(key == 10);
+    ck_assert(change_key_radix_heap(heap, twenty, 40));
+    ck_assert_ptr_eq(find_node_radix_heap_key(heap, 40), twenty);
+    ck_assert_ptr_null(find_node_radix_heap_key(heap, 10));
+    ck_assert_ptr_null(find_node_radix_heap_key(heap, 1));
+
+    // Meld needs every key of the source to be acceptable to the destination
+    Radix_Heap *other = create_radix_heap(64);
+    Radix_Heap *narrow = create_radix_heap(32);
+    ck_assert_ptr_nonnull(other);
+    ck_assert_ptr_nonnull(narrow);
+    Radix_Heap_Node *three = insert_radix_heap(other, 3, NULL);
+    ck_assert(!meld_radix_heap(heap, other));
+    ck_assert(change_key_radix_heap(other, three, 7));
+    insert_radix_heap(other, 50, NULL);
+    ck_assert(!meld_radix_heap(heap, narrow));
+    ck_assert(!meld_radix_heap(heap, heap));
+    ck_assert(meld_radix_heap(heap, other));
+    ck_assert_uint_eq(other->n, 0);
+    ck_assert_uint_eq(heap->n, 6);
+    ck_assert(decrease_key_radix_heap(heap, three, 6));
+
+    // 32-bit heaps stop at UINT32_MAX
+    ck_assert_ptr_null(insert_radix_heap(narrow, (uint64_t)UINT32_MAX + 1, NULL));
+    ck_assert_ptr_nonnull(insert_radix_heap(narrow, UINT32_MAX, NULL));
+    destroy_radix_heap(narrow);
+    destroy_radix_heap(other);
+
+    uint64_t out[8];
+    ck_assert_uint_eq(extract_min_many_radix_heap(heap, out, NULL, 8), 6);
+    ck_assert(out[0] == 6 && out[1] == 15 && out[2] == 30 && out[3] == 40 && out[4] == 50 && out[5] == UINT64_MAX);
+    ck_assert_uint_eq(heap->last, UINT64_MAX);
+    destroy_radix_heap(heap);
+}
+END_TEST
+
+// Radix heap binding: a monotone workload, as Dijkstra produces it, where new and decreased
+// keys never go below the last extracted minimum
+static size_t radix_size(const void *heap) {
+    return ((const Radix_Heap *)heap)->n;
+}
+
+static int64_t radix_new_key(const void *heap, uint64_t random, int64_t serial) {
+    const Radix_Heap *h = heap;
+    (void)serial;
+    uint64_t spread = h->key_bits == 32 ? 1u << 20 : (uint64_t)1 << 50;
+    return (int64_t)(h->last + (random >> 11) % spread);
+}
+
+static int64_t radix_lower_key(const void *heap, int64_t key, uint64_t random) {
+    uint64_t last = ((const Radix_Heap *)heap)->last;
+    (void)random;
+    return (int64_t)(last + ((uint64_t)key - last) / 2);
+}
+
+static void *radix_insert(void *heap, int64_t key, void *payload) {
+    return insert_radix_heap(heap, (uint64_t)key, payload);
+}
+
+static bool radix_get_min(void *heap, int64_t *key_out) {
+    uint64_t key;
+    bool found = get_min_radix_heap(heap, &key, NULL);
+    *key_out = (int64_t)key;
+    return found;
+}
+
+static bool radix_extract_min(void *heap, int64_t *key_out, void **payload_out) {
+    uint64_t key;
+    bool found = extract_min_radix_heap(heap, &key, payload_out);
+    *key_out = (int64_t)key;
+    return found;
+}
+
+static int64_t radix_get_key(const void *heap, const void *element) {
+    (void)heap;
+    return (int64_t)((const Radix_Heap_Node *)element)->key;
+}
+
+static bool radix_decrease_key(void *heap, void *element, int64_t new_key) {
+    return decrease_key_radix_heap(heap, element, (uint64_t)new_key);
+}
+
+static bool radix_delete(void *heap, void *element) {
+    return delete_node_radix_heap(heap, element, NULL, NULL);
+}
+
+START_TEST(test_radix_heap_matches_pointer_heap)
+{
+    static const unsigned widths[] = {32, 64};
+    for (size_t w = 0; w < 2; w++) {
+        Radix_Heap *heap = create_radix_heap(widths[w]);
+        ck_assert_ptr_nonnull(heap);
+        Diff_Binding b = {heap, radix_size, radix_new_key, radix_lower_key, radix_insert, radix_get_min,
+                          radix_extract_min, radix_get_key, radix_decrease_key, radix_delete, NULL};
+        run_differential(&b, w);
+        destroy_radix_heap(heap);
+    }
+}
+END_TEST
+
+START_TEST(test_bucket_queue)
+{
+    ck_assert_ptr_null(create_bucket_queue(0, 0, false));
+    ck_assert_ptr_null(create_bucket_queue(0, BUCKET_QUEUE_MAX_RANGE + 1, false));
+    ck_assert_ptr_null(create_bucket_queue(INT64_MAX, 2, false));
+
+    // Fixed mode: keys 0..1023 in any order, the minimum found through the bitmap
+    Bucket_Queue *queue = create_bucket_queue(0, 1024, false);
+    ck_assert_ptr_nonnull(queue);
+    int64_t key;
+    ck_assert(!get_min_bucket_queue(queue, &key, NULL));
+    Bucket_Queue_Node *high = insert_bucket_queue(queue, 1000, NULL);
+    Bucket_Queue_Node *mid = insert_bucket_queue(queue, 500, NULL);
+    int tag = 0;
+    insert_bucket_queue(queue, 700, &tag);
+    ck_assert_ptr_null(insert_bucket_queue(queue, 1024, NULL));
+    ck_assert_ptr_null(insert_bucket_queue(queue, -1, NULL));
+    int64_t batch[] = {3, 3, 2000};
+    ck_assert(!insert_many_bucket_queue(queue, batch, 3));
+    ck_assert(insert_many_bucket_queue(queue, batch, 2));
+    ck_assert_uint_eq(queue->n, 5);
+
+    void *payload;
+    ck_assert(extract_min_bucket_queue(queue, &key, NULL));
+    ck_assert(key == 3);
+    ck_assert(extract_min_bucket_queue(queue, &key, NULL));
+    ck_assert(key == 3);
+    ck_assert(decrease_key_bucket_queue(queue, high, 1)); // Below the last minimum is fine here
+    ck_assert(!decrease_key_bucket_queue(queue, high, 2));
+    ck_assert(get_min_bucket_queue(queue, &key, NULL));
+    ck_assert(key == 1);
+    ck_assert(change_key_bucket_queue(queue, high, 900));
+    ck_assert(!change_key_bucket_queue(queue, high, 5000));
+    ck_assert(delete_node_bucket_queue(queue, mid, &key, NULL));
+    ck_assert(key == 500);
+    ck_assert_ptr_eq(find_node_bucket_queue_key(queue, 900), high);
+    ck_assert_ptr_null(find_node_bucket_queue_key(queue, 500));
+    ck_assert_ptr_null(find_node_bucket_queue_key(queue, 99999));
+    ck_assert(get_min_bucket_queue(queue, &key, &payload));
+    ck_assert(key == 700);
+    ck_assert_ptr_eq(payload, &tag);
+
+    // Meld needs the same geometry
+    Bucket_Queue *other = create_bucket_queue(0, 1024, false);
+    Bucket_Queue *wider = create_bucket_queue(0, 2048, false);
+    ck_assert_ptr_nonnull(other);
+    ck_assert_ptr_nonnull(wider);
+    Bucket_Queue_Node *forty = insert_bucket_queue(other, 40, NULL);
+    insert_bucket_queue(other, 900, NULL);
+    ck_assert(!meld_bucket_queue(queue, wider));
+    ck_assert(!meld_bucket_queue(queue, queue));
+    ck_assert(meld_bucket_queue(queue, other));
+    ck_assert_uint_eq(other->n, 0);
+    ck_assert(decrease_key_bucket_queue(queue, forty, 4));
+    int64_t out[8];
+    ck_assert_uint_eq(extract_min_many_bucket_queue(queue, out, NULL, 8), 4);
+    ck_assert(out[0] == 4 && out[1] == 700 && out[2] == 900 && out[3] == 900);
+    destroy_bucket_queue(other);
+    destroy_bucket_queue(wider);
+    destroy_bucket_queue(queue);
+
+    // Meld into an empty queue: the minimum is the smallest key, not the last bucket spliced
+    Bucket_Queue *empty = create_bucket_queue(0, 16, false);
+    other = create_bucket_queue(0, 16, false);
+    int64_t spread[] = {1, 5, 9};
+    ck_assert(insert_many_bucket_queue(other, spread, 3));
+    ck_assert(meld_bucket_queue(empty, other));
+    ck_assert_uint_eq(extract_min_many_bucket_queue(empty, out, NULL, 8), 3);
+    ck_assert(out[0] == 1 && out[1] == 5 && out[2] == 9);
+    destroy_bucket_queue(other);
+    destroy_bucket_queue(empty);
+
+    // Circular mode: the window follows the last extracted minimum around the buckets
+    Bucket_Queue *dial = create_bucket_queue(0, 100, true);
+    ck_assert_ptr_nonnull(dial);
+    ck_assert_ptr_null(insert_bucket_queue(dial, 100, NULL));
+    insert_bucket_queue(dial, 90, NULL);
+    ck_assert(extract_min_bucket_queue(dial, &key, NULL));
+    ck_assert(key == 90);
+    ck_assert_ptr_null(insert_bucket_queue(dial, 89, NULL));
+    ck_assert_ptr_nonnull(insert_bucket_queue(dial, 189, NULL)); // Same bucket as 89
+    ck_assert_ptr_nonnull(insert_bucket_queue(dial, 120, NULL));
+    ck_assert_ptr_null(insert_bucket_queue(dial, 190, NULL));
+    ck_assert(extract_min_bucket_queue(dial, &key, NULL));
+    ck_assert(key == 120);
+    ck_assert(extract_min_bucket_queue(dial, &key, NULL));
+    ck_assert(key == 189);
+    destroy_bucket_queue(dial);
+
+    // Circular meld into an empty queue: buckets 20, 50 and 89 hold 120, 150 and 189
+    dial = create_bucket_queue(0, 100, true);
+    Bucket_Queue *ring = create_bucket_queue(0, 100, true);
+    insert_bucket_queue(dial, 90, NULL);
+    insert_bucket_queue(ring, 90, NULL);
+    ck_assert(extract_min_bucket_queue(dial, &key, NULL));
+    ck_assert(extract_min_bucket_queue(ring, &key, NULL));
+    int64_t wrapped[] = {189, 120, 150};
+    ck_assert(insert_many_bucket_queue(ring, wrapped, 3));
+    ck_assert(meld_bucket_queue(dial, ring));
+    ck_assert(extract_min_bucket_queue(dial, &key, NULL));
+    ck_assert(key == 120);
+    destroy_bucket_queue(ring);
+    destroy_bucket_queue(dial);
+}
+END_TEST
+
+// Bucket queue binding: keys anywhere in the window, which in circular mode starts at the
+// last extracted minimum, as with Dijkstra
+static size_t bucket_size(const void *heap) {
+    return ((const Bucket_Queue *)heap)->n;
+}
+
+static int64_t bucket_low(const Bucket_Queue *q) {
+    return q->circular ? q->last : q->min_key;
+}
+
+static int64_t bucket_new_key(const void *heap, uint64_t random, int64_t serial) {
+    const Bucket_Queue *q = heap;
+    (void)serial;
+    return bucket_low(q) + (int64_t)((random >> 11) % q->range);
+}
+
+static int64_t bucket_lower_key(const void *heap, int64_t key, uint64_t random) {
+    int64_t low = bucket_low(heap);
+    (void)random;
+    return low + (key - low) / 2;
+}
+
+static void *bucket_insert(void *heap, int64_t key, void *payload) {
+    return insert_bucket_queue(heap, key, payload);
+}
+
+static bool bucket_get_min(void *heap, int64_t *key_out) {
+    return get_min_bucket_queue(heap, key_out, NULL);
+}
+
+static bool bucket_extract_min(void *heap, int64_t *key_out, void **payload_out) {
+    return extract_min_bucket_queue(heap, key_out, payload_out);
+}
+
+static int64_t bucket_get_key(const void *heap, const void *element) {
+    (void)heap;
+    return ((const Bucket_Queue_Node *)element)->key;
+}
+
+static bool bucket_decrease_key(void *heap, void *element, int64_t new_key) {
+    return decrease_key_bucket_queue(heap, element, new_key);
+}
+
+static bool bucket_delete(void *heap, void *element) {
+    return delete_node_bucket_queue(heap, element, NULL, NULL);
+}
+
+START_TEST(test_bucket_queue_matches_pointer_heap)
+{
+    // Fixed mode with keys in any order, then circular mode with Dijkstra-like keys
+    for (int circular = 0; circular < 2; circular++) {
+        Bucket_Queue *queue = create_bucket_queue(circular ? 0 : -500, circular ? 256 : 1000, circular);
+        ck_assert_ptr_nonnull(queue);
+        Diff_Binding b = {queue, bucket_size, bucket_new_key, bucket_lower_key, bucket_insert, bucket_get_min,
+                          bucket_extract_min, bucket_get_key, bucket_decrease_key, bucket_delete, NULL};
+        run_differential(&b, (uint64_t)circular);
+        destroy_bucket_queue(queue);
+    }
+}
+END_TEST
+
+START_TEST(test_multi_queue)
+{
+    ck_assert_ptr_null(create_multi_queue(0, 2));
+    Multi_Queue *mq = create_multi_queue(2, 2);
+    ck_assert_ptr_nonnull(mq);
+    ck_assert_uint_eq(mq->count, 4);
+    int64_t key;
+    ck_assert(!extract_min_multi_queue(mq, &key, NULL));
+
+    // Keys 0 .. N-1, one by one and in batches
+    enum { N = 4000 };
+    static int64_t keys[N / 2];
+    static bool present[N];
+    for (int i = 0; i < N / 2; i++) {
+        ck_assert(insert_multi_queue(mq, (int64_t)(2 * i), NULL));
+        keys[i] = 2 * i + 1;
+    }
+    ck_assert(insert_many_multi_queue(mq, keys, N / 2));
+    ck_assert_uint_eq(size_multi_queue(mq), N);
+    for (int i = 0; i < N; i++) {
+        present[i] = true;
+    }
+
+    // Every key comes out once; its rank error is how many smaller keys are still in
+    long total_error = 0;
+    for (int i = 0; i < N; i++) {
+        ck_assert(extract_min_multi_queue(mq, &key, NULL));
+        ck_assert(key >= 0 && key < N && present[key]);
+        present[key] = false;
+        for (int64_t smaller = 0; smaller < key; smaller++) {
+            total_error += present[smaller];
+        }
+    }
+    ck_assert(!extract_min_multi_queue(mq, &key, NULL));
+    ck_assert_uint_eq(size_multi_queue(mq), 0);
+    ck_assert_msg(total_error < 4L * (long)mq->count * N, "mean rank error %ld is too large", total_error / N);
+
+    // extract_min_many hands payloads over or frees them
+    for (int i = 0; i < 10; i++) {
+        ck_assert(insert_multi_queue(mq, i, create_int_ptr(i)));
+    }
+    int64_t out[10];
+    void *payloads[10];
+    ck_assert_uint_eq(extract_min_many_multi_queue(mq, out, payloads, 4), 4);
+    for (int i = 0; i < 4; i++) {
+        ck_assert_int_eq(*(int *)payloads[i], (int)out[i]);
+        free(payloads[i]);
+    }
+    mq->free_payload = free;
+    ck_assert_uint_eq(extract_min_many_multi_queue(mq, out, NULL, 3), 3);
+    destroy_multi_queue(mq); // Frees the remaining three
+}
+END_TEST
+
+typedef struct {
+    Multi_Queue *mq;
+    int64_t first;
+    long extracted;
+    int64_t sum;
+} Multi_Queue_Worker;
+
+// Inserts 20000 keys from 'first' on, extracting one after every second insert
+static void *multi_queue_worker(void *arg) {
+    Multi_Queue_Worker *w = (Multi_Queue_Worker *)arg;
+    for (int64_t i = 0; i < 20000; i++) {
+        ck_assert(insert_multi_queue(w->mq, w->first + i, NULL));
+        int64_t key;
+        if (i % 2 == 1 && extract_min_multi_queue(w->mq, &key, NULL)) {
+            w->extracted++;
+            w->sum += key;
+        }
+    }
+    return NULL;
+}
+
+START_TEST(test_multi_queue_threads)
+{
+    enum { THREADS = 4 };
+    Multi_Queue *mq = create_multi_queue(THREADS, 2);
+    ck_assert_ptr_nonnull(mq);
+    pthread_t threads[THREADS];
+    Multi_Queue_Worker workers[THREADS];
+    for (int t = 0; t < THREADS; t++) {
+        workers[t] = (Multi_Queue_Worker){mq, (int64_t)t * 20000, 0, 0};
+        ck_assert_int_eq(pthread_create(&threads[t], NULL, multi_queue_worker, &workers[t]), 0);
+    }
+    long extracted = 0;
+    int64_t sum = 0;
+    for (int t = 0; t < THREADS; t++) {
+        ck_assert_int_eq(pthread_join(threads[t], NULL), 0);
+        extracted += workers[t].extracted;
+        sum += workers[t].sum;
+    }
+
+    // Nothing was lost or duplicated: what is left plus what came out is what went in
+    int64_t key;
+    ck_assert_uint_eq(size_multi_queue(mq), (size_t)(THREADS * 20000 - extracted));
+    while (extract_min_multi_queue(mq, &key, NULL)) {
+        extracted++;
+        sum += key;
+    }
+    ck_assert_int_eq(extracted, THREADS * 20000);
+    ck_assert(sum == (int64_t)THREADS * 20000 * (THREADS * 20000 - 1) / 2);
+    destroy_multi_queue(mq);
+}
+END_TEST
+
 // Function to create the test suite
 Suite *fib_heap_suite(void)
 {
@@ -594,6 +2635,37 @@ Suite *fib_heap_suite(void)
     tcase_add_test(tc_core, test_extract_min);
     tcase_add_test(tc_core, test_decrease_key);
     tcase_add_test(tc_core, test_delete_node); // Added test_delete_node
+    tcase_add_test(tc_core, test_key_api);
+    tcase_add_test(tc_core, test_free_payload);
+    tcase_add_test(tc_core, test_node_pool);
+    tcase_add_test(tc_core, test_custom_compare);
+    tcase_add_test(tc_core, test_delete_without_sentinel);
+    tcase_add_test(tc_core, test_key_index);
+    tcase_add_test(tc_core, test_meld);
+    tcase_add_test(tc_core, test_insert_many);
+    tcase_add_test(tc_core, test_extract_min_many);
+    tcase_add_test(tc_core, test_degree_table);
+    tcase_add_test(tc_core, test_consolidate_budget);
+    tcase_add_test(tc_core, test_consolidate_budget_matches_lazy_heap);
+    tcase_add_test(tc_core, test_insert_buffers);
+    tcase_add_test(tc_core, test_insert_buffers_threads);
+    tcase_add_test(tc_core, test_build_parallel);
+    tcase_add_test(tc_core, test_dijkstra);
+    tcase_add_test(tc_core, test_prim);
+    tcase_add_test(tc_core, test_astar);
+    tcase_add_test(tc_core, test_heap_select);
+    tcase_add_test(tc_core, test_compact_heap);
+    tcase_add_test(tc_core, test_compact_heap_matches_pointer_heap);
+    tcase_add_test(tc_core, test_dary_heap);
+    tcase_add_test(tc_core, test_dary_heap_matches_pointer_heap);
+    tcase_add_test(tc_core, test_pairing_heap);
+    tcase_add_test(tc_core, test_pairing_heap_matches_pointer_heap);
+    tcase_add_test(tc_core, test_radix_heap);
+    tcase_add_test(tc_core, test_radix_heap_matches_pointer_heap);
+    tcase_add_test(tc_core, test_bucket_queue);
+    tcase_add_test(tc_core, test_bucket_queue_matches_pointer_heap);
+    tcase_add_test(tc_core, test_multi_queue);
+    tcase_add_test(tc_core, test_multi_queue_threads);
     suite_add_tcase(s, tc_core);
 
     // Test case for get_min
@@ -1,3 +1,12 @@
+import array
+import ctypes
+import heapq
+import importlib.util
+import os
+import random
+import sys
+import sysconfig
+import threading
 import unittest
 import fibheap # This will import the compiled C extension
 
@@ -236,5 +245,1158 @@ class TestFibHeap(unittest.TestCase):
         h.extract_min()
         self.assertEqual(len(h), 0)
 
+    def test_64bit_keys(self):
+        h = fibheap.FibHeap()
+        big = 2**40
+        h.insert(big)
+        h.insert(-2**62)
+        h.insert(7)
+        self.assertEqual(h.get_min(), -2**62)
+        h.update_key(big, -big)
+        self.assertEqual([h.extract_min() for _ in range(3)], [-2**62, -big, 7])
+        with self.assertRaises(OverflowError):
+            h.insert(2**63)
+
+    # Handle-based operations
+
+    def test_insert_returns_handle(self):
+        h = fibheap.FibHeap()
+        handle = h.insert(10)
+        self.assertIsInstance(handle, fibheap.Handle)
+        self.assertTrue(handle.valid)
+        self.assertEqual(handle.key, 10)
+        self.assertEqual(h.extract_min(), 10)
+        self.assertFalse(handle.valid)
+        self.assertIsNone(handle.key)
+
+    def test_decrease_key_handle(self):
+        h = fibheap.FibHeap()
+        handles = {v: h.insert(v) for v in [10, 20, 5, 30, 25]}
+        self.assertEqual(h.extract_min(), 5)  # Consolidates into trees
+        h.decrease_key(handles[30], 1)
+        self.assertEqual(handles[30].key, 1)
+        self.assertEqual(h.get_min(), 1)
+        with self.assertRaises(ValueError):
+            h.decrease_key(handles[20], 21)
+        self.assertEqual([h.extract_min() for _ in range(4)], [1, 10, 20, 25])
+
+    def test_delete_handle(self):
+        h = fibheap.FibHeap()
+        a = h.insert(7)
+        b = h.insert(7)
+        h.insert(3)
+        h.delete(b)
+        self.assertFalse(b.valid)
+        self.assertTrue(a.valid)
+        self.assertEqual(len(h), 2)
+        with self.assertRaises(ValueError):
+            h.delete(b)
+        self.assertEqual([h.extract_min(), h.extract_min()], [3, 7])
+        self.assertFalse(a.valid)
+
+    def test_handle_from_other_heap(self):
+        h1 = fibheap.FibHeap()
+        h2 = fibheap.FibHeap()
+        handle = h1.insert(4)
+        with self.assertRaises(ValueError):
+            h2.decrease_key(handle, 1)
+        with self.assertRaises(ValueError):
+            h2.delete(handle)
+        self.assertEqual(h1.get_min(), 4)
+
+    def test_handle_follows_update_key(self):
+        h = fibheap.FibHeap()
+        handle = h.insert(10)
+        h.insert(20)
+        h.update_key(10, 30)  # Increase keeps the same element
+        self.assertTrue(handle.valid)
+        self.assertEqual(handle.key, 30)
+        h.decrease_key(handle, 0)
+        self.assertEqual(h.get_min(), 0)
+
+    def test_handle_outlives_heap(self):
+        h = fibheap.FibHeap()
+        handle = h.insert(1)
+        del h
+        self.assertFalse(handle.valid)
+
+    def test_contains(self):
+        for use_index in (True, False):
+            h = fibheap.FibHeap(index=use_index)
+            for v in (5, 1, 5, 9):
+                h.insert(v)
+            self.assertIn(5, h)
+            self.assertNotIn(2, h)
+            self.assertNotIn("5", h)
+            self.assertNotIn(2**70, h)
+            h.delete(5)
+            self.assertIn(5, h)  # The duplicate is still there
+            h.delete(5)
+            self.assertNotIn(5, h)
+            h.update_key(9, 2)
+            self.assertIn(2, h)
+            self.assertNotIn(9, h)
+            self.assertEqual(h.extract_min(), 1)
+            self.assertNotIn(1, h)
+
+    def test_value_ops_on_large_heap(self):
+        h = fibheap.FibHeap()
+        for v in range(20000):
+            h.insert(v)
+        h.extract_min()
+        for v in range(1, 20000, 2):
+            h.delete(v)
+        for v in range(2, 20000, 4):
+            h.update_key(v, -v)
+        self.assertEqual(len(h), 9999)
+        self.assertEqual(h.get_min(), -19998)
+        self.assertNotIn(3, h)
+
+    def test_meld(self):
+        a = fibheap.FibHeap()
+        b = fibheap.FibHeap(index=False)
+        for v in (5, 3, 9):
+            a.insert(v)
+        for v in (4, 1, 8):
+            b.insert(v)
+        a.meld(b)
+        self.assertEqual(len(a), 6)
+        self.assertEqual(len(b), 0)
+        self.assertIsNone(b.get_min())
+        self.assertIn(8, a)
+        self.assertEqual([a.extract_min() for _ in range(6)], [1, 3, 4, 5, 8, 9])
+        b.insert(2)  # The emptied heap is still usable
+        self.assertEqual(b.get_min(), 2)
+
+    def test_meld_moves_handles(self):
+        a = fibheap.FibHeap()
+        b = fibheap.FibHeap()
+        c = fibheap.FibHeap()
+        hb = b.insert(20)
+        hc = c.insert(30)
+        b.meld(c)
+        a |= b
+        self.assertEqual(len(a), 2)
+        a.decrease_key(hb, 1)
+        a.decrease_key(hc, 0)
+        self.assertEqual(a.get_min(), 0)
+        with self.assertRaises(ValueError):
+            b.delete(hb)
+        with self.assertRaises(ValueError):
+            c.delete(hc)
+        # Handles inserted after the meld belong to the melded-from heap again
+        hb2 = b.insert(7)
+        with self.assertRaises(ValueError):
+            a.delete(hb2)
+        b.delete(hb2)
+        a.delete(hb)
+        self.assertFalse(hb.valid)
+        del a
+        self.assertFalse(hc.valid)
+
+    def test_meld_errors(self):
+        h = fibheap.FibHeap()
+        h.insert(1)
+        with self.assertRaises(ValueError):
+            h.meld(h)
+        with self.assertRaises(TypeError):
+            h.meld([1, 2])
+        with self.assertRaises(TypeError):
+            h |= 3
+        self.assertEqual(len(h), 1)
+
+    def test_insert_many(self):
+        h = fibheap.FibHeap()
+        h.insert(50)
+        self.assertIsNone(h.insert_many([7, 3, 9]))
+        h.insert_many(x for x in (8, 1))
+        h.insert_many([])
+        self.assertEqual(len(h), 6)
+        self.assertIn(9, h)
+        h.delete(9)
+        self.assertEqual([h.extract_min() for _ in range(5)], [1, 3, 7, 8, 50])
+
+    def test_insert_many_buffer(self):
+        for typecode in ('q', 'l', 'i', 'h', 'b', 'B', 'I', 'Q'):
+            h = fibheap.FibHeap()
+            values = [5, 0, 3, 100, 2] if typecode in 'BIQ' else [5, -1, 3, 100, -2]
+            h.insert_many(array.array(typecode, values))
+            self.assertEqual([h.extract_min() for _ in values], sorted(values), typecode)
+        h = fibheap.FibHeap()
+        h.insert_many(memoryview(array.array('q', [2**62, -2**63])))
+        self.assertEqual(h.extract_min(), -2**63)
+        h.insert_many(b"\x03\x01")
+        self.assertEqual(h.extract_min(), 1)
+
+    def test_insert_many_standard_sizes(self):
+        # ctypes exports '<h', '<i', '<q', ...: each item is read at the buffer's own width
+        for ctype in (ctypes.c_int8, ctypes.c_int16, ctypes.c_int32, ctypes.c_int64, ctypes.c_uint32):
+            values = [5, 0, 3, 100, 2] if ctype is ctypes.c_uint32 else [5, -1, 3, 100, -2]
+            buf = (ctype * len(values))(*values)
+            h = fibheap.FibHeap()
+            h.insert_many(buf)
+            self.assertEqual(list(h.pop_n(10)), sorted(values), memoryview(buf).format)
+            t = fibheap.TopK(2, largest=False)
+            t.insert_many(buf)
+            self.assertEqual(list(t.result()), sorted(values)[:2])
+        with self.assertRaises(TypeError):  # Not in native byte order
+            fibheap.FibHeap().insert_many((ctypes.c_int32.__ctype_be__ * 2)())
+
+    def test_insert_many_errors(self):
+        h = fibheap.FibHeap()
+        h.insert(1)
+        with self.assertRaises(TypeError):
+            h.insert_many(array.array('d', [1.5]))
+        with self.assertRaises(OverflowError):
+            h.insert_many(array.array('Q', [2**64 - 1]))
+        with self.assertRaises(OverflowError):
+            h.insert_many([1, 2**64])
+        with self.assertRaises(TypeError):
+            h.insert_many([1, "2"])
+        with self.assertRaises(TypeError):
+            h.insert_many(5)
+        self.assertEqual(len(h), 1)  # Nothing was inserted by the failed calls
+
+    def test_insert_many_large(self):
+        h = fibheap.FibHeap()
+        n = 100000
+        h.insert_many(array.array('q', range(n, 0, -1)))
+        h.insert_many(range(n + 1, n + 70001))  # Larger than a pool chunk
+        self.assertEqual(len(h), n + 70000)
+        h.delete(n)
+        out = [h.extract_min() for _ in range(1000)]
+        self.assertEqual(out, list(range(1, 1001)))
+
+    def test_pop_n(self):
+        h = fibheap.FibHeap()
+        h.insert_many([9, 4, 7, 1, 8])
+        handle = h.insert(2)
+        popped = h.pop_n(3)
+        self.assertIsInstance(popped, array.array)
+        self.assertEqual(popped.typecode, 'q')
+        self.assertEqual(list(popped), [1, 2, 4])
+        self.assertFalse(handle.valid)
+        self.assertEqual(len(h), 3)
+        self.assertEqual(list(h.extract_min_many(10)), [7, 8, 9])
+        self.assertEqual(len(h.pop_n(5)), 0)
+        self.assertEqual(len(h.pop_n(0)), 0)
+
+    def test_pop_n_into_buffer(self):
+        h = fibheap.FibHeap()
+        h.insert_many(range(100, 0, -1))
+        out = array.array('q', [0] * 10)
+        self.assertEqual(h.pop_n(4, out=out), 4)
+        self.assertEqual(list(out[:4]), [1, 2, 3, 4])
+        self.assertEqual(list(out[4:]), [0] * 6)
+        view = memoryview(out)[5:]
+        self.assertEqual(h.pop_n(5, view), 5)
+        self.assertEqual(list(out[5:]), [5, 6, 7, 8, 9])
+        self.assertEqual(len(h), 91)
+        big = array.array('q', [0] * 200)
+        self.assertEqual(h.pop_n(200, big), 91)
+
+    def test_pop_n_errors(self):
+        h = fibheap.FibHeap()
+        h.insert_many([3, 1, 2])
+        with self.assertRaises(ValueError):
+            h.pop_n(-1)
+        with self.assertRaises(ValueError):
+            h.pop_n(5, array.array('q', [0] * 4))
+        with self.assertRaises(TypeError):
+            h.pop_n(1, array.array('i', [0]))
+        with self.assertRaises(BufferError):
+            h.pop_n(1, b"12345678")  # Not writable
+        self.assertEqual(len(h), 3)
+
+    def test_consolidate_budget(self):
+        with self.assertRaises(ValueError):
+            fibheap.FibHeap(consolidate_budget=-1)
+        h = fibheap.FibHeap(consolidate_budget=2)
+        keys = [(i * 7919) % 5000 for i in range(5000)]
+        handles = [h.insert(k) for k in keys]
+        h.insert_many(range(5000, 5100))
+        h.decrease_key(handles[keys.index(4999)], -1)
+        h.delete(2500)
+        h.update_key(10, 6000)
+        other = fibheap.FibHeap()
+        other.insert_many([-5, 7000])
+        h.meld(other)
+        self.assertEqual(len(h), 5101)
+        expected = sorted([k for k in keys if k not in (4999, 2500, 10)] + [-1, 6000, -5, 7000]
+                          + list(range(5000, 5100)))
+        self.assertEqual([h.extract_min() for _ in range(len(h))], expected)
+
+
+    def test_from_array(self):
+        keys = array.array('q', ((i * 7919) % 100003 - 50000 for i in range(100003)))
+        for threads in (1, 4, None):
+            h = fibheap.FibHeap.from_array(keys, threads=threads)
+            self.assertEqual(len(h), len(keys))
+            self.assertIn(keys[17], h)  # Indexed like FibHeap() by default
+            self.assertEqual(list(h.pop_n(len(keys))), sorted(keys))
+        h = fibheap.FibHeap.from_array([5, 3, 9], threads=2, index=False, consolidate_budget=2)
+        self.assertEqual([h.extract_min() for _ in range(3)], [3, 5, 9])
+        self.assertEqual(len(fibheap.FibHeap.from_array([])), 0)
+        d = fibheap.DaryHeap.from_array(keys, threads=4, arity=8)  # Other classes build serially
+        self.assertEqual(list(d.pop_n(len(keys))), sorted(keys))
+        self.assertRaises(ValueError, fibheap.RadixHeap.from_array, [-1])
+        self.assertRaises(TypeError, fibheap.FibHeap.from_array, [1], arity=2)
+
+        class Sub(fibheap.FibHeap):
+            pass
+        self.assertIsInstance(Sub.from_array(range(10)), Sub)
+        self.assertRaises(ValueError, fibheap.FibHeap.from_array, [1], threads=0)
+        self.assertRaises(OverflowError, fibheap.FibHeap.from_array, [2 ** 64])
+
+class TestDaryHeap(unittest.TestCase):
+
+    def test_create(self):
+        self.assertEqual(len(fibheap.DaryHeap()), 0)
+        self.assertEqual(len(fibheap.DaryHeap(arity=8)), 0)
+        with self.assertRaises(ValueError):
+            fibheap.DaryHeap(arity=1)
+        with self.assertRaises(ValueError):
+            fibheap.DaryHeap(arity=65)
+        self.assertIn("DaryHeap", repr(fibheap.DaryHeap()))
+
+    def test_same_interface_as_fibheap(self):
+        public = lambda cls: {name for name in dir(cls) if not name.startswith('_')}
+        self.assertEqual(public(fibheap.DaryHeap), public(fibheap.FibHeap))
+
+    def test_matches_fibheap(self):
+        import random
+        rng = random.Random(7)
+        for arity in (2, 4, 8):
+            d, f = fibheap.DaryHeap(arity), fibheap.FibHeap()
+            for _ in range(3000):
+                if rng.random() < 0.6:
+                    value = rng.randrange(-1000, 1000)
+                    d.insert(value)
+                    f.insert(value)
+                else:
+                    self.assertEqual(d.extract_min(), f.extract_min())
+                self.assertEqual(len(d), len(f))
+                self.assertEqual(d.get_min(), f.get_min())
+
+    def test_handles(self):
+        h = fibheap.DaryHeap()
+        handles = [h.insert(v) for v in (50, 40, 30, 20)]
+        h.decrease_key(handles[0], 5)
+        self.assertEqual(handles[0].key, 5)
+        self.assertEqual(h.get_min(), 5)
+        with self.assertRaises(ValueError):
+            h.decrease_key(handles[0], 6)
+        h.delete(handles[1])
+        self.assertFalse(handles[1].valid)
+        with self.assertRaises(ValueError):
+            h.delete(handles[1])
+        self.assertEqual(h.extract_min(), 5)
+        self.assertFalse(handles[0].valid)
+        self.assertEqual(handles[3].key, 20)  # Entries move around the array; handles follow
+
+    def test_value_ops(self):
+        h = fibheap.DaryHeap()
+        h.insert_many([5, 3, 9])
+        self.assertIn(9, h)
+        self.assertNotIn(4, h)
+        h.update_key(9, 1)
+        self.assertEqual(h.get_min(), 1)
+        h.update_key(1, 10)
+        self.assertEqual(h.get_min(), 3)
+        h.delete(3)
+        with self.assertRaisesRegex(RuntimeError, "Failed to delete from d-ary heap"):
+            h.delete(3)
+        self.assertEqual(list(h.pop_n(10)), [5, 10])
+
+    def test_meld(self):
+        a, b = fibheap.DaryHeap(), fibheap.DaryHeap(arity=2)
+        a.insert_many(range(0, 100, 2))
+        hb = b.insert(51)
+        b.insert_many(range(1, 100, 2))
+        a |= b
+        self.assertEqual(len(a), 101)
+        self.assertEqual(len(b), 0)
+        a.decrease_key(hb, -1)
+        with self.assertRaises(ValueError):
+            b.delete(hb)
+        self.assertEqual(list(a.pop_n(4)), [-1, 0, 1, 2])
+        with self.assertRaises(TypeError):
+            a.meld(fibheap.FibHeap())
+        with self.assertRaises(ValueError):
+            a.meld(a)
+
+    def test_pop_n_into_buffer(self):
+        h = fibheap.DaryHeap()
+        h.insert_many(array.array('i', range(100, 0, -1)))
+        out = array.array('q', [0] * 8)
+        self.assertEqual(h.pop_n(8, out), 8)
+        self.assertEqual(list(out), list(range(1, 9)))
+
+
+class TestPairingHeap(unittest.TestCase):
+
+    def test_same_interface_as_fibheap(self):
+        public = lambda cls: {name for name in dir(cls) if not name.startswith('_')}
+        self.assertEqual(public(fibheap.PairingHeap), public(fibheap.FibHeap))
+        self.assertIn("PairingHeap", repr(fibheap.PairingHeap()))
+        with self.assertRaises(TypeError):
+            fibheap.PairingHeap(4)
+
+    def test_matches_fibheap(self):
+        import random
+        rng = random.Random(11)
+        p, f = fibheap.PairingHeap(), fibheap.FibHeap()
+        handles = []
+        for _ in range(5000):
+            r = rng.random()
+            if r < 0.5:
+                value = rng.randrange(-1000, 1000)
+                handles.append((p.insert(value), f.insert(value)))
+            elif r < 0.7 and handles:
+                hp, hf = handles[rng.randrange(len(handles))]
+                if hp.valid and hf.valid and hp.key == hf.key:
+                    p.decrease_key(hp, hp.key - 50)
+                    f.decrease_key(hf, hf.key - 50)
+            else:
+                self.assertEqual(p.extract_min(), f.extract_min())
+            self.assertEqual(len(p), len(f))
+            self.assertEqual(p.get_min(), f.get_min())
+
+    def test_value_ops_and_handles(self):
+        h = fibheap.PairingHeap()
+        h.insert_many([5, 3, 9])
+        handle = h.insert(7)
+        self.assertIn(9, h)
+        self.assertNotIn(4, h)
+        h.update_key(9, 1)
+        h.update_key(3, 10)
+        self.assertEqual(h.get_min(), 1)
+        h.delete(handle)
+        self.assertFalse(handle.valid)
+        with self.assertRaisesRegex(RuntimeError, "Failed to delete from pairing heap"):
+            h.delete(7)
+        self.assertEqual(list(h.pop_n(10)), [1, 5, 10])
+
+    def test_meld(self):
+        a, b = fibheap.PairingHeap(), fibheap.PairingHeap()
+        a.insert_many(range(0, 100, 2))
+        hb = b.insert(51)
+        a |= b
+        self.assertEqual(len(a), 51)
+        self.assertEqual(len(b), 0)
+        a.decrease_key(hb, -1)
+        self.assertEqual(a.extract_min(), -1)
+        with self.assertRaises(TypeError):
+            a.meld(fibheap.DaryHeap())
+
+
+class TestRadixHeap(unittest.TestCase):
+
+    def test_same_interface_as_fibheap(self):
+        public = lambda cls: {name for name in dir(cls) if not name.startswith('_')}
+        self.assertEqual(public(fibheap.RadixHeap), public(fibheap.FibHeap))
+        with self.assertRaises(ValueError):
+            fibheap.RadixHeap(key_bits=16)
+
+    def test_monotone_keys(self):
+        h = fibheap.RadixHeap()
+        h.insert_many([10, 40, 20])
+        self.assertEqual(h.extract_min(), 10)
+        with self.assertRaisesRegex(ValueError, "below the last extracted minimum 10"):
+            h.insert(9)
+        with self.assertRaises(ValueError):
+            h.insert(-1)
+        with self.assertRaises(ValueError):
+            h.insert_many([30, 5])
+        self.assertEqual(len(h), 2)  # The rejected batch left nothing behind
+        h.insert(10)  # Equal to the last minimum is allowed
+        self.assertEqual(list(h.pop_n(5)), [10, 20, 40])
+
+    def test_key_bits(self):
+        h = fibheap.RadixHeap(key_bits=32)
+        h.insert(2**32 - 1)
+        with self.assertRaises(ValueError):
+            h.insert(2**32)
+        wide = fibheap.RadixHeap()
+        wide.insert(2**63 - 1)
+        self.assertEqual(wide.extract_min(), 2**63 - 1)
+
+    def test_decrease_key(self):
+        h = fibheap.RadixHeap()
+        h.insert(5)
+        handle = h.insert(100)
+        self.assertEqual(h.extract_min(), 5)
+        with self.assertRaises(ValueError):
+            h.decrease_key(handle, 4)  # Below the last minimum
+        with self.assertRaises(ValueError):
+            h.decrease_key(handle, 101)
+        h.decrease_key(handle, 6)
+        self.assertEqual(handle.key, 6)
+        h.update_key(6, 50)
+        self.assertIn(50, h)
+        self.assertNotIn(-3, h)
+        with self.assertRaises(ValueError):
+            h.update_key(50, 1)
+        self.assertEqual(h.extract_min(), 50)
+        self.assertFalse(handle.valid)
+
+    def test_dijkstra_pattern_matches_fibheap(self):
+        import random
+        rng = random.Random(3)
+        r, f = fibheap.RadixHeap(), fibheap.FibHeap()
+        last = 0
+        for _ in range(5000):
+            if rng.random() < 0.6:
+                key = last + rng.randrange(1000)
+                r.insert(key)
+                f.insert(key)
+            elif len(f):
+                last = f.extract_min()
+                self.assertEqual(r.extract_min(), last)
+            self.assertEqual(r.get_min(), f.get_min())
+
+    def test_meld(self):
+        a, b = fibheap.RadixHeap(), fibheap.RadixHeap()
+        a.insert_many([1, 2])
+        a.extract_min()
+        b.insert(0)
+        with self.assertRaises(ValueError):
+            a.meld(b)
+        b.update_key(0, 7)
+        hb = b.insert(3)
+        a |= b
+        self.assertEqual(len(a), 3)
+        a.decrease_key(hb, 2)
+        self.assertEqual(list(a.pop_n(3)), [2, 2, 7])
+        with self.assertRaises(ValueError):
+            a.meld(fibheap.RadixHeap(key_bits=32))
+
+
+class TestBucketQueue(unittest.TestCase):
+
+    def test_same_interface_as_fibheap(self):
+        public = lambda cls: {name for name in dir(cls) if not name.startswith('_')}
+        self.assertEqual(public(fibheap.BucketQueue), public(fibheap.FibHeap))
+        with self.assertRaises(TypeError):
+            fibheap.BucketQueue()
+        with self.assertRaises(ValueError):
+            fibheap.BucketQueue(0)
+        with self.assertRaises(ValueError):
+            fibheap.BucketQueue(10, min_key=2**63 - 5)
+
+    def test_fixed_range(self):
+        h = fibheap.BucketQueue(1024)
+        handle = h.insert(1000)
+        h.insert_many([5, 700, 5])
+        with self.assertRaisesRegex(ValueError, "outside the current window 0 .. 1023"):
+            h.insert(1024)
+        with self.assertRaises(ValueError):
+            h.insert_many([1, -1])
+        self.assertEqual(len(h), 4)
+        self.assertEqual(h.extract_min(), 5)
+        h.decrease_key(handle, 2)  # Fixed mode allows keys below the last minimum
+        self.assertEqual(h.get_min(), 2)
+        h.update_key(2, 800)
+        self.assertEqual(handle.key, 800)
+        self.assertIn(700, h)
+        self.assertNotIn(5000, h)
+        h.delete(700)
+        self.assertEqual(list(h.pop_n(5)), [5, 800])
+
+    def test_min_key(self):
+        h = fibheap.BucketQueue(11, min_key=-5)
+        h.insert_many(range(-5, 6))
+        with self.assertRaises(ValueError):
+            h.insert(-6)
+        self.assertEqual(list(h.pop_n(11)), list(range(-5, 6)))
+
+    def test_circular_window(self):
+        # Dial's algorithm: with edge weights below 10 every tentative distance lies within
+        # 10 of the last settled one, so 10 buckets are reused around the circle
+        h = fibheap.BucketQueue(10, circular=True)
+        h.insert_many([0, 3, 9])
+        with self.assertRaises(ValueError):
+            h.insert(12)  # Past the window 0 .. 9
+        self.assertEqual(h.extract_min(), 0)
+        self.assertEqual(h.extract_min(), 3)
+        handle = h.insert(12)  # Window is now 3 .. 12; 12 shares a bucket with 2
+        h.insert(11)
+        with self.assertRaisesRegex(ValueError, "window 3 .. 12"):
+            h.insert(2)
+        h.decrease_key(handle, 4)
+        self.assertEqual(list(h.pop_n(4)), [4, 9, 11])
+        with self.assertRaises(ValueError):
+            h.insert(10)  # Below the last minimum (11)
+
+    def test_meld(self):
+        a, b = fibheap.BucketQueue(100), fibheap.BucketQueue(100)
+        a.insert_many([10, 20])
+        hb = b.insert(50)
+        a |= b
+        self.assertEqual(len(a), 3)
+        a.decrease_key(hb, 1)
+        self.assertEqual(a.extract_min(), 1)
+        with self.assertRaises(ValueError):
+            a.meld(fibheap.BucketQueue(200))
+        # Into an empty queue, in both modes
+        for circular in (False, True):
+            a, b = fibheap.BucketQueue(16, circular=circular), fibheap.BucketQueue(16, circular=circular)
+            b.insert_many([1, 5, 9])
+            a.meld(b)
+            self.assertEqual([a.extract_min() for _ in range(3)], [1, 5, 9])
+
+class TestMultiQueue(unittest.TestCase):
+
+    def test_basic(self):
+        q = fibheap.MultiQueue(threads=2)
+        self.assertIsNone(q.extract_min())
+        self.assertEqual(len(q), 0)
+        self.assertIn("4 shards", repr(q))
+        for k in range(0, 1000, 2):
+            q.insert(k)
+        q.insert_many(array.array('q', range(1, 1000, 2)))
+        q.insert_many([-5, 2000])
+        self.assertEqual(len(q), 1002)
+        keys = [q.extract_min() for _ in range(2)] + list(q.pop_n(2000))
+        self.assertEqual(sorted(keys), [-5] + list(range(1000)) + [2000])
+        self.assertIsNone(q.extract_min())
+        self.assertEqual(len(q.pop_n(3)), 0)
+
+    def test_rank_error(self):
+        # Relaxed, but close to sorted: the mean rank error stays a small multiple of the shard count
+        q = fibheap.MultiQueue(threads=4, factor=2)
+        q.insert_many(range(20000))
+        out = q.pop_n(20000)
+        remaining = set(range(20000))
+        error = 0
+        low = 0
+        for key in out:
+            remaining.discard(key)
+            while low not in remaining and low < 20000:
+                low += 1
+            error += sum(1 for k in range(low, key) if k in remaining)
+        self.assertLess(error / 20000, 4 * 8)
+
+    def test_arguments(self):
+        self.assertRaises(ValueError, fibheap.MultiQueue, threads=0)
+        self.assertRaises(ValueError, fibheap.MultiQueue, factor=0)
+        self.assertRaises(ValueError, fibheap.MultiQueue().pop_n, -1)
+        self.assertRaises(OverflowError, fibheap.MultiQueue().insert, 2 ** 64)
+
+def random_csr_graph(n, degree, max_weight, seed):
+    rng = random.Random(seed)
+    offsets = array.array('q', (v * degree for v in range(n + 1)))
+    targets = array.array('q', (rng.randrange(n) for _ in range(n * degree)))
+    weights = array.array('q', (rng.randrange(max_weight + 1) for _ in range(n * degree)))
+    return offsets, targets, weights
+
+def heapq_dijkstra(offsets, targets, weights, source):
+    dist = {source: 0}
+    queue = [(0, source)]
+    while queue:
+        d, u = heapq.heappop(queue)
+        if d > dist[u]:
+            continue
+        for e in range(offsets[u], offsets[u + 1]):
+            v, nd = targets[e], d + weights[e]
+            if v not in dist or nd < dist[v]:
+                dist[v] = nd
+                heapq.heappush(queue, (nd, v))
+    return dist
+
+class TestDijkstra(unittest.TestCase):
+
+    def check_paths(self, graph, source, dist, pred):
+        offsets, targets, weights = graph
+        for v, d in enumerate(dist):
+            if d == -1 or v == source:
+                self.assertEqual(pred[v], -1)
+                continue
+            u = pred[v]
+            self.assertTrue(any(targets[e] == v and dist[u] + weights[e] == d
+                                for e in range(offsets[u], offsets[u + 1])))
+
+    def test_matches_heapq(self):
+        graph = random_csr_graph(2000, 4, 100, 1)
+        for source in (0, 17, 1999):
+            dist, pred = fibheap.dijkstra(*graph, source)
+            self.assertEqual(dist.typecode, 'q')
+            expected = heapq_dijkstra(*graph, source)
+            self.assertEqual(list(dist), [expected.get(v, -1) for v in range(2000)])
+            self.check_paths(graph, source, dist, pred)
+
+    def test_target_and_radius(self):
+        graph = random_csr_graph(2000, 3, 1000, 2)
+        full, _ = fibheap.dijkstra(*graph, 0)
+        reached = [v for v in range(2000) if full[v] > 0]
+        target = max(reached, key=lambda v: full[v])
+        dist, pred = fibheap.dijkstra(*graph, 0, target=reached[0])
+        self.assertEqual(dist[reached[0]], full[reached[0]])
+        # Only settled vertices are reported, and all of them exactly
+        self.assertTrue(all(d == -1 or d == full[v] for v, d in enumerate(dist)))
+        self.assertTrue(all(d <= full[reached[0]] for d in dist))
+        dist, _ = fibheap.dijkstra(*graph, 0, target=target)
+        self.assertEqual(dist[target], full[target])
+        radius = sorted(full[v] for v in reached)[len(reached) // 2]
+        dist, pred = fibheap.dijkstra(*graph, 0, radius=radius)
+        self.assertEqual(list(dist), [d if d <= radius else -1 for d in full])
+        self.check_paths(graph, 0, dist, pred)
+
+    def test_inputs(self):
+        # Lists and other integer buffers are read like insert_many's keys
+        offsets, targets, weights = [0, 2, 3, 3], [1, 2, 2], [5, 1, 1]
+        dist, pred = fibheap.dijkstra(offsets, targets, weights, 0)
+        self.assertEqual((list(dist), list(pred)), ([0, 5, 1], [-1, 0, 0]))
+        dist, _ = fibheap.dijkstra(array.array('i', offsets), array.array('B', targets), array.array('h', weights), 1)
+        self.assertEqual(list(dist), [-1, 0, 1])
+        self.assertRaises(ValueError, fibheap.dijkstra, offsets, targets, weights, 3)
+        self.assertRaises(ValueError, fibheap.dijkstra, offsets, targets, weights, -1)
+        self.assertRaises(ValueError, fibheap.dijkstra, offsets, targets, weights, 0, target=5)
+        self.assertRaises(ValueError, fibheap.dijkstra, offsets, targets, weights, 0, radius=-1)
+        self.assertRaises(ValueError, fibheap.dijkstra, offsets, targets, [5, -1, 1], 0)
+        self.assertRaises(ValueError, fibheap.dijkstra, offsets, [1, 3, 2], weights, 0)
+        self.assertRaises(ValueError, fibheap.dijkstra, [0, 2, 1, 3], targets, weights, 0)
+        self.assertRaises(ValueError, fibheap.dijkstra, [0, 2, 3, 4], targets, weights, 0)
+        self.assertRaises(ValueError, fibheap.dijkstra, offsets, targets, weights[:2], 0)
+        self.assertRaises(ValueError, fibheap.dijkstra, [], [], [], 0)
+        self.assertRaises(TypeError, fibheap.dijkstra, offsets, targets, weights, None)
+        # Paths whose length would overflow int64 are not followed
+        dist, _ = fibheap.dijkstra([0, 1, 2, 2], [1, 2], [2 ** 62, 2 ** 62], 0)
+        self.assertEqual(list(dist), [0, 2 ** 62, -1])
+
+def random_undirected_graph(n, edges, low, high, seed):
+    # CSR arrays with every edge stored in both directions
+    rng = random.Random(seed)
+    adjacency = [[] for _ in range(n)]
+    for _ in range(edges):
+        u, v, w = rng.randrange(n), rng.randrange(n), rng.randint(low, high)
+        adjacency[u].append((v, w))
+        adjacency[v].append((u, w))
+    offsets = array.array('q', [0])
+    for edges_of_v in adjacency:
+        offsets.append(offsets[-1] + len(edges_of_v))
+    targets = array.array('q', (v for edges_of_v in adjacency for v, _ in edges_of_v))
+    weights = array.array('q', (w for edges_of_v in adjacency for _, w in edges_of_v))
+    return offsets, targets, weights
+
+def heapq_prim_weight(offsets, targets, weights):
+    # Binary-heap Prim with lazy deletion: total weight of a minimum spanning forest
+    n = len(offsets) - 1
+    spanned = [False] * n
+    total = 0
+    for start in range(n):
+        if spanned[start]:
+            continue
+        queue = [(0, start)]
+        while queue:
+            w, u = heapq.heappop(queue)
+            if spanned[u]:
+                continue
+            spanned[u] = True
+            total += w
+            for e in range(offsets[u], offsets[u + 1]):
+                if not spanned[targets[e]]:
+                    heapq.heappush(queue, (weights[e], targets[e]))
+    return total
+
+class TestPrim(unittest.TestCase):
+
+    def check_forest(self, graph, parent, weight):
+        offsets, targets, weights = graph
+        for v, u in enumerate(parent):
+            if u == -1:
+                self.assertEqual(weight[v], 0)
+            else:
+                self.assertIn(weight[v], [weights[e] for e in range(offsets[v], offsets[v + 1]) if targets[e] == u])
+        for v in range(len(parent)):  # Following parents always ends at a root
+            seen = 0
+            while parent[v] != -1:
+                v = parent[v]
+                seen += 1
+                self.assertLess(seen, len(parent))
+
+    def test_matches_heapq(self):
+        for seed, (n, edges, low, high) in enumerate([(1000, 5000, 1, 100), (2000, 2500, -500, 500), (300, 20000, 0, 3)]):
+            graph = random_undirected_graph(n, edges, low, high, seed)
+            parent, weight = fibheap.prim(*graph)
+            self.assertEqual(parent.typecode, 'q')
+            self.assertEqual(sum(weight), heapq_prim_weight(*graph))
+            self.check_forest(graph, parent, weight)
+            # Another root gives another forest of the same weight
+            parent, weight = fibheap.prim(*graph, root=n - 1)
+            self.assertEqual(parent[n - 1], -1)
+            self.assertEqual(sum(weight), heapq_prim_weight(*graph))
+
+    def test_inputs(self):
+        parent, weight = fibheap.prim([0, 1, 2, 2], [1, 0], [-3, -3])
+        self.assertEqual((list(parent), list(weight)), ([-1, 0, -1], [0, -3, 0]))
+        self.assertRaises(ValueError, fibheap.prim, [0], [], [], root=0)
+        self.assertRaises(ValueError, fibheap.prim, [0], [], [])
+        self.assertRaises(ValueError, fibheap.prim, [0, 1, 2], [1, 0], [1, 1], root=2)
+        self.assertRaises(ValueError, fibheap.prim, [0, 1, 2], [1, 2], [1, 1])
+
+GRID_STRAIGHT, GRID_DIAGONAL = 1000, 1415  # Step costs per unit of cell cost
+
+def grid_steps(cells, width, u, diagonal):
+    # (neighbour, step cost) pairs as astar sees them: no blocked cells, no cut corners
+    height = len(cells) // width
+    x, y = u % width, u // width
+    for dx, dy in ((1, 0), (-1, 0), (0, 1), (0, -1)) + (((1, 1), (1, -1), (-1, 1), (-1, -1)) if diagonal else ()):
+        vx, vy = x + dx, y + dy
+        if 0 <= vx < width and 0 <= vy < height and cells[vy * width + vx]:
+            if dx and dy and not (cells[y * width + vx] and cells[vy * width + x]):
+                continue
+            yield vy * width + vx, cells[vy * width + vx] * (GRID_DIAGONAL if dx and dy else GRID_STRAIGHT)
+
+def heapq_grid_cost(cells, width, start, goal, diagonal):
+    dist = {start: 0}
+    queue = [(0, start)]
+    while queue:
+        d, u = heapq.heappop(queue)
+        if u == goal:
+            return d
+        if d > dist[u]:
+            continue
+        for v, step in grid_steps(cells, width, u, diagonal):
+            if v not in dist or d + step < dist[v]:
+                dist[v] = d + step
+                heapq.heappush(queue, (d + step, v))
+    return None
+
+class TestAStar(unittest.TestCase):
+
+    def path_cost(self, cells, width, path, diagonal):
+        cost = 0
+        for u, v in zip(path, path[1:]):
+            steps = dict(grid_steps(cells, width, u, diagonal))
+            self.assertIn(v, steps)
+            cost += steps[v]
+        return cost
+
+    def test_matches_heapq(self):
+        rng = random.Random(4)
+        width, height = 80, 50
+        for max_cost in (1, 9):
+            cells = bytes(0 if rng.random() < 0.25 else rng.randint(1, max_cost) for _ in range(width * height))
+            cells = b'\x01' + cells[1:-1] + b'\x01'
+            goal = width * height - 1
+            for diagonal, heuristics in ((False, ('manhattan', 'euclidean')), (True, ('octile', 'euclidean'))):
+                expected = heapq_grid_cost(cells, width, 0, goal, diagonal)
+                for heuristic in heuristics + (None,):
+                    path = fibheap.astar(cells, 0, goal, width=width, diagonal=diagonal, heuristic=heuristic)
+                    self.assertEqual(path.typecode, 'q')
+                    if expected is None:
+                        self.assertEqual(len(path), 0)
+                        continue
+                    self.assertEqual((path[0], path[-1]), (0, goal))
+                    self.assertEqual(self.path_cost(cells, width, path, diagonal), expected)
+
+    def test_grids_and_budget(self):
+        rows = [b'\x01\x01\x00\x01\x01',
+                b'\x01\x01\x00\x01\x01',
+                b'\x01\x01\x01\x01\x09']
+        flat = b''.join(rows)
+        grid = memoryview(flat).cast('B', (3, 5))  # Two-dimensional: the width comes from the shape
+        path = fibheap.astar(grid, 0, 4)
+        self.assertEqual((len(path), path[4]), (9, 12))  # Through the gap; ties decide the rest
+        self.assertEqual(self.path_cost(flat, 5, path, False), 8 * GRID_STRAIGHT)
+        self.assertEqual(list(fibheap.astar(flat, 0, 4, width=5, diagonal=True)), [0, 6, 11, 12, 13, 8, 4])
+        self.assertEqual(list(fibheap.astar(bytearray(flat), 6, 6, width=5)), [6])
+        self.assertEqual(len(fibheap.astar(flat, 0, 2, width=5)), 0)  # Blocked goal
+        walled = bytearray(flat)
+        walled[12] = 0
+        self.assertEqual(len(fibheap.astar(walled, 0, 4, width=5)), 0)
+        self.assertIsNone(fibheap.astar(flat, 0, 4, width=5, budget=3))
+        self.assertEqual(len(fibheap.astar(flat, 0, 4, width=5, budget=100)), 9)
+        self.assertEqual(list(fibheap.astar(array.array('B', flat), 14, 9, width=5)), [14, 9])
+
+    def test_inputs(self):
+        flat = bytes([1] * 12)
+        self.assertRaises(ValueError, fibheap.astar, flat, 0, 12, width=4)
+        self.assertRaises(ValueError, fibheap.astar, flat, -1, 3, width=4)
+        self.assertRaises(ValueError, fibheap.astar, flat, 0, 3)  # Flat grids need a width
+        self.assertRaises(ValueError, fibheap.astar, flat, 0, 3, width=5)
+        self.assertRaises(ValueError, fibheap.astar, memoryview(flat).cast('B', (3, 4)), 0, 3, width=3)
+        self.assertRaises(ValueError, fibheap.astar, array.array('h', [1] * 12), 0, 3, width=4)
+        self.assertRaises(ValueError, fibheap.astar, flat, 0, 3, width=4, heuristic='chebyshev')
+        self.assertRaises(ValueError, fibheap.astar, flat, 0, 3, width=4, budget=0)
+        self.assertRaises(ValueError, fibheap.astar, b'', 0, 0, width=1)
+        self.assertRaises(TypeError, fibheap.astar, [1] * 12, 0, 3, width=4)
+
+class TestTopK(unittest.TestCase):
+
+    def test_basic(self):
+        t = fibheap.TopK(3)
+        self.assertEqual((t.k, t.largest, len(t)), (3, True, 0))
+        self.assertIsNone(t.threshold)
+        self.assertTrue(t.insert(5))
+        self.assertEqual(t.insert_many([1, 3]), 2)
+        self.assertEqual(t.threshold, 1)
+        self.assertFalse(t.insert(1))  # Ties with the k-th best are rejected
+        self.assertTrue(t.insert(4))
+        self.assertEqual(list(t.result()), [5, 4, 3])
+        self.assertEqual(t.result().typecode, 'q')
+        self.assertEqual(len(t), 3)
+        self.assertIn("size 3", repr(t))
+        t.clear()
+        self.assertEqual(len(t), 0)
+        self.assertEqual(len(t.result()), 0)
+
+    def test_chunks(self):
+        rng = random.Random(7)
+        keys = [rng.randrange(-10 ** 12, 10 ** 12) for _ in range(50000)]
+        for largest in (True, False):
+            for k in (1, 10, 1000, 60000):
+                t = fibheap.TopK(k, largest=largest)
+                for start in range(0, len(keys), 8192):
+                    t.insert_many(array.array('q', keys[start:start + 8192]))
+                expected = heapq.nlargest(k, keys) if largest else heapq.nsmallest(k, keys)
+                self.assertEqual(list(t.result()), expected)
+
+    def test_formats(self):
+        # Other integer buffers are converted a block at a time; iterables work too
+        small = [7, 200, 3, 99, 0, 255, 18] * 100
+        for code in 'bBhHiIlLqQ':
+            values = [v % 128 for v in small] if code == 'b' else small
+            t = fibheap.TopK(5, largest=False)
+            t.insert_many(array.array(code, values))
+            self.assertEqual(list(t.result()), heapq.nsmallest(5, values), code)
+        t = fibheap.TopK(4)
+        self.assertEqual(t.insert_many(iter(range(1000))), 1000)
+        t.insert_many(bytes([250, 251]))
+        self.assertEqual(list(t.result()), [999, 998, 997, 996])
+
+    def test_errors(self):
+        self.assertRaises(ValueError, fibheap.TopK, 0)
+        t = fibheap.TopK(2)
+        self.assertRaises(TypeError, t.insert_many, array.array('d', [1.0]))
+        self.assertRaises(TypeError, t.insert_many, 5)
+        self.assertRaises(OverflowError, t.insert, 2 ** 63)
+        self.assertRaises(OverflowError, t.insert_many, array.array('Q', [2 ** 64 - 1]))
+        self.assertRaises(OverflowError, t.insert_many, [1, 2 ** 64])
+
+    def test_threads(self):
+        # One selector fed from several threads, with chunks large enough to drop the GIL
+        t = fibheap.TopK(100)
+        chunks = [array.array('q', range(i, 400000, 4)) for i in range(4)]
+        TestThreads.run_threads(self, lambda i: t.insert_many(chunks[i]), 4)
+        self.assertEqual(list(t.result()), list(range(399999, 399899, -1)))
+
+class TestThreads(unittest.TestCase):
+
+    def run_threads(self, target, count):
+        errors = []
+
+        def guarded(i):
+            try:
+                target(i)
+            except BaseException as e:  # Reported from the main thread
+                errors.append(e)
+
+        threads = [threading.Thread(target=guarded, args=(i,)) for i in range(count)]
+        for t in threads:
+            t.start()
+        for t in threads:
+            t.join()
+        if errors:
+            raise errors[0]
+
+    def test_separate_heaps(self):
+        # Large batches run without the GIL; each thread's heap still sees only its own keys
+        def work(i):
+            for cls in (fibheap.FibHeap, fibheap.DaryHeap, fibheap.PairingHeap):
+                h = cls()
+                keys = array.array('q', ((j * 7919 + i) % 20000 for j in range(20000)))
+                h.insert_many(keys)
+                self.assertIn(keys[5], h)
+                self.assertEqual(list(h.pop_n(20000)), sorted(keys))
+        self.run_threads(work, 4)
+
+    def test_shared_heap(self):
+        h = fibheap.FibHeap(index=False)
+        popped = []
+        inserted = threading.Barrier(4)
+
+        def work(i):
+            handles = [h.insert(i * 100000 + j) for j in range(2000)]
+            h.insert_many(range(i * 100000 + 50000, i * 100000 + 60000))
+            for handle in handles[::2]:
+                h.decrease_key(handle, handle.key - 10000)
+            inserted.wait()  # No element is popped before every thread's handles are done
+            popped.extend(h.pop_n(5000))
+            for j in range(500):
+                popped.append(h.extract_min())
+        self.run_threads(work, 4)
+        rest = list(h.pop_n(len(h)))
+        self.assertEqual(len(popped) + len(rest), 4 * 12000)
+        self.assertEqual(rest, sorted(rest))
+        self.assertLessEqual(max(popped), min(rest))
+
+    def test_handles_while_popping(self):
+        h = fibheap.DaryHeap()
+        handles = [h.insert(k) for k in range(30000)]
+        done = threading.Event()
+
+        def reader(i):
+            while not done.is_set():
+                for handle in handles[::997]:
+                    key = handle.key
+                    self.assertTrue(key is None or 0 <= key < 30000)
+
+        def popper(i):
+            try:
+                for _ in range(6):
+                    h.pop_n(5000)
+            finally:
+                done.set()
+
+        self.run_threads(lambda i: popper(i) if i == 0 else reader(i), 3)
+        self.assertEqual(len(h), 0)
+        self.assertFalse(any(handle.valid for handle in handles))
+
+    def test_insert_while_popping(self):
+        # A handle is returned while other threads pop the element it was inserted as; the
+        # caller's reference must already be taken by then
+        for cls in (fibheap.FibHeap, fibheap.DaryHeap, fibheap.PairingHeap):
+            h = cls()
+            done = threading.Event()
+            kept = []
+
+            def inserter(i):
+                try:
+                    for j in range(20000):
+                        handle = h.insert(j)
+                        if j % 1000 == 0:
+                            kept.append(handle)
+                        self.assertIn(handle.key, (j, None))
+                finally:
+                    done.set()
+
+            def popper(i):
+                while not done.is_set():
+                    h.extract_min()
+                    h.pop_n(8)
+
+            self.run_threads(lambda i: inserter(i) if i == 0 else popper(i), 3)
+            h.pop_n(len(h))
+            self.assertEqual(len(kept), 20)
+            self.assertFalse(any(handle.valid for handle in kept))
+
+    def test_multi_queue(self):
+        q = fibheap.MultiQueue(threads=4)
+        popped = [[] for _ in range(4)]
+
+        def work(i):
+            q.insert_many(array.array('q', range(i * 50000, i * 50000 + 40000)))
+            for j in range(40000, 50000):
+                q.insert(i * 50000 + j)
+                if j % 2:
+                    popped[i].append(q.extract_min())
+            popped[i].extend(q.pop_n(10000))
+        self.run_threads(work, 4)
+        keys = [k for p in popped for k in p if k is not None] + list(q.pop_n(len(q)))
+        self.assertEqual(sorted(keys), list(range(200000)))
+
+    def test_dijkstra(self):
+        # Searches run without the GIL and share nothing but the (read-only) graph
+        graph = random_csr_graph(5000, 4, 100, 3)
+        expected = [fibheap.dijkstra(*graph, i) for i in range(4)]
+        self.run_threads(lambda i: self.assertEqual(fibheap.dijkstra(*graph, i), expected[i]), 4)
+
+    def test_many_threads(self):
+        # Mixed operations on shared heaps from many threads; without a GIL (free-threaded
+        # builds) this is what the per-heap locks and the owner lock have to hold up under
+        for cls in (fibheap.FibHeap, fibheap.DaryHeap):
+            h = cls()
+            popped = [[] for _ in range(16)]
+
+            def work(i):
+                base = i * 100000
+                handles = [h.insert(base + j) for j in range(500)]
+                other = cls()
+                other.insert_many(array.array('q', range(base + 500, base + 1000)))
+                handles += [other.insert(base + j) for j in range(1000, 1100)]
+                h.meld(other)  # Handles of `other` now belong to `h`
+                for j, handle in enumerate(handles):
+                    key = handle.key
+                    self.assertTrue(key is None or key <= base + j + (500 if j >= 500 else 0))
+                    if j % 3 == 0 and handle.valid:
+                        try:
+                            h.decrease_key(handle, key - 50000)
+                        except ValueError:
+                            pass  # Popped by another thread in the meantime
+                    self.assertGreaterEqual(len(h), 0)
+                    self.assertIn('object at', repr(h))
+                    if j % 7 == 0:
+                        popped[i].append(h.extract_min())
+                popped[i].extend(h.pop_n(200))
+            self.run_threads(work, 16)
+            rest = list(h.pop_n(len(h)))
+            self.assertEqual(rest, sorted(rest))
+            self.assertEqual(sum(len(p) for p in popped) + len(rest), 16 * 1100)
+            self.assertNotIn(None, [k for p in popped for k in p])
+
+    @unittest.skipUnless(sysconfig.get_config_var('Py_GIL_DISABLED'), "needs a free-threaded build")
+    def test_gil_stays_disabled(self):
+        # fibheap was imported above; a module without Py_MOD_GIL_NOT_USED would turn it back on
+        self.assertFalse(sys._is_gil_enabled())
+
+class TestInterpreters(unittest.TestCase):
+
+    def test_module_objects_are_independent(self):
+        # Every module object creates its own types, as each interpreter does on import
+        spec = importlib.util.find_spec('fibheap')
+        other = importlib.util.module_from_spec(spec)
+        spec.loader.exec_module(other)
+        self.assertIsNot(other.FibHeap, fibheap.FibHeap)
+        h, g = fibheap.FibHeap(), other.FibHeap()
+        handle = g.insert(5)
+        self.assertEqual(handle.key, 5)
+        self.assertIsInstance(handle, other.Handle)
+        self.assertRaises(TypeError, h.meld, g)
+        self.assertRaises(TypeError, h.decrease_key, handle, 1)
+        self.assertEqual(list(g.pop_n(1)), [5])
+
+    def test_subinterpreters(self):
+        # Independent heaps driven from several subinterpreters at once, each on its own thread
+        # (and, from Python 3.12 on, under its own GIL)
+        try:
+            import _interpreters as interpreters  # Python 3.13+
+            create = lambda: interpreters.create('isolated')
+        except ImportError:
+            try:
+                import _xxsubinterpreters as interpreters
+            except ImportError:
+                self.skipTest("no subinterpreter support")
+            create = interpreters.create
+        script = (
+            "import sys\n"
+            "sys.path.insert(0, %r)\n"
+            "import array, fibheap\n"
+            "for cls in (fibheap.FibHeap, fibheap.DaryHeap, fibheap.PairingHeap):\n"
+            "    h = cls.from_array(array.array('q', range(20000, 0, -1)), threads=2)\n"
+            "    handles = [h.insert(k) for k in range(30000, 31000)]\n"
+            "    for handle in handles:\n"
+            "        h.decrease_key(handle, handle.key - 30000)\n"
+            "    assert list(h.pop_n(len(h))) == sorted(list(range(0, 1000)) + list(range(1, 20001)))\n"
+            "q = fibheap.MultiQueue(threads=2)\n"
+            "q.insert_many(range(5000))\n"
+            "assert sorted(q.pop_n(5000)) == list(range(5000))\n"
+        ) % os.path.dirname(os.path.abspath(fibheap.__file__))
+        ids = [create() for _ in range(4)]
+        failures = []
+
+        def run(i):
+            result = interpreters.run_string(ids[i], script)
+            if result is not None:  # Python 3.13+ returns the error instead of raising it
+                failures.append(result)
+
+        try:
+            TestThreads.run_threads(self, run, len(ids))
+        finally:
+            for interp in ids:
+                interpreters.destroy(interp)
+        self.assertEqual(failures, [])
+
 if __name__ == '__main__':
     unittest.main()